@@ -61,6 +61,8 @@ PetscErrorCode JacResCreate(JacRes *jr, FB *fb)
 	ctrl->lrtol        =  1e-6;
 	ctrl->actTemp	   =  0;			// diffusion is not active by default (otherwise we have to define thermal properties in all cases)
 	ctrl->printNorms   =  0;			// print norms of velocity/pressure/temperature?
+	ctrl->tempSubSteps =  1;
+	ctrl->stokesSkipTol =  1e-3;
 	ctrl->Adiabatic_gr = 0.0;
 	
 	if(scal->utype != _NONE_)
@@ -82,6 +84,9 @@ PetscErrorCode JacResCreate(JacRes *jr, FB *fb)
 	ierr = getScalarParam(fb, _OPTIONAL_, "steady_temp_t",   &ctrl->steadyTempStep, 1, 1.0);            CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "nstep_steady",    &ctrl->steadyNumStep,  1, 0);              CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "act_heat_rech",   &ctrl->actHeatRech,    1, 2.0);              CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "temp_sub_steps",  &ctrl->tempSubSteps,   1, -1);             CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "stokes_skip_max", &ctrl->stokesSkipMax,  1, -1);             CHKERRQ(ierr);
+	ierr = getScalarParam(fb, _OPTIONAL_, "stokes_skip_tol", &ctrl->stokesSkipTol,  1, 1.0);            CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "act_p_shift",     &ctrl->pShiftAct,      1, 1);   			CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "init_lith_pres",  &ctrl->initLithPres,   1, 1);              CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "init_guess",      &ctrl->initGuess,      1, 1);              CHKERRQ(ierr);
@@ -216,8 +221,20 @@ PetscErrorCode JacResCreate(JacRes *jr, FB *fb)
 	}
 
 
+	if(ctrl->tempSubSteps < 1)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Number of temperature sub-steps must be positive (temp_sub_steps)");
+	}
+
+	if(ctrl->stokesSkipMax < 0 || ctrl->stokesSkipTol < 0.0)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Stokes skipping parameters must be non-negative (stokes_skip_max, stokes_skip_tol)");
+	}
+
 	if(!ctrl->actTemp) ctrl->shearHeatEff = 0.0;
 
+	if(!ctrl->actTemp) ctrl->tempSubSteps = 1;
+
 	if(ctrl->biot < 0.0 || ctrl->biot > 1.0)
 	{
 		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Biot pressure parameter must be between 0 and 1 (biot)");
@@ -249,6 +266,9 @@ PetscErrorCode JacResCreate(JacRes *jr, FB *fb)
 	if(ctrl->shearHeatEff)   PetscPrintf(PETSC_COMM_WORLD, "   Shear heating efficiency                :  %g \n", ctrl->shearHeatEff);
 	if(ctrl->biot)           PetscPrintf(PETSC_COMM_WORLD, "   Biot pressure parameter                 :  %g \n", ctrl->biot);
 	if(ctrl->actTemp)        PetscPrintf(PETSC_COMM_WORLD, "   Activate temperature diffusion          @ \n");
+	if(ctrl->tempSubSteps > 1) PetscPrintf(PETSC_COMM_WORLD, "   Temperature sub-steps per time step     : %lld \n", (LLD)ctrl->tempSubSteps);
+	if(ctrl->stokesSkipMax)  PetscPrintf(PETSC_COMM_WORLD, "   Maximum number of skipped Stokes solves : %lld \n", (LLD)ctrl->stokesSkipMax);
+	if(ctrl->stokesSkipMax)  PetscPrintf(PETSC_COMM_WORLD, "   Stokes skipping velocity change tol.    : %g \n", ctrl->stokesSkipTol);
 	if(ctrl->actSteadyTemp)  PetscPrintf(PETSC_COMM_WORLD, "   Steady state initial temperature        @ \n");
 	if(ctrl->steadyTempStep) PetscPrintf(PETSC_COMM_WORLD, "   Steady state initial temperature step   : %g %s \n", ctrl->steadyTempStep, scal->lbl_time);
 	if(ctrl->initGuess)      PetscPrintf(PETSC_COMM_WORLD, "   Compute initial guess                   @ \n");
@@ -384,22 +404,14 @@ PetscErrorCode JacResCreateData(JacRes *jr)
 	ierr = DMCreateLocalVector (fs->DA_XY,  &jr->ldxy); CHKERRQ(ierr);
 	ierr = DMCreateLocalVector (fs->DA_XZ,  &jr->ldxz); CHKERRQ(ierr);
 	ierr = DMCreateLocalVector (fs->DA_YZ,  &jr->ldyz); CHKERRQ(ierr);
-	ierr = DMCreateGlobalVector(fs->DA_XY,  &jr->gdxy); CHKERRQ(ierr);
-	ierr = DMCreateGlobalVector(fs->DA_XZ,  &jr->gdxz); CHKERRQ(ierr);
-	ierr = DMCreateGlobalVector(fs->DA_YZ,  &jr->gdyz); CHKERRQ(ierr);
-
-	// velocity gradient tensor components   // control structure to create and destroy them
-
-	ierr = DMCreateLocalVector (fs->DA_CEN, &jr->dvxdx); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_CEN, &jr->dvydy); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_CEN, &jr->dvzdz); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_XY,  &jr->dvxdy); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_XY,  &jr->dvydx); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_XZ,  &jr->dvxdz); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_XZ,  &jr->dvzdx); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_YZ,  &jr->dvydz); CHKERRQ(ierr);
-	ierr = DMCreateLocalVector (fs->DA_YZ,  &jr->dvzdy); CHKERRQ(ierr);
 
+	// stress & strain rate orientation (created on demand)
+	jr->lshx   =  NULL;
+	jr->lshy   =  NULL;
+	jr->lehx   =  NULL;
+	jr->lehy   =  NULL;
+	jr->shStep = -1;
+	jr->ehStep = -1;
 
 	// pressure
 	ierr = DMCreateGlobalVector(fs->DA_CEN, &jr->gp);      CHKERRQ(ierr);
@@ -414,9 +426,6 @@ PetscErrorCode JacResCreateData(JacRes *jr)
 	// continuity residual
 	ierr = DMCreateGlobalVector(fs->DA_CEN, &jr->gc); CHKERRQ(ierr);
 
-	// corner buffer
-	ierr = DMCreateLocalVector(fs->DA_COR,  &jr->lbcor); CHKERRQ(ierr);
-
 	//======================================
 	// allocate space for solution variables
 	//======================================
@@ -532,9 +541,10 @@ PetscErrorCode JacResDestroy(JacRes *jr)
 	ierr = VecDestroy(&jr->ldxz);    CHKERRQ(ierr);
 	ierr = VecDestroy(&jr->ldyz);    CHKERRQ(ierr);
 
-	ierr = VecDestroy(&jr->gdxy);    CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->gdxz);    CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->gdyz);    CHKERRQ(ierr);
+	ierr = VecDestroy(&jr->lshx);    CHKERRQ(ierr);
+	ierr = VecDestroy(&jr->lshy);    CHKERRQ(ierr);
+	ierr = VecDestroy(&jr->lehx);    CHKERRQ(ierr);
+	ierr = VecDestroy(&jr->lehy);    CHKERRQ(ierr);
 
 	ierr = VecDestroy(&jr->gp);      CHKERRQ(ierr);
 	ierr = VecDestroy(&jr->lp);      CHKERRQ(ierr);
@@ -545,20 +555,6 @@ PetscErrorCode JacResDestroy(JacRes *jr)
 
 	ierr = VecDestroy(&jr->phi);     CHKERRQ(ierr);
 
-	ierr = VecDestroy(&jr->lbcor);   CHKERRQ(ierr);
-
-	// velocity gradient tensor components   // control structure to create and destroy them
-
-	ierr = VecDestroy(&jr->dvxdx); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvydy); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvzdz); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvxdy); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvydx); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvxdz); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvzdx); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvydz); CHKERRQ(ierr);
-	ierr = VecDestroy(&jr->dvzdy); CHKERRQ(ierr);
-
 	// solution variables
 	ierr = PetscFree(jr->svCell);    CHKERRQ(ierr);
 	ierr = PetscFree(jr->svXYEdge);  CHKERRQ(ierr);
@@ -584,23 +580,100 @@ PetscErrorCode JacResDestroy(JacRes *jr)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode JacResFormResidual(JacRes *jr, Vec x, Vec f)
+PetscErrorCode JacResViewMemory(JacRes *jr)
 {
+	// print memory occupied by resident grid vectors & solution variables
+	// (activated by -mem_report option)
+	// scratch vectors borrowed from the DMDA caches are only counted by
+	// the total PETSc allocation & resident set size of the process
+
+	FDSTAG        *fs;
+	PetscBool      flg;
+	PetscInt       i, n, nvec;
+	PetscLogDouble mem[4], mmax[4], msum[4], mb;
+	Vec            vecs[40];
+
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
 
-	// copy solution from global to local vectors, enforce boundary constraints
-	ierr = JacResCopySol(jr, x); CHKERRQ(ierr);
+	ierr = PetscOptionsHasName(NULL, NULL, "-mem_report", &flg); CHKERRQ(ierr);
 
-	// get pressure shift to enforce zero pressure in top layer of cells if requested (for free slip setups)
-	ierr = JacResGetPressShift(jr); CHKERRQ(ierr);
+	if(flg != PETSC_TRUE) PetscFunctionReturn(0);
+
+	fs = jr->fs;
+	mb = 1024.0*1024.0;
+
+	// collect resident vectors
+	nvec = 0;
+
+	vecs[nvec++] = jr->gsol;    vecs[nvec++] = jr->gres;    vecs[nvec++] = jr->phi;
+	vecs[nvec++] = jr->gvx;     vecs[nvec++] = jr->gvy;     vecs[nvec++] = jr->gvz;
+	vecs[nvec++] = jr->lvx;     vecs[nvec++] = jr->lvy;     vecs[nvec++] = jr->lvz;
+	vecs[nvec++] = jr->gfx;     vecs[nvec++] = jr->gfy;     vecs[nvec++] = jr->gfz;
+	vecs[nvec++] = jr->lfx;     vecs[nvec++] = jr->lfy;     vecs[nvec++] = jr->lfz;
+	vecs[nvec++] = jr->ldxx;    vecs[nvec++] = jr->ldyy;    vecs[nvec++] = jr->ldzz;
+	vecs[nvec++] = jr->ldxy;    vecs[nvec++] = jr->ldxz;    vecs[nvec++] = jr->ldyz;
+	vecs[nvec++] = jr->gp;      vecs[nvec++] = jr->lp;      vecs[nvec++] = jr->gc;
+	vecs[nvec++] = jr->lp_lith; vecs[nvec++] = jr->lp_pore; vecs[nvec++] = jr->lgradfield;
+	vecs[nvec++] = jr->lT;      vecs[nvec++] = jr->dT;      vecs[nvec++] = jr->ge;
+	vecs[nvec++] = jr->lshx;    vecs[nvec++] = jr->lshy;
+	vecs[nvec++] = jr->lehx;    vecs[nvec++] = jr->lehy;
+
+	// grid vectors
+	mem[0] = 0.0;
+
+	for(i = 0; i < nvec; i++)
+	{
+		if(!vecs[i]) continue;
+
+		ierr = VecGetLocalSize(vecs[i], &n); CHKERRQ(ierr);
+
+		mem[0] += (PetscLogDouble)((size_t)n*sizeof(PetscScalar));
+	}
+
+	// solution variables
+	mem[1] = (PetscLogDouble)(sizeof(SolVarCell)*(size_t)fs->nCells
+	+                         sizeof(SolVarEdge)*(size_t)(fs->nXYEdg + fs->nXZEdg + fs->nYZEdg)
+	+                         sizeof(PetscScalar)*(size_t)(jr->dbm->numPhases*(fs->nCells + fs->nXYEdg + fs->nXZEdg + fs->nYZEdg)));
+
+	// total PETSc allocation & resident set size
+	ierr = PetscMallocGetCurrentUsage(&mem[2]); CHKERRQ(ierr);
+	ierr = PetscMemoryGetCurrentUsage(&mem[3]); CHKERRQ(ierr);
+
+	ierr = MPI_Allreduce(mem, mmax, 4, MPIU_PETSCLOGDOUBLE, MPI_MAX, PETSC_COMM_WORLD); CHKERRQ(ierr);
+	ierr = MPI_Allreduce(mem, msum, 4, MPIU_PETSCLOGDOUBLE, MPI_SUM, PETSC_COMM_WORLD); CHKERRQ(ierr);
+
+	PetscPrintf(PETSC_COMM_WORLD, "--------------------------------------------------------------------------\n");
+	PetscPrintf(PETSC_COMM_WORLD, "Memory report [MB] (max per process / total) : \n");
+	PetscPrintf(PETSC_COMM_WORLD, "   Resident grid vectors  : %10.2f / %10.2f \n", mmax[0]/mb, msum[0]/mb);
+	PetscPrintf(PETSC_COMM_WORLD, "   Solution variables     : %10.2f / %10.2f \n", mmax[1]/mb, msum[1]/mb);
+	PetscPrintf(PETSC_COMM_WORLD, "   PETSc allocated        : %10.2f / %10.2f \n", mmax[2]/mb, msum[2]/mb);
+	PetscPrintf(PETSC_COMM_WORLD, "   Resident set size      : %10.2f / %10.2f \n", mmax[3]/mb, msum[3]/mb);
+	PetscPrintf(PETSC_COMM_WORLD, "--------------------------------------------------------------------------\n");
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResFormResidual(JacRes *jr, Vec x, Vec f)
+{
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
 
-	// compute lithostatic pressure
+	// copy solution to global vectors, start ghost point exchange
+	ierr = JacResCopySolBegin(jr, x); CHKERRQ(ierr);
+
+	// compute lithostatic pressure (independent of solution, overlaps ghost exchange)
 	ierr = JacResGetLithoStaticPressure(jr); CHKERRQ(ierr);
 
-	// compute pore pressure
+	// compute pore pressure (independent of solution, overlaps ghost exchange)
 	ierr = JacResGetPorePressure(jr); CHKERRQ(ierr);
 
+	// finish ghost point exchange, enforce boundary constraints
+	ierr = JacResCopySolEnd(jr); CHKERRQ(ierr);
+
+	// get pressure shift to enforce zero pressure in top layer of cells if requested (for free slip setups)
+	ierr = JacResGetPressShift(jr); CHKERRQ(ierr);
+
 	// compute effective strain rate
 	ierr = JacResGetEffStrainRate(jr); CHKERRQ(ierr);
 
@@ -737,9 +810,6 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 	PetscScalar dx, dy, dz, xx, yy, zz, xy, xz, yz, theta, tr;
 	PetscScalar ***vx,  ***vy,  ***vz;
 	PetscScalar ***dxx, ***dyy, ***dzz, ***dxy, ***dxz, ***dyz;
-	PetscScalar ***vx_x,***vy_y,***vz_z;
-	PetscScalar ***vx_y,***vx_z,***vz_x;
-	PetscScalar ***vy_x,***vy_z,***vz_y;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -759,18 +829,6 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 	ierr = DMDAVecGetArray(fs->DA_XZ,  jr->ldxz, &dxz); CHKERRQ(ierr);
 	ierr = DMDAVecGetArray(fs->DA_YZ,  jr->ldyz, &dyz); CHKERRQ(ierr);
 
-
-	// access the velocity gradient tensor
-		ierr = DMDAVecGetArray(fs->DA_CEN, jr->dvxdx, &vx_x); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_XY,  jr->dvxdy, &vx_y); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_XZ,  jr->dvxdz, &vx_z); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_XY,  jr->dvydx, &vy_x); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_CEN, jr->dvydy, &vy_y); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_YZ,  jr->dvydz, &vy_z); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_XZ,  jr->dvzdx, &vz_x); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_YZ,  jr->dvzdy, &vz_y); CHKERRQ(ierr);
-		ierr = DMDAVecGetArray(fs->DA_CEN, jr->dvzdz, &vz_z); CHKERRQ(ierr);
-
 	//-------------------------------
 	// central points (dxx, dyy, dzz)
 	//-------------------------------
@@ -796,10 +854,6 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 		yy = (vy[k][j+1][i] - vy[k][j][i])/dy;
 		zz = (vz[k+1][j][i] - vz[k][j][i])/dz;
 
-			vx_x[k][j][i] = xx;
-			vy_y[k][j][i] = yy;
-			vz_z[k][j][i] = zz;
-
 		// compute & store volumetric strain rate
 		theta = xx + yy + zz;
 		svBulk->theta = theta;
@@ -844,10 +898,6 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 		dvxdy = (vx[k][j][i] - vx[k][j-1][i])/dy;
 		dvydx = (vy[k][j][i] - vy[k][j][i-1])/dx;
 
-
-			vx_y[k][j][i] = dvxdy;
-			vy_x[k][j][i] = dvydx;
-
 		// compute & store total strain rate
 		xy = 0.5*(dvxdy + dvydx);
 		svEdge->d = xy;
@@ -880,9 +930,6 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 		dvxdz = (vx[k][j][i] - vx[k-1][j][i])/dz;
 		dvzdx = (vz[k][j][i] - vz[k][j][i-1])/dx;
 
-			vx_z[k][j][i] = dvxdz;
-			vz_x[k][j][i] = dvzdx;
-
 		// compute & store total strain rate
         xz = 0.5*(dvxdz + dvzdx);
         svEdge->d = xz;
@@ -912,14 +959,9 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 		dz = SIZE_NODE(k, sz, fs->dsz);
 
 		// compute velocity gradients
-
-
 		dvydz = (vy[k][j][i] - vy[k-1][j][i])/dz;
 		dvzdy = (vz[k][j][i] - vz[k][j-1][i])/dy;
 
-		vy_z[k][j][i] = dvydz;
-		vz_y[k][j][i] = dvzdy;
-
 		// compute & store total strain rate
 		yz = 0.5*(dvydz + dvzdy);
 		svEdge->d = yz;
@@ -942,36 +984,20 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr)
 	ierr = DMDAVecRestoreArray(fs->DA_YZ,  jr->ldyz, &dyz); CHKERRQ(ierr);
 
 
-	// communicate boundary strain-rate values
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldxx);
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldyy);
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldzz);
-	LOCAL_TO_LOCAL(fs->DA_XY,  jr->ldxy);
-	LOCAL_TO_LOCAL(fs->DA_XZ,  jr->ldxz);
-	LOCAL_TO_LOCAL(fs->DA_YZ,  jr->ldyz);
-
-
-	// access the velocity gradient tensor
-
-		ierr =DMDAVecRestoreArray(fs->DA_CEN, jr->dvxdx, &vx_x); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_XY,  jr->dvxdy, &vx_y); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_XZ,  jr->dvxdz, &vx_z); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_XY,  jr->dvydx, &vy_x); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_CEN, jr->dvydy, &vy_y); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_YZ,  jr->dvydz, &vy_z); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_XZ,  jr->dvzdx, &vz_x); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_YZ,  jr->dvzdy, &vz_y); CHKERRQ(ierr);
-		ierr =DMDAVecRestoreArray(fs->DA_CEN, jr->dvzdz, &vz_z); CHKERRQ(ierr);
-
-		LOCAL_TO_LOCAL(fs->DA_CEN, jr->dvxdx);
-		LOCAL_TO_LOCAL(fs->DA_XY,  jr->dvxdy);
-		LOCAL_TO_LOCAL(fs->DA_XZ,  jr->dvxdz);
-		LOCAL_TO_LOCAL(fs->DA_XY,  jr->dvydx);
-		LOCAL_TO_LOCAL(fs->DA_CEN, jr->dvydy);
-		LOCAL_TO_LOCAL(fs->DA_YZ,  jr->dvydz);
-		LOCAL_TO_LOCAL(fs->DA_XZ,  jr->dvzdx);
-		LOCAL_TO_LOCAL(fs->DA_YZ,  jr->dvzdy);
-		LOCAL_TO_LOCAL(fs->DA_CEN, jr->dvzdz);
+	// communicate boundary strain-rate values (post all scatters before completing any)
+	ierr = DMLocalToLocalBegin(fs->DA_CEN, jr->ldxx, INSERT_VALUES, jr->ldxx); CHKERRQ(ierr);
+	ierr = DMLocalToLocalBegin(fs->DA_CEN, jr->ldyy, INSERT_VALUES, jr->ldyy); CHKERRQ(ierr);
+	ierr = DMLocalToLocalBegin(fs->DA_CEN, jr->ldzz, INSERT_VALUES, jr->ldzz); CHKERRQ(ierr);
+	ierr = DMLocalToLocalBegin(fs->DA_XY,  jr->ldxy, INSERT_VALUES, jr->ldxy); CHKERRQ(ierr);
+	ierr = DMLocalToLocalBegin(fs->DA_XZ,  jr->ldxz, INSERT_VALUES, jr->ldxz); CHKERRQ(ierr);
+	ierr = DMLocalToLocalBegin(fs->DA_YZ,  jr->ldyz, INSERT_VALUES, jr->ldyz); CHKERRQ(ierr);
+
+	ierr = DMLocalToLocalEnd  (fs->DA_CEN, jr->ldxx, INSERT_VALUES, jr->ldxx); CHKERRQ(ierr);
+	ierr = DMLocalToLocalEnd  (fs->DA_CEN, jr->ldyy, INSERT_VALUES, jr->ldyy); CHKERRQ(ierr);
+	ierr = DMLocalToLocalEnd  (fs->DA_CEN, jr->ldzz, INSERT_VALUES, jr->ldzz); CHKERRQ(ierr);
+	ierr = DMLocalToLocalEnd  (fs->DA_XY,  jr->ldxy, INSERT_VALUES, jr->ldxy); CHKERRQ(ierr);
+	ierr = DMLocalToLocalEnd  (fs->DA_XZ,  jr->ldxz, INSERT_VALUES, jr->ldxz); CHKERRQ(ierr);
+	ierr = DMLocalToLocalEnd  (fs->DA_YZ,  jr->ldyz, INSERT_VALUES, jr->ldyz); CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
@@ -1072,6 +1098,66 @@ PetscErrorCode JacResGetVorticity(JacRes *jr)
 	PetscFunctionReturn(0);
 }
 //-----------------------------------------------------------------------------
+PetscErrorCode JacResGetVelGradComp(JacRes *jr, PetscInt iv, PetscInt id, Vec lbuf)
+{
+	// compute velocity gradient component dv_iv/dx_id in a local buffer vector
+	// diagonal components are defined in cell centers, off-diagonal in edges
+	// (the caller provides a buffer of the matching DMDA, ghost values are updated)
+
+	FDSTAG      *fs;
+	Discret1D   *ds;
+	DM           da, dv;
+	Vec          lv;
+	PetscInt     i, j, k, nx, ny, nz, sx, sy, sz, ix, s, di, dj, dk;
+	PetscScalar  ***v, ***g;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = jr->fs;
+
+	// velocity component
+	if     (iv == 0) { dv = fs->DA_X; lv = jr->lvx; }
+	else if(iv == 1) { dv = fs->DA_Y; lv = jr->lvy; }
+	else             { dv = fs->DA_Z; lv = jr->lvz; }
+
+	// gradient grid
+	if     (iv == id)      da = fs->DA_CEN;
+	else if(iv + id == 1)  da = fs->DA_XY;
+	else if(iv + id == 2)  da = fs->DA_XZ;
+	else                   da = fs->DA_YZ;
+
+	// differentiation direction
+	if     (id == 0) { ds = &fs->dsx; di = 1; dj = 0; dk = 0; }
+	else if(id == 1) { ds = &fs->dsy; di = 0; dj = 1; dk = 0; }
+	else             { ds = &fs->dsz; di = 0; dj = 0; dk = 1; }
+
+	ierr = DMDAVecGetArray(dv, lv,   &v); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(da, lbuf, &g); CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(da, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	START_STD_LOOP
+	{
+		// index & starting index along differentiation direction
+		if     (id == 0) { ix = i; s = sx; }
+		else if(id == 1) { ix = j; s = sy; }
+		else             { ix = k; s = sz; }
+
+		if(iv == id) g[k][j][i] = (v[k+dk][j+dj][i+di] - v[k][j][i])/SIZE_CELL(ix, s, (*ds));
+		else         g[k][j][i] = (v[k][j][i] - v[k-dk][j-dj][i-di])/SIZE_NODE(ix, s, (*ds));
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(dv, lv,   &v); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(da, lbuf, &g); CHKERRQ(ierr);
+
+	// communicate boundary values
+	LOCAL_TO_LOCAL(da, lbuf)
+
+	PetscFunctionReturn(0);
+}
+//-----------------------------------------------------------------------------
 PetscErrorCode JacResGetResidual(JacRes *jr)
 {
 	// Compute residual of nonlinear momentum and mass conservation
@@ -1661,9 +1747,37 @@ PetscErrorCode JacResCopySol(JacRes *jr, Vec x)
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
 
-	ierr = JacResCopyVel (jr, x); CHKERRQ(ierr);
+	ierr = JacResCopySolBegin(jr, x); CHKERRQ(ierr);
+
+	ierr = JacResCopySolEnd(jr);      CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResCopySolBegin(JacRes *jr, Vec x)
+{
+	// copy solution to global vectors, start ghost point exchange of all fields
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = JacResCopyVelBegin (jr, x); CHKERRQ(ierr);
+
+	ierr = JacResCopyPresBegin(jr, x); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResCopySolEnd(JacRes *jr)
+{
+	// finish ghost point exchange of all fields, enforce boundary constraints
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = JacResCopyVelEnd (jr); CHKERRQ(ierr);
 
-	ierr = JacResCopyPres(jr, x); CHKERRQ(ierr);
+	ierr = JacResCopyPresEnd(jr); CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
@@ -1672,26 +1786,28 @@ PetscErrorCode JacResCopyVel(JacRes *jr, Vec x)
 {
 	// copy velocity from global to local vectors, enforce boundary constraints
 
-	FDSTAG           *fs;
-	BCCtx            *bc;
-	PetscInt          mcx, mcy, mcz;
-	PetscInt          I, J, K, fi, fj, fk;
-	PetscInt          i, j, k, nx, ny, nz, sx, sy, sz;
-	PetscScalar       ***bcvx,  ***bcvy,  ***bcvz;
-	PetscScalar       ***lvx, ***lvy, ***lvz;
-	PetscScalar       *vx, *vy, *vz, pmdof;
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = JacResCopyVelBegin(jr, x); CHKERRQ(ierr);
+
+	ierr = JacResCopyVelEnd(jr);      CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResCopyVelBegin(JacRes *jr, Vec x)
+{
+	// copy velocity to global vectors, start ghost point exchange
+
+	FDSTAG            *fs;
+	PetscScalar       *vx, *vy, *vz;
 	const PetscScalar *sol, *iter;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
 
-	fs  =  jr->fs;
-	bc  =  jr->bc;
-
-	// initialize maximal index in all directions
-	mcx = fs->dsx.tcels - 1;
-	mcy = fs->dsy.tcels - 1;
-	mcz = fs->dsz.tcels - 1;
+	fs = jr->fs;
 
 	// access vectors
 	ierr = VecGetArray    (jr->gvx, &vx);  CHKERRQ(ierr);
@@ -1716,10 +1832,42 @@ PetscErrorCode JacResCopyVel(JacRes *jr, Vec x)
 	ierr = VecRestoreArray    (jr->gvz, &vz);  CHKERRQ(ierr);
 	ierr = VecRestoreArrayRead(x,       &sol); CHKERRQ(ierr);
 
-	// fill local (ghosted) version of solution vectors
-	GLOBAL_TO_LOCAL(fs->DA_X,   jr->gvx, jr->lvx)
-	GLOBAL_TO_LOCAL(fs->DA_Y,   jr->gvy, jr->lvy)
-	GLOBAL_TO_LOCAL(fs->DA_Z,   jr->gvz, jr->lvz)
+	// post all ghost point scatters at once (completed in JacResCopyVelEnd)
+	ierr = DMGlobalToLocalBegin(fs->DA_X, jr->gvx, INSERT_VALUES, jr->lvx); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalBegin(fs->DA_Y, jr->gvy, INSERT_VALUES, jr->lvy); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalBegin(fs->DA_Z, jr->gvz, INSERT_VALUES, jr->lvz); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResCopyVelEnd(JacRes *jr)
+{
+	// finish ghost point exchange of velocity, enforce boundary constraints
+
+	FDSTAG           *fs;
+	BCCtx            *bc;
+	PetscInt          mcx, mcy, mcz;
+	PetscInt          I, J, K, fi, fj, fk;
+	PetscInt          i, j, k, nx, ny, nz, sx, sy, sz;
+	PetscScalar       ***bcvx,  ***bcvy,  ***bcvz;
+	PetscScalar       ***lvx, ***lvy, ***lvz;
+	PetscScalar       pmdof;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs  =  jr->fs;
+	bc  =  jr->bc;
+
+	// initialize maximal index in all directions
+	mcx = fs->dsx.tcels - 1;
+	mcy = fs->dsy.tcels - 1;
+	mcz = fs->dsz.tcels - 1;
+
+	// complete ghost point scatters
+	ierr = DMGlobalToLocalEnd(fs->DA_X, jr->gvx, INSERT_VALUES, jr->lvx); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalEnd(fs->DA_Y, jr->gvy, INSERT_VALUES, jr->lvy); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalEnd(fs->DA_Z, jr->gvz, INSERT_VALUES, jr->lvz); CHKERRQ(ierr);
 
 	// access local solution vectors
 	ierr = DMDAVecGetArray(fs->DA_X,   jr->lvx, &lvx); CHKERRQ(ierr);
@@ -1833,26 +1981,28 @@ PetscErrorCode JacResCopyPres(JacRes *jr, Vec x)
 {
 	// copy pressure from global to local vectors, enforce boundary constraints
 
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = JacResCopyPresBegin(jr, x); CHKERRQ(ierr);
+
+	ierr = JacResCopyPresEnd(jr);      CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResCopyPresBegin(JacRes *jr, Vec x)
+{
+	// copy pressure to global vector, start ghost point exchange
+
 	FDSTAG            *fs;
-	BCCtx             *bc;
-	PetscInt          mcx, mcy, mcz;
-	PetscInt          I, J, K, fi, fj, fk;
-	PetscInt          i, j, k, nx, ny, nz, sx, sy, sz;
-	PetscScalar       ***bcp;
-	PetscScalar       ***lp;
-	PetscScalar       *p, pmdof;
+	PetscScalar       *p;
 	const PetscScalar *sol, *iter;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
 
-	fs  =  jr->fs;
-	bc  =  jr->bc;
-
-	// initialize maximal index in all directions
-	mcx = fs->dsx.tcels - 1;
-	mcy = fs->dsy.tcels - 1;
-	mcz = fs->dsz.tcels - 1;
+	fs = jr->fs;
 
 	// access vectors
 	ierr = VecGetArray    (jr->gp, &p);   CHKERRQ(ierr);
@@ -1867,8 +2017,38 @@ PetscErrorCode JacResCopyPres(JacRes *jr, Vec x)
 	ierr = VecRestoreArray    (jr->gp, &p);   CHKERRQ(ierr);
 	ierr = VecRestoreArrayRead(x,      &sol); CHKERRQ(ierr);
 
-	// fill local (ghosted) version of solution vectors
-	GLOBAL_TO_LOCAL(fs->DA_CEN, jr->gp, jr->lp)
+	// post ghost point scatter (completed in JacResCopyPresEnd)
+	ierr = DMGlobalToLocalBegin(fs->DA_CEN, jr->gp, INSERT_VALUES, jr->lp); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResCopyPresEnd(JacRes *jr)
+{
+	// finish ghost point exchange of pressure, enforce boundary constraints
+
+	FDSTAG            *fs;
+	BCCtx             *bc;
+	PetscInt          mcx, mcy, mcz;
+	PetscInt          I, J, K, fi, fj, fk;
+	PetscInt          i, j, k, nx, ny, nz, sx, sy, sz;
+	PetscScalar       ***bcp;
+	PetscScalar       ***lp;
+	PetscScalar       pmdof;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs  =  jr->fs;
+	bc  =  jr->bc;
+
+	// initialize maximal index in all directions
+	mcx = fs->dsx.tcels - 1;
+	mcy = fs->dsy.tcels - 1;
+	mcz = fs->dsz.tcels - 1;
+
+	// complete ghost point scatter
+	ierr = DMGlobalToLocalEnd(fs->DA_CEN, jr->gp, INSERT_VALUES, jr->lp); CHKERRQ(ierr);
 
 	// access local solution vectors
 	ierr = DMDAVecGetArray(fs->DA_CEN, jr->lp, &lp);  CHKERRQ(ierr);
@@ -2356,3 +2536,236 @@ PetscErrorCode JacResViewRes(JacRes *jr)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+PetscErrorCode JacResGetStepError(JacRes *jr, PetscScalar *eT, PetscScalar *eS)
+{
+	// get local error indicators of the time step:
+	// maximum temperature increment & maximum stress increment relative to
+	// maximum stress at the previous step (second invariants, edge components
+	// are averaged to cells). Stress criterion is inactive without history.
+
+	FDSTAG      *fs;
+	SolVarCell  *svCell;
+	SolVarEdge  *svEdge;
+	Vec          ldsxy, ldsxz, ldsyz, lhxy, lhxz, lhyz;
+	PetscScalar  ***lT, ***dsxy, ***dsxz, ***dsyz, ***hxy, ***hxz, ***hyz;
+	PetscScalar  dxx, dyy, dzz, d, J2d, J2h, lmax[3], gmax[3];
+	PetscInt     i, j, k, nx, ny, nz, sx, sy, sz, iter;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = jr->fs;
+
+	lmax[0] = 0.0;
+	lmax[1] = 0.0;
+	lmax[2] = 0.0;
+
+	// get edge buffers (squared stress increment & squared history stress)
+	ierr = DMGetLocalVector(fs->DA_XY, &ldsxy); CHKERRQ(ierr);
+	ierr = DMGetLocalVector(fs->DA_XZ, &ldsxz); CHKERRQ(ierr);
+	ierr = DMGetLocalVector(fs->DA_YZ, &ldsyz); CHKERRQ(ierr);
+	ierr = DMGetLocalVector(fs->DA_XY, &lhxy);  CHKERRQ(ierr);
+	ierr = DMGetLocalVector(fs->DA_XZ, &lhxz);  CHKERRQ(ierr);
+	ierr = DMGetLocalVector(fs->DA_YZ, &lhyz);  CHKERRQ(ierr);
+
+	ierr = DMDAVecGetArray(fs->DA_XY, ldsxy, &dsxy); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XZ, ldsxz, &dsxz); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_YZ, ldsyz, &dsyz); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XY, lhxy,  &hxy);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XZ, lhxz,  &hxz);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_YZ, lhyz,  &hyz);  CHKERRQ(ierr);
+
+	//-------------------------------
+	// xy edge points
+	//-------------------------------
+	iter = 0;
+	GET_NODE_RANGE(nx, sx, fs->dsx)
+	GET_NODE_RANGE(ny, sy, fs->dsy)
+	GET_CELL_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		svEdge = &jr->svXYEdge[iter++];
+
+		d = svEdge->s - svEdge->h;
+
+		dsxy[k][j][i] = d*d;
+		hxy [k][j][i] = svEdge->h*svEdge->h;
+	}
+	END_STD_LOOP
+
+	//-------------------------------
+	// xz edge points
+	//-------------------------------
+	iter = 0;
+	GET_NODE_RANGE(nx, sx, fs->dsx)
+	GET_CELL_RANGE(ny, sy, fs->dsy)
+	GET_NODE_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		svEdge = &jr->svXZEdge[iter++];
+
+		d = svEdge->s - svEdge->h;
+
+		dsxz[k][j][i] = d*d;
+		hxz [k][j][i] = svEdge->h*svEdge->h;
+	}
+	END_STD_LOOP
+
+	//-------------------------------
+	// yz edge points
+	//-------------------------------
+	iter = 0;
+	GET_CELL_RANGE(nx, sx, fs->dsx)
+	GET_NODE_RANGE(ny, sy, fs->dsy)
+	GET_NODE_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		svEdge = &jr->svYZEdge[iter++];
+
+		d = svEdge->s - svEdge->h;
+
+		dsyz[k][j][i] = d*d;
+		hyz [k][j][i] = svEdge->h*svEdge->h;
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(fs->DA_XY, ldsxy, &dsxy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XZ, ldsxz, &dsxz); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_YZ, ldsyz, &dsyz); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XY, lhxy,  &hxy);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XZ, lhxz,  &hxz);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_YZ, lhyz,  &hyz);  CHKERRQ(ierr);
+
+	// communicate ghost edge values
+	LOCAL_TO_LOCAL(fs->DA_XY, ldsxy)
+	LOCAL_TO_LOCAL(fs->DA_XZ, ldsxz)
+	LOCAL_TO_LOCAL(fs->DA_YZ, ldsyz)
+	LOCAL_TO_LOCAL(fs->DA_XY, lhxy)
+	LOCAL_TO_LOCAL(fs->DA_XZ, lhxz)
+	LOCAL_TO_LOCAL(fs->DA_YZ, lhyz)
+
+	ierr = DMDAVecGetArray(fs->DA_CEN, jr->lT, &lT);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XY,  ldsxy, &dsxy); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XZ,  ldsxz, &dsxz); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_YZ,  ldsyz, &dsyz); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XY,  lhxy,  &hxy);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XZ,  lhxz,  &hxz);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_YZ,  lhyz,  &hyz);  CHKERRQ(ierr);
+
+	//-------------------------------
+	// central points
+	//-------------------------------
+	iter = 0;
+	GET_CELL_RANGE(nx, sx, fs->dsx)
+	GET_CELL_RANGE(ny, sy, fs->dsy)
+	GET_CELL_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		svCell = &jr->svCell[iter++];
+
+		// temperature increment
+		lmax[0] = PetscMax(lmax[0], PetscAbsScalar(lT[k][j][i] - svCell->svBulk.Tn));
+
+		// stress increment (second invariant)
+		dxx = svCell->sxx - svCell->hxx;
+		dyy = svCell->syy - svCell->hyy;
+		dzz = svCell->szz - svCell->hzz;
+
+		J2d = 0.5*(dxx*dxx + dyy*dyy + dzz*dzz)
+		+ 0.25*(dsxy[k][j][i] + dsxy[k][j+1][i] + dsxy[k][j][i+1] + dsxy[k][j+1][i+1])
+		+ 0.25*(dsxz[k][j][i] + dsxz[k+1][j][i] + dsxz[k][j][i+1] + dsxz[k+1][j][i+1])
+		+ 0.25*(dsyz[k][j][i] + dsyz[k+1][j][i] + dsyz[k][j+1][i] + dsyz[k+1][j+1][i]);
+
+		// history stress (second invariant)
+		J2h = 0.5*(svCell->hxx*svCell->hxx + svCell->hyy*svCell->hyy + svCell->hzz*svCell->hzz)
+		+ 0.25*(hxy[k][j][i] + hxy[k][j+1][i] + hxy[k][j][i+1] + hxy[k][j+1][i+1])
+		+ 0.25*(hxz[k][j][i] + hxz[k+1][j][i] + hxz[k][j][i+1] + hxz[k+1][j][i+1])
+		+ 0.25*(hyz[k][j][i] + hyz[k+1][j][i] + hyz[k][j+1][i] + hyz[k+1][j+1][i]);
+
+		lmax[1] = PetscMax(lmax[1], PetscSqrtReal(J2d));
+		lmax[2] = PetscMax(lmax[2], PetscSqrtReal(J2h));
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->lT, &lT);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XY,  ldsxy, &dsxy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XZ,  ldsxz, &dsxz); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_YZ,  ldsyz, &dsyz); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XY,  lhxy,  &hxy);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XZ,  lhxz,  &hxz);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_YZ,  lhyz,  &hyz);  CHKERRQ(ierr);
+
+	ierr = DMRestoreLocalVector(fs->DA_XY, &ldsxy); CHKERRQ(ierr);
+	ierr = DMRestoreLocalVector(fs->DA_XZ, &ldsxz); CHKERRQ(ierr);
+	ierr = DMRestoreLocalVector(fs->DA_YZ, &ldsyz); CHKERRQ(ierr);
+	ierr = DMRestoreLocalVector(fs->DA_XY, &lhxy);  CHKERRQ(ierr);
+	ierr = DMRestoreLocalVector(fs->DA_XZ, &lhxz);  CHKERRQ(ierr);
+	ierr = DMRestoreLocalVector(fs->DA_YZ, &lhyz);  CHKERRQ(ierr);
+
+	// synchronize
+	if(ISParallel(PETSC_COMM_WORLD))
+	{
+		ierr = MPI_Allreduce(lmax, gmax, 3, MPIU_SCALAR, MPI_MAX, PETSC_COMM_WORLD); CHKERRQ(ierr);
+	}
+	else
+	{
+		gmax[0] = lmax[0];
+		gmax[1] = lmax[1];
+		gmax[2] = lmax[2];
+	}
+
+	(*eT) = gmax[0];
+	(*eS) = gmax[2] ? gmax[1]/gmax[2] : 0.0;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResGetVelChange(JacRes *jr, Vec x0, PetscScalar *chg)
+{
+	// get maximum velocity change relative to maximum velocity
+	// (velocity DOF are stored first in the coupled solution vector)
+
+	const PetscScalar *sol, *sol0;
+	PetscScalar        lmax[2], gmax[2];
+	PetscInt           i, lnv;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	lnv = jr->fs->dof.lnv;
+
+	lmax[0] = 0.0;
+	lmax[1] = 0.0;
+
+	ierr = VecGetArrayRead(jr->gsol, &sol);  CHKERRQ(ierr);
+	ierr = VecGetArrayRead(x0,       &sol0); CHKERRQ(ierr);
+
+	for(i = 0; i < lnv; i++)
+	{
+		lmax[0] = PetscMax(lmax[0], PetscAbsScalar(sol[i] - sol0[i]));
+		lmax[1] = PetscMax(lmax[1], PetscAbsScalar(sol[i]));
+	}
+
+	ierr = VecRestoreArrayRead(jr->gsol, &sol);  CHKERRQ(ierr);
+	ierr = VecRestoreArrayRead(x0,       &sol0); CHKERRQ(ierr);
+
+	// synchronize
+	if(ISParallel(PETSC_COMM_WORLD))
+	{
+		ierr = MPI_Allreduce(lmax, gmax, 2, MPIU_SCALAR, MPI_MAX, PETSC_COMM_WORLD); CHKERRQ(ierr);
+	}
+	else
+	{
+		gmax[0] = lmax[0];
+		gmax[1] = lmax[1];
+	}
+
+	(*chg) = gmax[1] ? gmax[0]/gmax[1] : 0.0;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
@@ -25,6 +25,7 @@ struct Dike;
 struct Tensor2RN;
 struct PData;
 struct AdvCtx;
+struct TMG;
 //struct ConstEqCtx;
 
 //---------------------------------------------------------------------------
@@ -131,6 +132,9 @@ struct Controls
 	PetscScalar steadyTempStep; // time for (quasi-)steady-state temperature initial guess
 	PetscInt    steadyNumStep;  // number of steps for (quasi-)steady-state temperature initial guess
 	PetscInt    actHeatRech;    // heat recharge setting
+	PetscInt    tempSubSteps;   // number of implicit temperature sub-steps per time step
+	PetscInt    stokesSkipMax;  // maximum number of consecutive time steps without Stokes solve
+	PetscScalar stokesSkipTol;  // relative velocity change below which Stokes solves are skipped
 	PetscInt    initLithPres;   // set initial pressure to lithostatic pressure
 	PetscInt    initGuess;      // initial guess activation flag
 	PetscInt    pLithoVisc;     // use lithostatic pressure for creep laws
@@ -195,7 +199,6 @@ struct JacRes
 	// velocity	components
 	Vec gvx,  gvy, gvz;  // global
 	Vec lvx,  lvy, lvz;  // local (ghosted)
-	Vec dvxdx,dvxdy, dvxdz,dvydx,dvydy,dvydz,dvzdx,dvzdy,dvzdz;  // velocity tensor components
 
 	// momentum residual components
 	Vec gfx,  gfy, gfz;  // global
@@ -203,19 +206,14 @@ struct JacRes
 
 	// strain-rate components (also used as buffer vectors)
 	Vec ldxx, ldyy, ldzz, ldxy, ldxz, ldyz; // local (ghosted)
-	Vec                   gdxy, gdxz, gdyz; // global
-	// (ADVInterpMarkToEdge & ADVInterpFieldToMark is the only
-	//  couple of functions where global vectors (gdxy, gdxz, gdyz) are used.
-	//  Get a fuck rid of this ugly averaging between markers & edges!
-	//  In ADVInterpFieldToMark it's easy.
-	//  In ADVInterpMarkToEdge it's impossible because of assembly operation.
-	//  Really really really need to switch to ghost marker approach!
-	//  Also to get communication pattern independent of number of phases.
 
-	// For almost all the purposes only one center-based array is necessary instead of three
-	// for example - strain rate contributions from centers can be stored in one array
-
-	// IN GENERAL GET RID OF BUFFER VECTORS, USE LOCAL DMGetLocalVector (GET_INIT_LOCAL_VECTOR)
+	// Temporary buffers (assembly vectors, corner interpolation, velocity
+	// gradients) are not stored here. They are borrowed from the vector cache
+	// of the corresponding DMDA (DMGetLocalVector/DMGetGlobalVector) and
+	// returned immediately after use, see JacResViewMemory.
+	// (Marker-to-edge projection uses ghost markers, see ADVGetGhostMarkers,
+	//  the assembly operation in ADVInterpMarkToEdge is only used for
+	//  periodic grids)
 
 	// pressure
 	Vec gp;      // global
@@ -226,9 +224,6 @@ struct JacRes
 	// continuity residual
 	Vec gc; // global
 
-	// corner buffer
-	Vec lbcor; // local (ghosted)
-
 	// solution variables
 	SolVarCell  *svCell;   // cell centers
 	SolVarEdge  *svXYEdge; // XY edges
@@ -240,6 +235,12 @@ struct JacRes
 	// Phase diagram
 	PData       *Pd;
 
+	// stress & strain rate orientation (computed on demand, cached until next step)
+	Vec          lshx, lshy; // SHmax direction (local, NULL if not requested)
+	Vec          lehx, lehy; // EHmax direction (local, NULL if not requested)
+	PetscInt     shStep;     // time step of cached SHmax (-1 if invalid)
+	PetscInt     ehStep;     // time step of cached EHmax (-1 if invalid)
+
 	// Adjoint field based gradients
 	Vec          lgradfield;
 	Vec          phi; // PSD context
@@ -254,6 +255,7 @@ struct JacRes
 	Vec dT;   // temperature increment (global)
 	Vec ge;   // energy residual (global)
 	KSP tksp; // temperature diffusion solver
+	TMG *tmg; // matrix-free operator & multigrid (NULL if not activated, see -temp_mf)
 
 	//==========================
 	// 2D integration primitives
@@ -285,6 +287,9 @@ PetscErrorCode JacResWriteRestart(JacRes *jr, FILE *fp);
 // destroy residual & Jacobian evaluation context
 PetscErrorCode JacResDestroy(JacRes *jr);
 
+// print memory of resident grid vectors & solution variables (-mem_report)
+PetscErrorCode JacResViewMemory(JacRes *jr);
+
 // form residual vector
 PetscErrorCode JacResFormResidual(JacRes *jr, Vec x, Vec f);
 
@@ -300,6 +305,9 @@ PetscErrorCode JacResGetEffStrainRate(JacRes *jr);
 // compute components of vorticity vector
 PetscErrorCode JacResGetVorticity(JacRes *jr);
 
+// compute velocity gradient component dv_iv/dx_id in local buffer
+PetscErrorCode JacResGetVelGradComp(JacRes *jr, PetscInt iv, PetscInt id, Vec lbuf);
+
 // compute nonlinear residual vectors
 PetscErrorCode JacResGetResidual(JacRes *jr);
 
@@ -312,6 +320,15 @@ PetscErrorCode JacResCopyVel(JacRes *jr, Vec x);
 // copy solution from global to local vectors, enforce boundary constraints
 PetscErrorCode JacResCopyPres(JacRes *jr, Vec x);
 
+// split-phase versions of the above (Begin posts ghost exchange, End completes it and enforces constraints)
+// any work that does not access the local solution vectors can be placed between Begin and End
+PetscErrorCode JacResCopySolBegin (JacRes *jr, Vec x);
+PetscErrorCode JacResCopySolEnd   (JacRes *jr);
+PetscErrorCode JacResCopyVelBegin (JacRes *jr, Vec x);
+PetscErrorCode JacResCopyVelEnd   (JacRes *jr);
+PetscErrorCode JacResCopyPresBegin(JacRes *jr, Vec x);
+PetscErrorCode JacResCopyPresEnd  (JacRes *jr);
+
 // initialize pressure
 PetscErrorCode JacResInitPres(JacRes *jr);
 
@@ -329,6 +346,12 @@ PetscErrorCode JacResCopyContinuityRes(JacRes *jr, Vec f);
 
 PetscErrorCode JacResViewRes(JacRes *jr);
 
+// get local error indicators of the time step (temperature & relative stress increments)
+PetscErrorCode JacResGetStepError(JacRes *jr, PetscScalar *eT, PetscScalar *eS);
+
+// get maximum velocity change relative to maximum velocity (x0 - reference solution)
+PetscErrorCode JacResGetVelChange(JacRes *jr, Vec x0, PetscScalar *chg);
+
 //---------------------------------------------------------------------------
 
 // compute velocity gradient and normalized velocities at cell center
@@ -340,11 +363,17 @@ PetscErrorCode getGradientVel(
 //---------------------------------------------------------------------------
 
 // compute maximum horizontal compressive stress (SHmax) orientation
+// (stored in lshx, lshy, computed once per time step)
 PetscErrorCode JacResGetSHmax(JacRes *jr);
 
 // compute maximum horizontal extension rate (EHmax) orientation
+// (stored in lehx, lehy, computed once per time step)
 PetscErrorCode JacResGetEHmax(JacRes *jr);
 
+// compute horizontal orientation of principal direction for a 2D tensor field
+// (isel: 0 - direction of largest, 1 - direction of smallest eigenvalue)
+PetscErrorCode JacResGetHorizDir(JacRes *jr, Vec lxx, Vec lyy, Vec lxy, PetscInt isel, Vec ldx, Vec ldy);
+
 //---------------------------------------------------------------------------
 // Effective permeability functions
 //---------------------------------------------------------------------------
@@ -389,6 +418,9 @@ PetscErrorCode JacResGetTempRes(JacRes *jr, PetscScalar dt);
 // assemble temperature preconditioner matrix
 PetscErrorCode JacResGetTempMat(JacRes *jr, PetscScalar dt);
 
+// solve energy equation (with optional sub-stepping of the time step)
+PetscErrorCode JacResSolveTemp(JacRes *jr, PetscScalar dt);
+
 //---------------------------------------------------------------------------
 //......................   INTEGRATION FUNCTIONS   ..........................
 //---------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include "JacRes.h"
 #include "fdstag.h"
 #include "surf.h"
+#include "tssolve.h"
 #include "phase.h"
 #include "tools.h"
 #include "Tensor.h"
@@ -103,10 +104,8 @@ PetscErrorCode JacResGetSHmax(JacRes *jr)
 	// compute maximum horizontal compressive stress (SHmax) orientation
 
 	FDSTAG      *fs;
-	SolVarCell  *svCell;
 	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, iter;
-	PetscScalar v1[3], v2[3], sxx, syy, sxy, s1, s2;
-	PetscScalar ***dx, ***dy, ***lsxy;
+	PetscScalar ***sxx, ***syy, ***lsxy;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -114,6 +113,15 @@ PetscErrorCode JacResGetSHmax(JacRes *jr)
 	// access context
 	fs = jr->fs;
 
+	// check whether orientation is already available for this step
+	if(jr->lshx && jr->shStep == jr->ts->istep) PetscFunctionReturn(0);
+
+	if(!jr->lshx)
+	{
+		ierr = DMCreateLocalVector(fs->DA_CEN, &jr->lshx); CHKERRQ(ierr);
+		ierr = DMCreateLocalVector(fs->DA_CEN, &jr->lshy); CHKERRQ(ierr);
+	}
+
 	// setup shear stress vector
 	ierr = DMDAVecGetArray(fs->DA_XY, jr->ldxy, &lsxy); CHKERRQ(ierr);
 
@@ -131,10 +139,9 @@ PetscErrorCode JacResGetSHmax(JacRes *jr)
 
 	LOCAL_TO_LOCAL(fs->DA_XY, jr->ldxy);
 
-	// get SHmax
-	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldxx, &dx);   CHKERRQ(ierr);
-	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldyy, &dy);   CHKERRQ(ierr);
-	ierr = DMDAVecGetArray(fs->DA_XY,  jr->ldxy, &lsxy); CHKERRQ(ierr);
+	// setup normal stress vectors
+	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldxx, &sxx); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldyy, &syy); CHKERRQ(ierr);
 
 	ierr = DMDAGetCorners(fs->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
 
@@ -142,34 +149,19 @@ PetscErrorCode JacResGetSHmax(JacRes *jr)
 
 	START_STD_LOOP
 	{
-		svCell = &jr->svCell[iter++];
-		sxx    = svCell->sxx;
-		syy    = svCell->syy;
-		sxy    = (lsxy[k][j][i] + lsxy[k][j][i+1] + lsxy[k][j+1][i] + lsxy[k][j+1][i+1])/4.0;
-
-		// maximum compressive stress orientation is the eigenvector of the SMALLEST eigenvalue
-		// (stress is negative in compression)
-		ierr = Tensor2RS2DSpectral(sxx, syy, sxy, &s1, &s2, v1, v2, 1e-12); CHKERRQ(ierr);
-
-		// get common sense
-		if(v2[0] < 0.0 || (v2[0] == 0.0 && v2[1] < 0.0))
-		{
-			v2[0] = -v2[0];
-			v2[1] = -v2[1];
-		}
-
-		// store direction vector for output
-		dx[k][j][i] = v2[0];
-		dy[k][j][i] = v2[1];
+		sxx[k][j][i] = jr->svCell[iter  ].sxx;
+		syy[k][j][i] = jr->svCell[iter++].syy;
 	}
 	END_STD_LOOP
 
-	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldxx, &dx);   CHKERRQ(ierr);
-	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldyy, &dy);   CHKERRQ(ierr);
-	ierr = DMDAVecRestoreArray(fs->DA_XY,  jr->ldxy, &lsxy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldxx, &sxx); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldyy, &syy); CHKERRQ(ierr);
+
+	// maximum compressive stress orientation is the eigenvector of the SMALLEST eigenvalue
+	// (stress is negative in compression)
+	ierr = JacResGetHorizDir(jr, jr->ldxx, jr->ldyy, jr->ldxy, 1, jr->lshx, jr->lshy); CHKERRQ(ierr);
 
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldxx);
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldyy);
+	jr->shStep = jr->ts->istep;
 
 	PetscFunctionReturn(0);
 }
@@ -179,10 +171,8 @@ PetscErrorCode JacResGetEHmax(JacRes *jr)
 	// compute maximum horizontal extension rate (EHmax) orientation
 
 	FDSTAG      *fs;
-	SolVarCell  *svCell;
 	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, iter;
-	PetscScalar v1[3], v2[3], dxx, dyy, dxy, d1, d2;
-	PetscScalar ***dx, ***dy, ***ldxy;
+	PetscScalar ***dxx, ***dyy, ***ldxy;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -190,6 +180,15 @@ PetscErrorCode JacResGetEHmax(JacRes *jr)
 	// access context
 	fs = jr->fs;
 
+	// check whether orientation is already available for this step
+	if(jr->lehx && jr->ehStep == jr->ts->istep) PetscFunctionReturn(0);
+
+	if(!jr->lehx)
+	{
+		ierr = DMCreateLocalVector(fs->DA_CEN, &jr->lehx); CHKERRQ(ierr);
+		ierr = DMCreateLocalVector(fs->DA_CEN, &jr->lehy); CHKERRQ(ierr);
+	}
+
 	// setup shear strain rate vector
 	ierr = DMDAVecGetArray(fs->DA_XY, jr->ldxy, &ldxy); CHKERRQ(ierr);
 
@@ -207,10 +206,9 @@ PetscErrorCode JacResGetEHmax(JacRes *jr)
 
 	LOCAL_TO_LOCAL(fs->DA_XY, jr->ldxy);
 
-	// get EHmax
-	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldxx, &dx);   CHKERRQ(ierr);
-	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldyy, &dy);   CHKERRQ(ierr);
-	ierr = DMDAVecGetArray(fs->DA_XY,  jr->ldxy, &ldxy); CHKERRQ(ierr);
+	// setup normal strain rate vectors
+	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldxx, &dxx); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_CEN, jr->ldyy, &dyy); CHKERRQ(ierr);
 
 	ierr = DMDAGetCorners(fs->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
 
@@ -218,34 +216,106 @@ PetscErrorCode JacResGetEHmax(JacRes *jr)
 
 	START_STD_LOOP
 	{
-		svCell = &jr->svCell[iter++];
-		dxx    = svCell->dxx;
-		dyy    = svCell->dyy;
-		dxy    = (ldxy[k][j][i] + ldxy[k][j][i+1] + ldxy[k][j+1][i] + ldxy[k][j+1][i+1])/4.0;
+		dxx[k][j][i] = jr->svCell[iter  ].dxx;
+		dyy[k][j][i] = jr->svCell[iter++].dyy;
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldxx, &dxx); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldyy, &dyy); CHKERRQ(ierr);
+
+	// maximum extension rate orientation is the eigenvector of the LARGEST eigenvalue
+	// (strain rate is positive in extension)
+	ierr = JacResGetHorizDir(jr, jr->ldxx, jr->ldyy, jr->ldxy, 0, jr->lehx, jr->lehy); CHKERRQ(ierr);
+
+	jr->ehStep = jr->ts->istep;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode JacResGetHorizDir(JacRes *jr, Vec lxx, Vec lyy, Vec lxy, PetscInt isel, Vec ldx, Vec ldy)
+{
+	// compute horizontal orientation of principal direction for a 2D tensor field
+	// normal components are given in cell centers, shear component in XY edges
+	// cell rows are decomposed at once with the closed-form batch solver
+
+	FDSTAG      *fs;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, ii;
+	PetscScalar ***axx, ***ayy, ***axy, ***dx, ***dy;
+	PetscScalar *buff, *bxx, *byy, *bxy, *a1, *a2, *v1, *v2, *v, e[2];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
 
-		// maximum extension rate orientation is the eigenvector of the LARGEST eigenvalue
-		// (strain rate is positive in extension)
-		ierr = Tensor2RS2DSpectral(dxx, dyy, dxy, &d1, &d2, v1, v2, 1e-12); CHKERRQ(ierr);
+	// access context
+	fs = jr->fs;
+
+	ierr = DMDAGetCorners(fs->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	// allocate row buffers
+	ierr = PetscMalloc1(9*nx, &buff); CHKERRQ(ierr);
+
+	bxx = buff;
+	byy = bxx + nx;
+	bxy = byy + nx;
+	a1  = bxy + nx;
+	a2  = a1  + nx;
+	v1  = a2  + nx;
+	v2  = v1  + 2*nx;
+
+	// select eigenvector
+	v = isel ? v2 : v1;
+
+	ierr = DMDAVecGetArray(fs->DA_CEN, lxx, &axx); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_CEN, lyy, &ayy); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_XY,  lxy, &axy); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_CEN, ldx, &dx);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_CEN, ldy, &dy);  CHKERRQ(ierr);
 
-		// get common sense
-		if(v1[0] < 0.0 || (v1[0] == 0.0 && v1[1] < 0.0))
+	for(k = sz; k < sz+nz; k++)
+	{
+		for(j = sy; j < sy+ny; j++)
 		{
-			v1[0] = -v1[0];
-			v1[1] = -v1[1];
-		}
+			// gather tensor components of the row
+			for(i = sx, ii = 0; i < sx+nx; i++, ii++)
+			{
+				bxx[ii] = axx[k][j][i];
+				byy[ii] = ayy[k][j][i];
+				bxy[ii] = (axy[k][j][i] + axy[k][j][i+1] + axy[k][j+1][i] + axy[k][j+1][i+1])/4.0;
+			}
 
-		// store direction vector for output
-		dx[k][j][i] = v1[0];
-		dy[k][j][i] = v1[1];
+			// decompose
+			Tensor2RS2DSpectralBatch(nx, bxx, byy, bxy, a1, a2, v1, v2, 1e-12);
+
+			// store direction vectors for output
+			for(i = sx, ii = 0; i < sx+nx; i++, ii++)
+			{
+				e[0] = v[2*ii  ];
+				e[1] = v[2*ii+1];
+
+				// get common sense
+				if(e[0] < 0.0 || (e[0] == 0.0 && e[1] < 0.0))
+				{
+					e[0] = -e[0];
+					e[1] = -e[1];
+				}
+
+				dx[k][j][i] = e[0];
+				dy[k][j][i] = e[1];
+			}
+		}
 	}
-	END_STD_LOOP
 
-	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldxx, &dx);   CHKERRQ(ierr);
-	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->ldyy, &dy);   CHKERRQ(ierr);
-	ierr = DMDAVecRestoreArray(fs->DA_XY,  jr->ldxy, &ldxy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, lxx, &axx); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, lyy, &ayy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_XY,  lxy, &axy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, ldx, &dx);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_CEN, ldy, &dy);  CHKERRQ(ierr);
 
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldxx);
-	LOCAL_TO_LOCAL(fs->DA_CEN, jr->ldyy);
+	ierr = PetscFree(buff); CHKERRQ(ierr);
+
+	LOCAL_TO_LOCAL(fs->DA_CEN, ldx);
+	LOCAL_TO_LOCAL(fs->DA_CEN, ldy);
 
 	PetscFunctionReturn(0);
 }
@@ -295,11 +365,11 @@ PetscErrorCode JacResGetOverPressure(JacRes *jr, Vec lop)
 PetscErrorCode JacResGetLithoStaticPressure(JacRes *jr)
 {
 	// compute lithostatic pressure
+	// (local column integrals, exclusive scan over the processors above, local fix-up)
 
 	Vec         vbuff;
 	FDSTAG      *fs;
 	Discret1D   *dsz;
-	MPI_Request srequest, rrequest;
 	PetscScalar ***lp, ***ibuff, *lbuff, dz, dp, g, rho;
 	PetscInt    i, j, k, sx, sy, sz, nx, ny, nz, iter, L;
 
@@ -326,32 +396,27 @@ PetscErrorCode JacResGetLithoStaticPressure(JacRes *jr)
 	// open index buffer for computation
 	ierr = DMDAVecGetArray(jr->DA_CELL_2D, vbuff, &ibuff); CHKERRQ(ierr);
 
-	// open linear buffer for send/receive
+	// open linear buffer for scan
 	ierr = VecGetArray(vbuff, &lbuff); CHKERRQ(ierr);
 
 	// access lithostatic pressure
 	ierr = DMDAVecGetArray(fs->DA_CEN, jr->lp_lith, &lp); CHKERRQ(ierr);
 
-	// start receiving integral from top domain (next)
-	if(dsz->nproc != 1 && dsz->grnext != -1)
-	{
-		ierr = MPI_Irecv(lbuff, (PetscMPIInt)(nx*ny), MPIU_SCALAR, dsz->grnext, 0, PETSC_COMM_WORLD, &rrequest); CHKERRQ(ierr);
-	}
-
-	// copy density
+	// copy density, compute local column integral
 	iter = 0;
 
 	START_STD_LOOP
 	{
-		lp[k][j][i] = jr->svCell[iter++].svBulk.rho;
+		rho = jr->svCell[iter++].svBulk.rho;
+
+		lp[k][j][i] = rho;
+
+		ibuff[L][j][i] += rho*g*SIZE_CELL(k, sz, (*dsz));
 	}
 	END_STD_LOOP
 
-	// finish receiving
-	if(dsz->nproc != 1 && dsz->grnext != -1)
-	{
-		ierr = MPI_Wait(&rrequest, MPI_STATUSES_IGNORE);  CHKERRQ(ierr);
-	}
+	// get integral over all domains above (next)
+	ierr = Discret1DColumnExscan(dsz, lbuff, nx*ny, PETSC_TRUE); CHKERRQ(ierr);
 
 	// compute local integral from top to bottom
 	for(k = sz + nz - 1; k >= sz; k--)
@@ -372,14 +437,6 @@ PetscErrorCode JacResGetLithoStaticPressure(JacRes *jr)
 		END_PLANE_LOOP
 	}
 
-	// send integral to bottom domain (previous)
-	if(dsz->nproc != 1 && dsz->grprev != -1)
-	{
-		ierr = MPI_Isend(lbuff, (PetscMPIInt)(nx*ny), MPIU_SCALAR, dsz->grprev, 0, PETSC_COMM_WORLD, &srequest); CHKERRQ(ierr);
-
-		ierr = MPI_Wait(&srequest, MPI_STATUSES_IGNORE);  CHKERRQ(ierr);
-	}
-
 	// restore buffer and pressure vectors
 	ierr = DMDAVecRestoreArray(fs->DA_CEN, jr->lp_lith, &lp); CHKERRQ(ierr);
 
@@ -20,6 +20,7 @@
 #include "matrix.h"
 #include "surf.h"
 #include "dike.h"
+#include "tempmg.h"
 
 //---------------------------------------------------------------------------
 
@@ -171,10 +172,12 @@ PetscErrorCode JacResCreateTempParam(JacRes *jr)
 
 	FDSTAG *fs;
 	const PetscInt *lx, *ly, *lz;
+	PetscBool flg;
 
 	PetscFunctionBeginUser;
 
-	fs = jr->fs;
+	fs      = jr->fs;
+	jr->tmg = NULL;
 
 	// create local temperature vector using box-stencil central DMDA
 	PetscCall(DMCreateLocalVector(fs->DA_CEN, &jr->lT));
@@ -193,14 +196,28 @@ PetscErrorCode JacResCreateTempParam(JacRes *jr)
 		fs->dsx.nproc, fs->dsy.nproc, fs->dsz.nproc,
 		1, 1, lx, ly, lz, &jr->DA_T));
 
-	// create temperature preconditioner matrix
-	PetscCall(DMCreateMatrix(jr->DA_T, &jr->Att));
+	// check whether matrix-free operator & multigrid are requested
+	PetscCall(PetscOptionsHasName(NULL, NULL, "-temp_mf", &flg));
 
-	// set matrix options (development)
-	PetscCall(MatSetOption(jr->Att, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE));
-	PetscCall(MatSetOption(jr->Att, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE));
-	PetscCall(MatSetOption(jr->Att, MAT_KEEP_NONZERO_PATTERN, PETSC_TRUE));
-	PetscCall(MatSetOption(jr->Att, MAT_NO_OFF_PROC_ZERO_ROWS, PETSC_TRUE));
+	if(flg)
+	{
+		// create multigrid levels & matrix-free operator
+		PetscCall(PetscMalloc(sizeof(TMG), &jr->tmg));
+		PetscCall(TMGCreate(jr->tmg, jr));
+
+		jr->Att = jr->tmg->A;
+	}
+	else
+	{
+		// create temperature preconditioner matrix
+		PetscCall(DMCreateMatrix(jr->DA_T, &jr->Att));
+
+		// set matrix options (development)
+		PetscCall(MatSetOption(jr->Att, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE));
+		PetscCall(MatSetOption(jr->Att, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE));
+		PetscCall(MatSetOption(jr->Att, MAT_KEEP_NONZERO_PATTERN, PETSC_TRUE));
+		PetscCall(MatSetOption(jr->Att, MAT_NO_OFF_PROC_ZERO_ROWS, PETSC_TRUE));
+	}
 
 	// temperature solution vector
 	PetscCall(DMCreateGlobalVector(jr->DA_T, &jr->dT));
@@ -211,6 +228,7 @@ PetscErrorCode JacResCreateTempParam(JacRes *jr)
 	// create temperature diffusion solver
 	PetscCall(KSPCreate(PETSC_COMM_WORLD, &jr->tksp));
 	PetscCall(KSPSetOptionsPrefix(jr->tksp,"ts_"));
+	if(jr->tmg) PetscCall(TMGSetPC(jr->tmg, jr->tksp));
 	PetscCall(KSPSetFromOptions(jr->tksp));
 
 	PetscFunctionReturn(0);
@@ -237,6 +255,12 @@ PetscErrorCode JacResDestroyTempParam(JacRes *jr)
 
 	PetscCall(KSPDestroy(&jr->tksp));
 
+	if(jr->tmg)
+	{
+		PetscCall(TMGDestroy(jr->tmg));
+		PetscCall(PetscFree(jr->tmg));
+	}
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -591,7 +615,9 @@ PetscErrorCode JacResGetTempMat(JacRes *jr, PetscScalar dt)
 	PetscScalar v[7], cf[6], kc, rho_Cp, invdt, Tc, cond;
 	MatStencil  row[1], col[7];
 	PetscScalar ***lk, ***bcT, ***buff, ***lT;
+	PetscScalar ***gk, ***gm, ***msk;
 	PetscScalar y_c;
+	TMGLevel   *lvl;
 	
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -601,6 +627,7 @@ PetscErrorCode JacResGetTempMat(JacRes *jr, PetscScalar dt)
 	bc   = jr->bc;
 	num  = bc->tNumSPC;
 	list = bc->tSPCList;
+	lvl  = NULL;
 
 	// compute inverse time step
 	if(dt) invdt = 1.0/dt;
@@ -615,8 +642,20 @@ PetscErrorCode JacResGetTempMat(JacRes *jr, PetscScalar dt)
 
 	SCATTER_FIELD(fs->DA_CEN, jr->ldxx, lT, GET_KC)
 
-	// clear matrix coefficients
-	PetscCall(MatZeroEntries(jr->Att));
+	if(jr->tmg)
+	{
+		// access matrix-free operator coefficients
+		lvl = &jr->tmg->lvls[0];
+
+		PetscCall(DMDAVecGetArray(jr->DA_T, lvl->gk,  &gk));
+		PetscCall(DMDAVecGetArray(jr->DA_T, lvl->m,   &gm));
+		PetscCall(DMDAVecGetArray(jr->DA_T, lvl->msk, &msk));
+	}
+	else
+	{
+		// clear matrix coefficients
+		PetscCall(MatZeroEntries(jr->Att));
+	}
 
 	// access work vectors
 	PetscCall(DMDAVecGetArray(fs->DA_CEN, jr->ldxx, &lk));
@@ -653,6 +692,20 @@ PetscErrorCode JacResGetTempMat(JacRes *jr, PetscScalar dt)
         // to output as a paraview-field
 		cond = kc;
 		svBulk->cond = cond;
+
+		if(jr->tmg)
+		{
+			// store coefficients, operator is applied matrix-free
+			gk[k][j][i] = kc;
+			gm[k][j][i] = invdt*rho_Cp;
+
+			msk[k][j][i] = (PetscScalar)(
+				(cf[0] < 0.0 ? _TMG_XM_ : 0) | (cf[1] < 0.0 ? _TMG_XP_ : 0) |
+				(cf[2] < 0.0 ? _TMG_YM_ : 0) | (cf[3] < 0.0 ? _TMG_YP_ : 0) |
+				(cf[4] < 0.0 ? _TMG_ZM_ : 0) | (cf[5] < 0.0 ? _TMG_ZP_ : 0));
+
+			continue;
+		}
 		
  		// compute average conductivities
 		bkx = (kc + lk[k][j][Im1])/2.0;      fkx = (kc + lk[k][j][Ip1])/2.0;
@@ -703,12 +756,95 @@ PetscErrorCode JacResGetTempMat(JacRes *jr, PetscScalar dt)
 	PetscCall(DMDAVecRestoreArray(fs->DA_CEN, bc->bcT, &bcT));
 	PetscCall(DMDAVecRestoreArray(fs->DA_CEN, jr->lT,   &lT));
 
+	if(jr->tmg)
+	{
+		PetscCall(DMDAVecRestoreArray(jr->DA_T, lvl->gk,  &gk));
+		PetscCall(DMDAVecRestoreArray(jr->DA_T, lvl->m,   &gm));
+		PetscCall(DMDAVecRestoreArray(jr->DA_T, lvl->msk, &msk));
+
+		// restrict coefficients to coarse grids
+		PetscCall(TMGSetup(jr->tmg));
+
+		// mark matrix-free operator as changed
+		// (otherwise PCMG is not set up again, and fine grid smoother keeps old diagonal)
+		PetscCall(PetscObjectStateIncrease((PetscObject)jr->Att));
+
+		PetscFunctionReturn(0);
+	}
+
 	// assemble temperature matrix
 	PetscCall(MatAIJAssemble(jr->Att, num, list, 1.0));
 
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+PetscErrorCode JacResSolveTemp(JacRes *jr, PetscScalar dt)
+{
+	// solve energy equation over the time step
+	// time step is split into a number of implicit sub-steps (temp_sub_steps),
+	// all sub-steps use the current velocity field and material properties
+
+	FDSTAG      *fs;
+	PetscScalar ***lT, *Tn, ddt;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, iter, isub, nsub;
+
+	PetscFunctionBeginUser;
+
+	fs   = jr->fs;
+	nsub = jr->ctrl.tempSubSteps;
+	ddt  = dt/(PetscScalar)nsub;
+	Tn   = NULL;
+
+	if(nsub > 1)
+	{
+		// store temperature history
+		PetscCall(PetscMalloc((size_t)fs->nCells*sizeof(PetscScalar), &Tn));
+
+		for(iter = 0; iter < fs->nCells; iter++) Tn[iter] = jr->svCell[iter].svBulk.Tn;
+
+		// integrate from the beginning of the time step
+		PetscCall(JacResInitTemp(jr));
+	}
+
+	for(isub = 0; isub < nsub; isub++)
+	{
+		if(isub)
+		{
+			// previous sub-step defines temperature history
+			PetscCall(DMDAVecGetArray(fs->DA_CEN, jr->lT, &lT));
+
+			iter = 0;
+
+			PetscCall(DMDAGetCorners(fs->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz));
+
+			START_STD_LOOP
+			{
+				jr->svCell[iter++].svBulk.Tn = lT[k][j][i];
+			}
+			END_STD_LOOP
+
+			PetscCall(DMDAVecRestoreArray(fs->DA_CEN, jr->lT, &lT));
+		}
+
+		PetscCall(JacResGetTempRes(jr, ddt));
+		PetscCall(JacResGetTempMat(jr, ddt));
+		PetscCall(KSPSetOperators(jr->tksp, jr->Att, jr->Att));
+		PetscCall(KSPSetUp(jr->tksp));
+		PetscCall(KSPSolve(jr->tksp, jr->ge, jr->dT));
+		PetscCall(JacResUpdateTemp(jr));
+	}
+
+	if(nsub > 1)
+	{
+		// restore temperature history
+		for(iter = 0; iter < fs->nCells; iter++) jr->svCell[iter].svBulk.Tn = Tn[iter];
+
+		PetscCall(PetscFree(Tn));
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
 /*
 Diffusion term expansion
 
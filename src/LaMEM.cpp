@@ -13,16 +13,25 @@
 #include "parsing.h"
 #include "adjoint.h"
 #include "phase.h"
+#include "ensemble.h"
 //---------------------------------------------------------------------------
 static char help[] = "Solves 3D Stokes equations using multigrid .\n\n";
 //---------------------------------------------------------------------------
 int main(int argc, char **argv)
 {
-	PetscErrorCode 	ierr;
+	PetscErrorCode 	ierr, status;
+	Ensemble        ens;
+	RunSummary      sum;
+
+	// split world communicator between ensemble members (if requested)
+	ierr = EnsembleCreate(&ens, &argc, &argv); if(ierr) return ierr;
 
 	// Initialize PETSC
 	ierr = PetscInitialize(&argc,&argv,(char *)0, help); CHKERRQ(ierr);
 
+	// add ensemble member options
+	ierr = EnsembleSetOptions(&ens); CHKERRQ(ierr);
+
 	ModParam IOparam;
 	char      str[_str_len_];
 
@@ -41,8 +50,25 @@ int main(int argc, char **argv)
 	else{
 		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Unknown parameter for 'Adjoint_mode'. Possibilities are [None; GenericInversion; AdjointGradients; GradientDescent or SyntheticForwardRun]");
 	} 
+
+	if(ens.nmemb && IOparam.use != _none_)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Ensemble mode is only available for forward simulations (check Adjoint_mode parameter)");
+	}
+
+	// set ensemble member output
+	ierr = EnsembleSetOutput(&ens, IOparam.fb); CHKERRQ(ierr);
 	
-	if(IOparam.use == 0)
+	if(IOparam.use == 0 && ens.nmemb)
+	{
+		// Ensemble member simulation (failure of a member does not stop the others)
+		ierr = PetscMemzero(&sum, sizeof(RunSummary)); CHKERRQ(ierr);
+
+		status = LaMEMLibMain(NULL, &sum);
+
+		ierr = EnsembleReport(&ens, &sum, status); CHKERRQ(ierr);
+	}
+	else if(IOparam.use == 0)
 	{
 		// Forward simulation	
 		ierr = LaMEMLibMain(NULL); CHKERRQ(ierr);
@@ -59,6 +85,9 @@ int main(int argc, char **argv)
 	// cleanup PETSC
 	ierr = PetscFinalize(); CHKERRQ(ierr);
 
+	// finalize ensemble
+	ierr = EnsembleDestroy(&ens); if(ierr) return ierr;
+
 	return 0;
 }
 //--------------------------------------------------------------------------
@@ -41,6 +41,9 @@
 // marker storage capacity overhead
 #define _cap_overhead_ 1.61803398875
 
+// marker storage granularity (number of markers in a chunk)
+#define _mark_chunk_ 4096
+
 // maximum marker per cell per direction
 #define _max_nmark_ 5
 
@@ -92,6 +95,9 @@
 // maximum number of components in the output vector (3D)
 #define _max_num_comp_ 9
 
+// maximum number of fused output components evaluated in one pass
+#define _max_num_fused_comp_ 18
+
 // maximum number of components in the output vector (surface)
 #define _max_num_comp_surf_ 3
 
@@ -187,9 +193,18 @@ typedef pair <PetscInt,    PetscInt> ipair;
 // PROTOTYPES
 //-----------------------------------------------------------------------------
 
+// summary of a forward run
+
+struct RunSummary
+{
+	PetscInt       istep; // number of completed time steps
+	PetscScalar    time;  // final model time (output units)
+	PetscLogDouble wtime; // total solution time (sec)
+};
+
 // LaMEM library main function
 
-PetscErrorCode LaMEMLibMain(void *param);
+PetscErrorCode LaMEMLibMain(void *param, RunSummary *sum = NULL);
 
 //-----------------------------------------------------------------------------
 #endif
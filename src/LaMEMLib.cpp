@@ -40,9 +40,10 @@
 #include "LaMEMLib.h"
 #include "phase_transition.h"
 #include "passive_tracer.h"
+#include "tempmg.h"
 
 //---------------------------------------------------------------------------
-PetscErrorCode LaMEMLibMain(void *param)
+PetscErrorCode LaMEMLibMain(void *param, RunSummary *sum)
 {
 	LaMEMLib       lm;
 	RunMode        mode;
@@ -133,11 +134,20 @@ PetscErrorCode LaMEMLibMain(void *param)
 		ierr = LaMEMLibSolve(&lm, param); CHKERRQ(ierr);
 	}
 
+	// store run summary
+	if(sum)
+	{
+		sum->istep = lm.ts.istep;
+		sum->time  = lm.ts.time*lm.scal.time;
+	}
+
 	// destroy library objects
 	ierr = LaMEMLibDestroy(&lm); CHKERRQ(ierr);
 
 	PetscTime(&cputime_end);
 
+	if(sum) sum->wtime = cputime_end - cputime_start;
+
 	PetscPrintf(PETSC_COMM_WORLD, "Total solution time : %g (sec) \n", cputime_end - cputime_start);
 	PetscPrintf(PETSC_COMM_WORLD, "--------------------------------------------------------------------------\n");
 
@@ -611,8 +621,11 @@ PetscErrorCode LaMEMLibSolve(LaMEMLib *lm, void *param)
 	NLSol          nl;     // nonlinear solver context (to be removed!)
  	AdjGrad        aop;    // Adjoint options          (to be removed!)
 	SNES           snes;   // PETSc nonlinear solver
-	PetscInt       restart;
+	Vec            gsol0;  // initial guess of the time step (error-controlled time stepping & Stokes skipping)
+	PetscInt       restart, its, nskip;
+	PetscScalar    eT, eS, chg;
 	PetscLogDouble t;
+	SNESConvergedReason reason;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -627,6 +640,16 @@ PetscErrorCode LaMEMLibSolve(LaMEMLib *lm, void *param)
 	//==============
 
 	ierr = LaMEMLibInitGuess(lm, snes); CHKERRQ(ierr);
+
+	// create storage for initial guess of rejected time steps
+	// (also serves as reference solution for velocity change monitor)
+	gsol0 = NULL;
+	nskip = 0;
+
+	if(lm->ts.adapt || lm->jr.ctrl.stokesSkipMax)
+	{
+		ierr = VecDuplicate(lm->jr.gsol, &gsol0); CHKERRQ(ierr);
+	}
     
 	if (param)
 	{
@@ -655,17 +678,76 @@ PetscErrorCode LaMEMLibSolve(LaMEMLib *lm, void *param)
 		// compute elastic parameters
 		ierr = JacResGetI2Gdt(&lm->jr); CHKERRQ(ierr);
 
-		// solve nonlinear equation system with SNES
-		PetscTime(&t);
+		// store initial guess (restored if time step is rejected)
+		if(gsol0) { ierr = VecCopy(lm->jr.gsol, gsol0); CHKERRQ(ierr); }
 
-		ierr = SNESSolve(snes, NULL, lm->jr.gsol); CHKERRQ(ierr);
+		if(nskip)
+		{
+			// velocity field is quasi-stationary, skip Stokes solve
+			// update stresses & solve energy equation with previous velocity
+			PetscPrintf(PETSC_COMM_WORLD, "Skipping Stokes solve (remaining skips: %lld) \n", (LLD)(nskip-1));
 
-		// print analyze convergence/divergence reason & iteration count
-		ierr = SNESPrintConvergedReason(snes, t); CHKERRQ(ierr);
+			ierr = JacResFormResidual(&lm->jr, lm->jr.gsol, lm->jr.gres); CHKERRQ(ierr);
+
+			if(lm->jr.ctrl.actTemp)
+			{
+				ierr = JacResSolveTemp(&lm->jr, lm->ts.dt); CHKERRQ(ierr);
+			}
+
+			reason = SNES_CONVERGED_ITS;
+			its    = 0;
+		}
+		else
+		{
+			// solve nonlinear equation system with SNES
+			PetscTime(&t);
+
+			ierr = SNESSolve(snes, NULL, lm->jr.gsol); CHKERRQ(ierr);
+
+			// print analyze convergence/divergence reason & iteration count
+			ierr = SNESPrintConvergedReason(snes, t); CHKERRQ(ierr);
+
+			ierr = SNESGetConvergedReason(snes, &reason); CHKERRQ(ierr);
+			ierr = SNESGetIterationNumber(snes, &its);    CHKERRQ(ierr);
+		}
 
 		// view nonlinear residual
 		ierr = JacResViewRes(&lm->jr); CHKERRQ(ierr);
 
+		// estimate local error, reject time step if necessary
+		if(lm->ts.adapt)
+		{
+
+			ierr = JacResGetStepError(&lm->jr, &eT, &eS); CHKERRQ(ierr);
+
+			ierr = TSSolCheckStep(&lm->ts, reason > 0, its, eT, eS, &restart); CHKERRQ(ierr);
+
+			// repeat time step from the same initial guess (with Stokes solve)
+			if(restart)
+			{
+				ierr = VecCopy(gsol0, lm->jr.gsol); CHKERRQ(ierr);
+
+				nskip = 0;
+
+				continue;
+			}
+		}
+
+		// monitor velocity change, activate skipping of Stokes solves
+		if(lm->jr.ctrl.stokesSkipMax)
+		{
+			if(nskip)
+			{
+				nskip--;
+			}
+			else
+			{
+				ierr = JacResGetVelChange(&lm->jr, gsol0, &chg); CHKERRQ(ierr);
+
+				if(chg < lm->jr.ctrl.stokesSkipTol) nskip = lm->jr.ctrl.stokesSkipMax;
+			}
+		}
+
 		// Compute adjoint gradients every TS
 		if (param)
 		{
@@ -754,11 +836,15 @@ PetscErrorCode LaMEMLibSolve(LaMEMLib *lm, void *param)
 
 	}
 
+	// print memory report (solver objects are still allocated)
+	ierr = JacResViewMemory(&lm->jr); CHKERRQ(ierr);
+
 	// destroy objects
 	ierr = PCStokesDestroy(pc);    			CHKERRQ(ierr);
 	ierr = PMatDestroy    (pm);    			CHKERRQ(ierr);
 	ierr = SNESDestroy    (&snes); 			CHKERRQ(ierr);
 	ierr = NLSolDestroy   (&nl);   			CHKERRQ(ierr);
+	ierr = VecDestroy     (&gsol0);			CHKERRQ(ierr);
 
 	// save marker database
 	ierr = ADVMarkSave(&lm->actx); CHKERRQ(ierr);
@@ -954,6 +1040,13 @@ PetscErrorCode LaMEMLibSolveTemp(LaMEMLib *lm, PetscScalar dt)
 	// create temperature diffusion solver
 	ierr = KSPCreate(PETSC_COMM_WORLD, &tksp); CHKERRQ(ierr);
 	ierr = KSPSetOptionsPrefix(tksp,"its_");   CHKERRQ(ierr);
+
+	if(jr->tmg)
+	{
+		// matrix-free operator with multigrid preconditioner
+		ierr = TMGSetPC(jr->tmg, tksp); CHKERRQ(ierr);
+	}
+
 	ierr = KSPSetFromOptions(tksp);            CHKERRQ(ierr);
 
 	// compute matrix and rhs
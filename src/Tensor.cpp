@@ -652,6 +652,63 @@ PetscErrorCode Tensor2RS2DSpectral(
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+void Tensor2RS2DSpectralBatch(
+	PetscInt     n,
+	PetscScalar *axx,
+	PetscScalar *ayy,
+	PetscScalar *axy,
+	PetscScalar *a1,
+	PetscScalar *a2,
+	PetscScalar *v1,
+	PetscScalar *v2,
+	PetscScalar  tol)
+{
+	// single Jacobi rotation (same as Tensor2RS2DSpectral) without branches,
+	// rotation is switched off by zero tangent, sorting is done by selection
+
+	PetscInt    ii;
+	PetscScalar xx, yy, xy, nrm, d, theta, t, c, s, tau;
+	PetscScalar l1, l2, e1x, e1y, e2x, e2y;
+	PetscBool   rot, swp;
+
+	for(ii = 0; ii < n; ii++)
+	{
+		xx = axx[ii];
+		yy = ayy[ii];
+		xy = axy[ii];
+
+		// get norm
+		nrm = PetscMax(fabs(xx) + fabs(xy), fabs(xy) + fabs(yy));
+
+		// get rotation
+		rot   = (PetscBool)(fabs(xy) > tol*nrm);
+		d     = rot ? xy : 1.0;
+		theta = 0.5*(yy - xx)/d;
+		t     = 1.0/(fabs(theta) + sqrt(theta*theta + 1.0));
+		t     = theta < 0.0 ? -t : t;
+		t     = rot ? t : 0.0;
+		c     = 1.0/sqrt(t*t + 1.0);
+		s     = t*c;
+		tau   = s/(1.0 + c);
+
+		// eigenvalues & eigenvectors
+		l1  = rot ? xx - t*xy : xx;
+		l2  = rot ? yy + t*xy : yy;
+		e1x = 1.0 - s*tau; e2x = s;
+		e1y = 0.0 - s;     e2y = 1.0 - s*tau;
+
+		// sort in descending order
+		swp = (PetscBool)(l2 > l1);
+
+		a1[ii]     = swp ? l2  : l1;
+		a2[ii]     = swp ? l1  : l2;
+		v1[2*ii  ] = swp ? e2x : e1x;
+		v1[2*ii+1] = swp ? e2y : e1y;
+		v2[2*ii  ] = swp ? e1x : e2x;
+		v2[2*ii+1] = swp ? e1y : e2y;
+	}
+}
+//---------------------------------------------------------------------------
 /*
 // ERROR HANDLING FOR CONTEXT EVALUATION ROUTINE
 
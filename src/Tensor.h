@@ -118,5 +118,19 @@ PetscErrorCode Tensor2RS2DSpectral(
 	PetscScalar  v2[],
 	PetscScalar  tol);
 
+// closed-form spectral decomposition of 2D symmetric tensors (arrays of length n)
+// eigenvalues are sorted in descending order, eigenvectors are stored as x,y pairs
+// results are identical to Tensor2RS2DSpectral
+void Tensor2RS2DSpectralBatch(
+	PetscInt     n,
+	PetscScalar *axx,
+	PetscScalar *ayy,
+	PetscScalar *axy,
+	PetscScalar *a1,
+	PetscScalar *a2,
+	PetscScalar *v1,
+	PetscScalar *v2,
+	PetscScalar  tol);
+
 //---------------------------------------------------------------------------
 #endif
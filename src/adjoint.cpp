@@ -96,6 +96,16 @@
 #include "constEq.h"
 #include "parsing.h"
 #include "gravity.h"
+#include "advect.h"
+#include "dike.h"
+#include "passive_tracer.h"
+#include "phase_transition.h"
+#include "paraViewOutBin.h"
+#include "paraViewOutSurf.h"
+#include "paraViewOutMark.h"
+#include "paraViewOutAVD.h"
+#include "paraViewOutPassiveTracers.h"
+#include "LaMEMLib.h"
 #include <petscsys.h> 
 //-----------------------------------------------------------------------------
 // A bit stupid that this has to be twice declared, but the original function is only in AVD.cpp and not in a header file anymore ...
@@ -429,6 +439,7 @@ PetscErrorCode LaMEMAdjointReadInputSetDefaults(ModParam *IOparam, Adjoint_Vecs
 	IOparam->ReferenceDensity 	= 0;
 	IOparam->SCF 				= 0; 	
 	IOparam->DII_ref 			= 0.0;	
+	IOparam->FD_InProcess 		= 0;
 	
     // Create scaling object
 	ierr = PetscMemzero (&scal, sizeof(Scaling)); CHKERRQ(ierr);
@@ -452,6 +463,7 @@ PetscErrorCode LaMEMAdjointReadInputSetDefaults(ModParam *IOparam, Adjoint_Vecs
 	ierr = getIntParam   (fb, _OPTIONAL_, "Adjoint_ObjectiveFunctionDef"     , &IOparam->OFdef,     		1, 1 ); CHKERRQ(ierr);  // Objective function defined by hand?
 	ierr = getIntParam   (fb, _OPTIONAL_, "Adjoint_PrintScalingLaws"     	 , &IOparam->ScalLaws,  		1, 1 ); CHKERRQ(ierr);  // Print scaling laws (combined with AdjointGradients)
 	ierr = getIntParam   (fb, _OPTIONAL_, "Adjoint_UseInitialAdjointParams"  , &IOparam->SetInitAdjParam,  	1, 1 ); CHKERRQ(ierr);  // Use InitialGuess specified in AdjointParamsStart/End as initial value?
+	ierr = getIntParam   (fb, _OPTIONAL_, "Adjoint_FD_InProcess"             , &IOparam->FD_InProcess,     	1, 1 ); CHKERRQ(ierr);  // Compute brute-force FD gradients in-process (reuse model & warm-start SNES)?
 	ierr = getStringParam(fb, _OPTIONAL_, "Adjoint_ScalingLawFilename"     	 , str,  "ScalingLaw.dat"  ); 		   CHKERRQ(ierr);  // Scaling law filename
 	ierr = getScalarParam(fb, _OPTIONAL_, "Adjoint_DII_ref"       			 , &IOparam->DII_ref,   1, 1        ); CHKERRQ(ierr);  // Reference strainrate needed for direct FD for pointwise kernels for powerlaw viscosity (very unflexible so far)
 	if (IOparam->DII_ref==0.0 && IOparam->FS)
@@ -497,6 +509,7 @@ PetscErrorCode LaMEMAdjointReadInputSetDefaults(ModParam *IOparam, Adjoint_Vecs
 		PetscPrintf(PETSC_COMM_WORLD, "|    Objective function type                  : %lld    \n", (LLD) IOparam->MfitType);
 		
 		PetscPrintf(PETSC_COMM_WORLD, "|    Objective function defined in input      : %lld    \n", (LLD) IOparam->OFdef);
+		PetscPrintf(PETSC_COMM_WORLD, "|    In-process finite difference gradients   : %lld    \n", (LLD) IOparam->FD_InProcess);
 		if ((IOparam->Gr==0) & (IOparam->ScalLaws==1) ){
 			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "| If you want scaling laws, you need to have Adjoint_GradientCalculation=Solution rather than CostFunction \n");
 		}
@@ -1118,6 +1131,9 @@ PetscErrorCode AdjointVectorsCreate(Adjoint_Vecs *Adjoint_Vectors, ModParam *IOp
 	ierr = VecDuplicate(Adjoint_Vectors->P,&IOparam->P);											CHKERRQ(ierr);
 	ierr = VecCreateMPI(PETSC_COMM_WORLD, IOparam->maxit, PETSC_DETERMINE, &IOparam->fcconv);  	 	CHKERRQ(ierr); 
 
+	// adjoint solution is created with the first adjoint solve (size of the solution vector)
+	IOparam->psi = NULL;
+
 
 	PetscFunctionReturn(0);
 }
@@ -1135,6 +1151,7 @@ PetscErrorCode AdjointVectorsDestroy(Adjoint_Vecs *Adjoint_Vectors, ModParam *IO
 
 	ierr = VecDestroy(&IOparam->P);					CHKERRQ(ierr);
 	ierr = VecDestroy(&IOparam->fcconv);			CHKERRQ(ierr);
+	ierr = VecDestroy(&IOparam->psi);				CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
@@ -1156,6 +1173,9 @@ PetscErrorCode AdjointCreate(AdjGrad *aop, JacRes *jr, ModParam *IOparam)
 	ierr = VecDuplicate(jr->gsol, &aop->pro);             CHKERRQ(ierr);
 	ierr = VecDuplicate(jr->gsol, &IOparam->xini);  	  CHKERRQ(ierr);  // create a new one
 
+	// adjoint solver is created with the first adjoint solve
+	aop->ksp = NULL;
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -1175,6 +1195,7 @@ PetscErrorCode AdjointDestroy(AdjGrad *aop, ModParam *IOparam)
 	ierr = VecDestroy(&aop->dF);         CHKERRQ(ierr);
 	ierr = VecDestroy(&aop->pro);        CHKERRQ(ierr);
 	ierr = VecDestroy(&IOparam->xini); 	 CHKERRQ(ierr); 
+	ierr = KSPDestroy(&aop->ksp);        CHKERRQ(ierr);
 
 	// Destroy the Adjoint gradients structures
 	// ierr = PetscMemzero(aop, sizeof(AdjGrad)); CHKERRQ(ierr);
@@ -1824,7 +1845,12 @@ PetscErrorCode AdjointFiniteDifferenceGradients(ModParam *IOparam)
 		}
 	}
 
-	if (FD_Adjoint){
+	if (FD_Adjoint && IOparam->FD_InProcess)
+	{
+		// keep a single initialized model & re-solve from an in-memory snapshot
+		ierr = AdjointFiniteDifferenceGradientsInProcess(IOparam, FD_gradients_eps); CHKERRQ(ierr);
+	}
+	else if (FD_Adjoint){
 
 		// Call LaMEM
 		ierr 		= 	LaMEMLibMain(IOparam); CHKERRQ(ierr);		// call LaMEM
@@ -1885,6 +1911,177 @@ PetscErrorCode AdjointFiniteDifferenceGradients(ModParam *IOparam)
  	PetscFunctionReturn(0);
  }
 
+//---------------------------------------------------------------------------
+/*
+	In-process finite difference computation of the gradient.
+	The model is initialized only once. The baseline state (solution vector & observation points)
+	is kept in memory, only the Material_t entry of the perturbed phase is replaced, and SNES is
+	warm-started from the converged reference solution for every perturbed parameter.
+	Restricted to single time step runs, since advection would otherwise modify the snapshot state.
+*/
+PetscErrorCode AdjointFiniteDifferenceGradientsInProcess(ModParam *IOparam, PetscScalar FD_gradients_eps)
+{
+	LaMEMLib        lm;
+	PMat            pm;
+	PCStokes        pc;
+	NLSol           nl;
+	AdjGrad         aop;
+	SNES            snes;
+	Vec             gsol_ref;
+	Material_t      phase_ref;
+	PetscInt 		j, CurPhase;
+	PetscScalar 	*Par, CurVal, Perturb, Misfit_ref, Misfit_pert, FD_eps, Grad;
+	PetscScalar     Ax[_MAX_OBS_], Ay[_MAX_OBS_], Az[_MAX_OBS_];
+	char 			CurName[_str_len_];
+
+	PetscErrorCode 	ierr;
+	PetscFunctionBeginUser;
+
+	//===========
+	// INITIALIZE
+	//===========
+
+	ierr = PetscMemzero(&lm, sizeof(LaMEMLib)); CHKERRQ(ierr);
+	ierr = LaMEMLibSetLinks(&lm);               CHKERRQ(ierr);
+	ierr = LaMEMLibCreate(&lm, IOparam);        CHKERRQ(ierr);
+
+	if(lm.ts.nstep_max > 1)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Adjoint_FD_InProcess requires a single time step (set nstep_max = 1)");
+	}
+
+	ierr = PMatCreate(&pm, &lm.jr);                CHKERRQ(ierr);
+	ierr = PCStokesCreate(&pc, pm);                CHKERRQ(ierr);
+	ierr = NLSolCreate(&nl, pc, &snes);            CHKERRQ(ierr);
+	ierr = LaMEMLibInitGuess(&lm, snes);           CHKERRQ(ierr);
+	ierr = AdjointCreate(&aop, &lm.jr, IOparam);   CHKERRQ(ierr);
+	ierr = VecDuplicate(lm.jr.gsol, &gsol_ref);    CHKERRQ(ierr);
+
+	// store observation points (can be advected by the objective function)
+	ierr = PetscMemcpy(Ax, IOparam->Ax, sizeof(Ax)); CHKERRQ(ierr);
+	ierr = PetscMemcpy(Ay, IOparam->Ay, sizeof(Ay)); CHKERRQ(ierr);
+	ierr = PetscMemcpy(Az, IOparam->Az, sizeof(Az)); CHKERRQ(ierr);
+
+	//================
+	// REFERENCE STATE
+	//================
+
+	ierr = Phase_Transition(&lm.actx);                             CHKERRQ(ierr);
+	ierr = AdjointFiniteDifferenceSolve(&lm, &aop, snes, IOparam); CHKERRQ(ierr);
+	ierr = VecCopy(lm.jr.gsol, gsol_ref);                          CHKERRQ(ierr);
+
+	Misfit_ref = IOparam->mfit;
+
+	PetscPrintf(PETSC_COMM_WORLD,"| ************************************************************************ \n");
+	PetscPrintf(PETSC_COMM_WORLD,"|                 FINITE DIFFERENCE GRADIENTS (IN-PROCESS)                 \n");
+	PetscPrintf(PETSC_COMM_WORLD,"| ************************************************************************ \n");
+	PetscPrintf(PETSC_COMM_WORLD,"| Reference objective function: %- 2.6e \n",Misfit_ref);
+
+	//===============
+	// PARAMETER LOOP
+	//===============
+
+	VecGetArray(IOparam->P,&Par);
+	for(j = 0; j < IOparam->mdN; j++)
+	{
+		if (!IOparam->FD_gradient[j]) continue;
+
+		CurPhase 		= 	IOparam->phs[j];
+		CurVal 	 		= 	Par[j];
+		FD_eps 			=	IOparam->FD_eps[j];
+		if (FD_eps==0.0)
+		{
+			FD_eps 		=	FD_gradients_eps;	// use default value
+		}
+		strcpy(CurName, IOparam->type_name[j]);	// name
+
+		Perturb 	= 	CurVal*FD_eps;
+
+		// create material database with the perturbed parameter
+		ierr = CopyParameterToLaMEMCommandLine(IOparam, CurVal + Perturb, j); CHKERRQ(ierr);
+		ierr = CreateModifiedMaterialDatabase(IOparam);                       CHKERRQ(ierr);
+
+		// replace material entry of the perturbed phase only
+		phase_ref                = lm.dbm.phases[CurPhase];
+		lm.dbm.phases[CurPhase]  = IOparam->dbm_modified.phases[CurPhase];
+
+		// restore baseline state, warm-start from the reference solution
+		ierr = PetscMemcpy(IOparam->Ax, Ax, sizeof(Ax)); CHKERRQ(ierr);
+		ierr = PetscMemcpy(IOparam->Ay, Ay, sizeof(Ay)); CHKERRQ(ierr);
+		ierr = PetscMemcpy(IOparam->Az, Az, sizeof(Az)); CHKERRQ(ierr);
+		ierr = VecCopy(gsol_ref, lm.jr.gsol);            CHKERRQ(ierr);
+
+		// compute solution with updated parameter
+		ierr = AdjointFiniteDifferenceSolve(&lm, &aop, snes, IOparam); CHKERRQ(ierr);
+
+		Misfit_pert = 	IOparam->mfit;
+
+		// FD gradient
+		Grad 			=	(Misfit_pert-Misfit_ref)/Perturb;
+		IOparam->grd[j] = 	Grad;
+
+		// set back parameter
+		lm.dbm.phases[CurPhase] = phase_ref;
+
+		ierr = CopyParameterToLaMEMCommandLine(IOparam, CurVal, j); CHKERRQ(ierr);
+
+		PetscPrintf(PETSC_COMM_WORLD,"|  Perturbed Misfit value     : %- 2.6e \n", Misfit_pert);
+		PetscPrintf(PETSC_COMM_WORLD,"|  Brute force FD gradient %5s[%2lld] = %e, with eps=%1.4e \n", CurName, (LLD) CurPhase, Grad, FD_eps);
+	}
+	VecRestoreArray(IOparam->P,&Par);
+
+	// reset values, just in case they are overwritten by a perturbed solve
+	IOparam->mfit = Misfit_ref;
+
+	ierr = PetscMemcpy(IOparam->Ax, Ax, sizeof(Ax)); CHKERRQ(ierr);
+	ierr = PetscMemcpy(IOparam->Ay, Ay, sizeof(Ay)); CHKERRQ(ierr);
+	ierr = PetscMemcpy(IOparam->Az, Az, sizeof(Az)); CHKERRQ(ierr);
+
+	//========
+	// CLEANUP
+	//========
+
+	ierr = VecDestroy(&gsol_ref);         CHKERRQ(ierr);
+	ierr = AdjointDestroy(&aop, IOparam); CHKERRQ(ierr);
+	ierr = PCStokesDestroy(pc);           CHKERRQ(ierr);
+	ierr = PMatDestroy(pm);               CHKERRQ(ierr);
+	ierr = SNESDestroy(&snes);            CHKERRQ(ierr);
+	ierr = NLSolDestroy(&nl);             CHKERRQ(ierr);
+	ierr = LaMEMLibDestroy(&lm);          CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode AdjointFiniteDifferenceSolve(LaMEMLib *lm, AdjGrad *aop, SNES snes, ModParam *IOparam)
+{
+	// solve the current time step starting from jr->gsol & evaluate the objective function
+
+	PetscLogDouble t;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// initialize boundary constraint vectors
+	ierr = BCApply(&lm->bc); CHKERRQ(ierr);
+
+	// initialize temperature
+	ierr = JacResInitTemp(&lm->jr); CHKERRQ(ierr);
+
+	// compute elastic parameters
+	ierr = JacResGetI2Gdt(&lm->jr); CHKERRQ(ierr);
+
+	// solve nonlinear equation system with SNES
+	PetscTime(&t);
+
+	ierr = SNESSolve(snes, NULL, lm->jr.gsol); CHKERRQ(ierr);
+
+	ierr = SNESPrintConvergedReason(snes, t); CHKERRQ(ierr);
+
+	// evaluate objective function
+	ierr = AdjointObjectiveFunction(aop, &lm->jr, IOparam, &lm->surf); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
 //---------------------------------------------------------------------------
 PetscErrorCode AdjointComputeGradients(JacRes *jr, AdjGrad *aop, NLSol *nl, SNES snes, ModParam *IOparam)
 {
@@ -1894,7 +2091,7 @@ PetscErrorCode AdjointComputeGradients(JacRes *jr, AdjGrad *aop, NLSol *nl, SNES
 
 	KSP                 ksp_as;
 	KSPConvergedReason  reason;
-	PetscInt            i, j;
+	PetscInt            i, j, its;
 	PetscScalar         grd, Perturb, *Par, CurVal;
 	Vec 				res_pert, sol, psi, psiPar, drdp, res;
 	PC                  ipc_as;
@@ -1923,33 +2120,49 @@ PetscErrorCode AdjointComputeGradients(JacRes *jr, AdjGrad *aop, NLSol *nl, SNES
 	//========
 	// Solve the adjoint equation (psi = J^-T * dF/dx)
 	// (A side note that I figured out, ksp still sometimes results in a > 0 gradient even if cost function is zero.. possibly really bad condition number?)
-	if(IOparam->MfitType == 0)
+	//
+	// The adjoint solver is preconditioned with the forward Stokes preconditioner (nl->P), which is
+	// already set up for the current operator by the last forward Jacobian evaluation.
+	// For a symmetric Jacobian the transpose of the preconditioner coincides with the preconditioner itself.
+	// The solve is warm-started from the adjoint solution of the previous optimization iteration.
+	if(!aop->ksp)
 	{
+		ierr = KSPCreate(PETSC_COMM_WORLD, &aop->ksp);            CHKERRQ(ierr);
+		ierr = KSPSetOptionsPrefix(aop->ksp,"as_");               CHKERRQ(ierr);
+		ierr = KSPSetFromOptions(aop->ksp);                       CHKERRQ(ierr);
+		ierr = KSPGetPC(aop->ksp, &ipc_as);                       CHKERRQ(ierr);
+		ierr = PCSetType(ipc_as, PCMAT);                          CHKERRQ(ierr);
+		ierr = KSPSetInitialGuessNonzero(aop->ksp, PETSC_TRUE);   CHKERRQ(ierr);
+	}
+	if(!IOparam->psi)
+	{
+		ierr = VecDuplicate(jr->gsol, &IOparam->psi);             CHKERRQ(ierr);
+		ierr = VecZeroEntries(IOparam->psi);                      CHKERRQ(ierr);
+	}
+	ksp_as = aop->ksp;
 
+	if(IOparam->MfitType == 0)
+	{
 		ierr = Adjoint_ApplyBCs(aop->dF, bc);			CHKERRQ(ierr);		// apply BC's to dF vector
-
-		ierr = SNESGetKSP(snes, &ksp_as);         		CHKERRQ(ierr);
-		ierr = KSPSetOptionsPrefix(ksp_as,"as_"); 		CHKERRQ(ierr);
-		ierr = KSPSetFromOptions(ksp_as);         		CHKERRQ(ierr);
-		ierr = KSPGetPC(ksp_as, &ipc_as);           	CHKERRQ(ierr);
-		ierr = PCSetType(ipc_as, PCMAT);          		CHKERRQ(ierr);
+		ierr = VecCopy(IOparam->psi, psi);				CHKERRQ(ierr);		// initial guess
 		ierr = KSPSetOperators(ksp_as,nl->J,nl->P);		CHKERRQ(ierr);
 		ierr = KSPSolve(ksp_as,aop->dF,psi);			CHKERRQ(ierr);
 		ierr = KSPGetConvergedReason(ksp_as,&reason);	CHKERRQ(ierr);
+		ierr = VecCopy(psi, IOparam->psi);				CHKERRQ(ierr);		// store for the next solve
 	}
 	else if(IOparam->MfitType == 1)
  	{
 		ierr = Adjoint_ApplyBCs(aop->dPardu, bc);		CHKERRQ(ierr);		// apply BC's to dF vector 
- 		ierr = SNESGetKSP(snes, &ksp_as);         		CHKERRQ(ierr);
- 		ierr = KSPSetOptionsPrefix(ksp_as,"as_"); 		CHKERRQ(ierr);
- 		ierr = KSPSetFromOptions(ksp_as);         		CHKERRQ(ierr);
- 		ierr = KSPGetPC(ksp_as, &ipc_as);            	CHKERRQ(ierr);
- 		ierr = PCSetType(ipc_as, PCMAT);          		CHKERRQ(ierr);
+		ierr = VecCopy(IOparam->psi, psiPar);			CHKERRQ(ierr);		// initial guess
  		ierr = KSPSetOperators(ksp_as,nl->J,nl->P);		CHKERRQ(ierr);
  		ierr = KSPSolve(ksp_as,aop->dPardu,psiPar);		CHKERRQ(ierr);
  		ierr = KSPGetConvergedReason(ksp_as,&reason);	CHKERRQ(ierr);
+		ierr = VecCopy(psiPar, IOparam->psi);			CHKERRQ(ierr);		// store for the next solve
  	}
 
+	ierr = KSPGetIterationNumber(ksp_as, &its);			CHKERRQ(ierr);
+	PetscPrintf(PETSC_COMM_WORLD,"|     Adjoint linear solve: %lld iterations, converged reason %lld \n", (LLD)its, (LLD)reason);
+
 	// Check error
 	{ 
 		PetscBool 	flag;
@@ -2262,7 +2475,7 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 {
 	PetscErrorCode      ierr;
 	FDSTAG              *fs;
-	Vec                 lproX, lproY, lproZ, gproX, gproY, gproZ, pro, xini, lxiniX, lxiniY, lxiniZ, gxiniX, gxiniY, gxiniZ;
+	Vec                 lbcor, lproX, lproY, lproZ, gproX, gproY, gproZ, pro, xini, lxiniX, lxiniY, lxiniZ, gxiniX, gxiniY, gxiniZ;
 	PetscScalar         coord_local[3], *temppro, ***llproX, ***llproY, ***llproZ, *dggproX, *dggproY, *dggproZ, *tempxini, ***llxiniX, ***llxiniY, ***llxiniZ, *dggxiniX, *dggxiniY, *dggxiniZ;
 	PetscScalar         *vx, *vy, *vz;
 	PetscScalar         f1,f2,f3,f4,f5,f6,f7,f8;
@@ -2542,6 +2755,9 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 	}
 	else if (IOparam->Ap == 3)     // take the topography velocity as comparison
 	{
+		// borrow corner buffer
+		ierr = DMGetLocalVector(fs->DA_COR, &lbcor); CHKERRQ(ierr);
+
 		for(ii = 0; ii < 3; ii++)
 		{
 			if (IOparam->Av[ii] == 1)
@@ -2560,13 +2776,13 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 				ierr = DMDAVecGetArray(fs->DA_X, lproX, &llproX);      CHKERRQ(ierr);
 				
 				// interpolate velocity component from grid faces to corners
-				ierr = InterpXFaceCorner(fs, jr->lvx, jr->lbcor, iflag); CHKERRQ(ierr);
+				ierr = InterpXFaceCorner(fs, jr->lvx, lbcor, iflag); CHKERRQ(ierr);
 			
 				// load ghost values
-				LOCAL_TO_LOCAL(fs->DA_COR, jr->lbcor)
+				LOCAL_TO_LOCAL(fs->DA_COR, lbcor)
 			
 				// access topograpy, grid and surface velocity
-				ierr = DMDAVecGetArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+				ierr = DMDAVecGetArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 			
@@ -2595,7 +2811,7 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 				END_PLANE_LOOP
 	
 				// restore access
-				ierr = DMDAVecRestoreArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+				ierr = DMDAVecRestoreArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(fs->DA_X, jr->lvx, &lvx); CHKERRQ(ierr);
@@ -2618,13 +2834,13 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 				ierr = DMDAVecGetArray(fs->DA_Y, lproY, &llproY);      CHKERRQ(ierr);
 				
 				// interpolate velocity component from grid faces to corners
-				ierr = InterpYFaceCorner(fs, jr->lvy, jr->lbcor, iflag); CHKERRQ(ierr);
+				ierr = InterpYFaceCorner(fs, jr->lvy, lbcor, iflag); CHKERRQ(ierr);
 			
 				// load ghost values
-				LOCAL_TO_LOCAL(fs->DA_COR, jr->lbcor)
+				LOCAL_TO_LOCAL(fs->DA_COR, lbcor)
 			
 				// access topograpy, grid and surface velocity
-				ierr = DMDAVecGetArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+				ierr = DMDAVecGetArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 			
@@ -2652,7 +2868,7 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 				END_PLANE_LOOP
 	
 				// restore access
-				ierr = DMDAVecRestoreArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+				ierr = DMDAVecRestoreArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(fs->DA_Y, jr->lvy, &lvy); CHKERRQ(ierr);
@@ -2674,13 +2890,13 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 				ierr = DMDAVecGetArray(fs->DA_Z, lproZ, &llproZ);      CHKERRQ(ierr);
 				
 				// interpolate velocity component from grid faces to corners
-				ierr = InterpZFaceCorner(fs, jr->lvz, jr->lbcor, iflag); CHKERRQ(ierr);
+				ierr = InterpZFaceCorner(fs, jr->lvz, lbcor, iflag); CHKERRQ(ierr);
 			
 				// load ghost values
-				LOCAL_TO_LOCAL(fs->DA_COR, jr->lbcor)
+				LOCAL_TO_LOCAL(fs->DA_COR, lbcor)
 			
 				// access topograpy, grid and surface velocity
-				ierr = DMDAVecGetArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+				ierr = DMDAVecGetArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 			
@@ -2708,14 +2924,16 @@ PetscErrorCode AdjointPointInPro(JacRes *jr, AdjGrad *aop, ModParam *IOparam, Fr
 				END_PLANE_LOOP
 	
 				// restore access
-				ierr = DMDAVecRestoreArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+				ierr = DMDAVecRestoreArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 				ierr = DMDAVecGetArray(fs->DA_Z, jr->lvz, &lvz); CHKERRQ(ierr);
 				ierr = DMDAVecRestoreArray(fs->DA_Z, lproZ, &llproZ);            CHKERRQ(ierr);
 			}
 		}
-		
+
+		// return corner buffer
+		ierr = DMRestoreLocalVector(fs->DA_COR, &lbcor); CHKERRQ(ierr);
 	}
 
 	LOCAL_TO_GLOBAL(fs->DA_X, lproX, gproX);
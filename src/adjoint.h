@@ -36,6 +36,7 @@ struct FB;
 struct ConstEqCtx;
 struct SolVarCell;
 struct SolVarEdge;
+struct LaMEMLib;
 
 #include "phase.h"
 #include "bc.h"
@@ -54,6 +55,7 @@ struct AdjGrad
 	Vec 			 pro;
 	Vec              vx, vy, vz, sty;
 	Vec              gradfield;                // Used if gradient at every point is computed (same size as jr->p)
+	KSP              ksp;                      // adjoint linear solver (preconditioned with the forward Stokes preconditioner)
 };
 
 // Structure that holds vectors required by TAO
@@ -91,6 +93,8 @@ PetscErrorCode Adjoint_ApplyBCs(Vec dF, BCCtx* bc);
 
 // 'Brute-force' finite difference gradients
 PetscErrorCode AdjointFiniteDifferenceGradients(ModParam *IOparam);				
+PetscErrorCode AdjointFiniteDifferenceGradientsInProcess(ModParam *IOparam, PetscScalar FD_gradients_eps);
+PetscErrorCode AdjointFiniteDifferenceSolve(LaMEMLib *lm, AdjGrad *aop, SNES snes, ModParam *IOparam);
 PetscErrorCode PrintGradientsAndObservationPoints(ModParam *IOparam);
 PetscErrorCode PrintCostFunction(ModParam *IOparam);
 
@@ -71,6 +71,48 @@ PetscErrorCode MarkerMerge(Marker &A, Marker &B, Marker &C)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+void MarkerPackStore(Marker &A, MarkerPack &C)
+{
+	C.X[0]  = A.X[0];
+	C.X[1]  = A.X[1];
+	C.X[2]  = A.X[2];
+	C.p     = (float)A.p;
+	C.T     = (float)A.T;
+	C.APS   = (float)A.APS;
+	C.ATS   = (float)A.ATS;
+	C.S[0]  = (float)A.S.xx;
+	C.S[1]  = (float)A.S.xy;
+	C.S[2]  = (float)A.S.xz;
+	C.S[3]  = (float)A.S.yy;
+	C.S[4]  = (float)A.S.yz;
+	C.S[5]  = (float)A.S.zz;
+	C.U[0]  = (float)A.U[0];
+	C.U[1]  = (float)A.U[1];
+	C.U[2]  = (float)A.U[2];
+	C.phase = (short)A.phase;
+}
+//---------------------------------------------------------------------------
+void MarkerPackLoad(MarkerPack &C, Marker &A)
+{
+	A.X[0]  = C.X[0];
+	A.X[1]  = C.X[1];
+	A.X[2]  = C.X[2];
+	A.p     = (PetscScalar)C.p;
+	A.T     = (PetscScalar)C.T;
+	A.APS   = (PetscScalar)C.APS;
+	A.ATS   = (PetscScalar)C.ATS;
+	A.S.xx  = (PetscScalar)C.S[0];
+	A.S.xy  = (PetscScalar)C.S[1];
+	A.S.xz  = (PetscScalar)C.S[2];
+	A.S.yy  = (PetscScalar)C.S[3];
+	A.S.yz  = (PetscScalar)C.S[4];
+	A.S.zz  = (PetscScalar)C.S[5];
+	A.U[0]  = (PetscScalar)C.U[0];
+	A.U[1]  = (PetscScalar)C.U[1];
+	A.U[2]  = (PetscScalar)C.U[2];
+	A.phase = (PetscInt)C.phase;
+}
+//---------------------------------------------------------------------------
 PetscErrorCode ADVCreate(AdvCtx *actx, FB *fb)
 {
 	// create advection context
@@ -96,6 +138,7 @@ PetscErrorCode ADVCreate(AdvCtx *actx, FB *fb)
 	actx->bgPhase  = -1;
 	actx->A        =  2.0/3.0;
 	actx->npmax    =  1;
+	actx->velHalo  =  1;
 	maxPhaseID     = actx->dbm->numPhases-1;
 
 	// READ
@@ -112,6 +155,8 @@ PetscErrorCode ADVCreate(AdvCtx *actx, FB *fb)
 	ierr = getStringParam(fb, _OPTIONAL_, "mark_save_file",  actx->saveFile, "./markers/mdb"); CHKERRQ(ierr);
 	ierr = getStringParam(fb, _OPTIONAL_, "interp",          interp,         "stag");          CHKERRQ(ierr);
 	ierr = getScalarParam(fb, _OPTIONAL_, "stagp_a",        &actx->A,        1, 1.0);          CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "adv_halo",       &actx->velHalo,  1, 1);            CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "mark_compact",   &actx->compact,  1, 1);            CHKERRQ(ierr);
 	ierr = getStringParam(fb, _OPTIONAL_, "mark_ctrl",       mctrl,          "none");          CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "nmark_lim",       nmark_lim,      2, 0);            CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "nmark_avd",       nmark_avd,      3, 0);            CHKERRQ(ierr);
@@ -168,6 +213,9 @@ PetscErrorCode ADVCreate(AdvCtx *actx, FB *fb)
 	}
 
 	if(actx->interp != STAG_P)  actx->A       = 0.0;
+
+	// wide-halo advection only supports stag interpolation
+	if(actx->advect == BASIC_EULER || actx->interp != STAG) actx->velHalo = 0;
 	if(actx->msetup != _GEOM_)  actx->bgPhase = -1;
 
 	if(actx->mctrl != CTRL_NONE)
@@ -221,6 +269,8 @@ PetscErrorCode ADVCreate(AdvCtx *actx, FB *fb)
 	if(actx->saveMark)      PetscPrintf(PETSC_COMM_WORLD,"   Marker storage file           : %s \n", actx->saveFile);
 	if(actx->bgPhase != -1) PetscPrintf(PETSC_COMM_WORLD,"   Background phase ID           : %lld \n", (LLD)actx->bgPhase);
 	if(actx->A)             PetscPrintf(PETSC_COMM_WORLD,"   Interpolation constant        : %g \n", actx->A);
+	if(actx->velHalo)       PetscPrintf(PETSC_COMM_WORLD,"   Wide-halo velocity interp.    @ \n");
+	if(actx->compact)       PetscPrintf(PETSC_COMM_WORLD,"   Compact marker restart files  @ \n");
 
 	PetscPrintf(PETSC_COMM_WORLD,"--------------------------------------------------------------------------\n");
 
@@ -271,6 +321,7 @@ PetscErrorCode ADVSetType(AdvCtx *actx, FB *fb)
 	else if(!strcmp(advect, "basic"))    actx->advect = BASIC_EULER;
 	else if(!strcmp(advect, "euler"))    actx->advect = EULER;
 	else if(!strcmp(advect, "rk2"))      actx->advect = RUNGE_KUTTA_2;
+	else if(!strcmp(advect, "rk4"))      actx->advect = RUNGE_KUTTA_4;
 	else SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Incorrect advection type (advect): %s", advect);
 
 	PetscPrintf(PETSC_COMM_WORLD, "Advection parameters:\n");
@@ -281,8 +332,9 @@ PetscErrorCode ADVSetType(AdvCtx *actx, FB *fb)
  	if     (actx->advect == BASIC_EULER)   PetscPrintf(PETSC_COMM_WORLD, "Euler 1-st order (basic implementation)\n");
 	else if(actx->advect == EULER)         PetscPrintf(PETSC_COMM_WORLD, "Euler 1-st order\n");
 	else if(actx->advect == RUNGE_KUTTA_2) PetscPrintf(PETSC_COMM_WORLD, "Runge-Kutta 2-nd order\n");
+	else if(actx->advect == RUNGE_KUTTA_4) PetscPrintf(PETSC_COMM_WORLD, "Runge-Kutta 4-th order\n");
 
- 	if((fs->dsx.periodic || fs->dsy.periodic || fs->dsz.periodic) && (actx->advect == EULER || actx->advect == RUNGE_KUTTA_2))
+ 	if((fs->dsx.periodic || fs->dsy.periodic || fs->dsz.periodic) && (actx->advect == EULER || actx->advect == RUNGE_KUTTA_2 || actx->advect == RUNGE_KUTTA_4))
  	{
 		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Periodic marker advection is only compatible with BASIC_EULER (advect, periodic_x,y,z)");
  	}
@@ -335,7 +387,14 @@ PetscErrorCode ADVReadRestart(AdvCtx *actx, FILE *fp)
 	ierr = makeIntArray(&actx->markind, NULL, actx->markcap); CHKERRQ(ierr);
 
 	// read markers from disk
-	fread(actx->markers, (size_t)actx->nummark*sizeof(Marker), 1, fp);
+	if(actx->compact)
+	{
+		ierr = ADVReadCompact(actx, fp); CHKERRQ(ierr);
+	}
+	else
+	{
+		fread(actx->markers, (size_t)actx->nummark*sizeof(Marker), 1, fp);
+	}
 
 	// create communicator and separator
 	ierr = ADVCreateData(actx); CHKERRQ(ierr);
@@ -351,13 +410,73 @@ PetscErrorCode ADVReadRestart(AdvCtx *actx, FILE *fp)
 //---------------------------------------------------------------------------
 PetscErrorCode ADVWriteRestart(AdvCtx *actx, FILE *fp)
 {
+	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
 
 	// check activation
  	if(actx->advect == ADV_NONE) PetscFunctionReturn(0);
 
 	// store local markers to disk
-	fwrite(actx->markers, (size_t)actx->nummark*sizeof(Marker), 1, fp);
+	if(actx->compact)
+	{
+		ierr = ADVWriteCompact(actx, fp); CHKERRQ(ierr);
+	}
+	else
+	{
+		fwrite(actx->markers, (size_t)actx->nummark*sizeof(Marker), 1, fp);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVReadCompact(AdvCtx *actx, FILE *fp)
+{
+	// read compact marker records (chunk by chunk)
+
+	MarkerPack *pack;
+	PetscInt    i, n, s;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = PetscMalloc((size_t)_mark_chunk_*sizeof(MarkerPack), &pack); CHKERRQ(ierr);
+
+	for(s = 0; s < actx->nummark; s += _mark_chunk_)
+	{
+		n = PetscMin(_mark_chunk_, actx->nummark - s);
+
+		fread(pack, (size_t)n*sizeof(MarkerPack), 1, fp);
+
+		for(i = 0; i < n; i++) MarkerPackLoad(pack[i], actx->markers[s+i]);
+	}
+
+	ierr = PetscFree(pack); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVWriteCompact(AdvCtx *actx, FILE *fp)
+{
+	// write compact marker records (chunk by chunk)
+
+	MarkerPack *pack;
+	PetscInt    i, n, s;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = PetscMalloc((size_t)_mark_chunk_*sizeof(MarkerPack), &pack); CHKERRQ(ierr);
+
+	for(s = 0; s < actx->nummark; s += _mark_chunk_)
+	{
+		n = PetscMin(_mark_chunk_, actx->nummark - s);
+
+		for(i = 0; i < n; i++) MarkerPackStore(actx->markers[s+i], pack[i]);
+
+		fwrite(pack, (size_t)n*sizeof(MarkerPack), 1, fp);
+	}
+
+	ierr = PetscFree(pack); CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
@@ -387,6 +506,9 @@ PetscErrorCode ADVCreateData(AdvCtx *actx)
 	// allocate memory for marker index array separators
 	ierr = makeIntArray(&actx->markstart, NULL, fs->nCells + 1); CHKERRQ(ierr);
 
+	// wide-halo velocity context is created on first use
+	actx->vh = NULL;
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -408,6 +530,7 @@ PetscErrorCode ADVDestroy(AdvCtx *actx)
 	ierr = PetscFree(actx->sendbuf);    CHKERRQ(ierr);
 	ierr = PetscFree(actx->recvbuf);    CHKERRQ(ierr);
 	ierr = PetscFree(actx->idel);       CHKERRQ(ierr);
+	ierr = ADVelHaloDestroy(actx);      CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
@@ -446,13 +569,11 @@ PetscErrorCode ADVSetBGPhase(AdvCtx *actx)
 //---------------------------------------------------------------------------
 PetscErrorCode ADVReAllocStorage(AdvCtx *actx, PetscInt nummark)
 {
-	// WARNING! This is a very crappy approach. Make sure the overhead is
-	// large enough to prevent memory reallocations. Do marker management
-	// before reallocating, or implement different memory model (e.g. paging,
-	// or fixed maximum number markers per cell + deleting excessive markers.
-	// The latter has an advantage of maintaining memory locality).
-
-	Marker *markers;
+	// Marker storage is a single contiguous array, its capacity is rounded up
+	// to a multiple of _mark_chunk_, and includes overhead to absorb injected &
+	// received markers. Storage is resized with PetscRealloc, which may avoid
+	// copying markers and doubling the peak memory if the allocator can extend
+	// the block in place (not guaranteed, e.g. with PETSc debug malloc).
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -460,29 +581,70 @@ PetscErrorCode ADVReAllocStorage(AdvCtx *actx, PetscInt nummark)
 	// check whether current storage is insufficient
 	if(nummark > actx->markcap)
 	{
-		// update capacity
-		actx->markcap = (PetscInt)(_cap_overhead_*(PetscScalar)nummark);
+		ierr = ADVResizeStorage(actx, ADVGetStorageCapacity(nummark)); CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscInt ADVGetStorageCapacity(PetscInt nummark)
+{
+	// get storage capacity with overhead (rounded up to whole chunks)
 
-		// reallocate memory for host cell and marker-in-cell indices
-		ierr = PetscFree(actx->cellnum); CHKERRQ(ierr);
-		ierr = PetscFree(actx->markind); CHKERRQ(ierr);
+	PetscInt markcap;
 
-		ierr = makeIntArray(&actx->cellnum, NULL, actx->markcap); CHKERRQ(ierr);
-		ierr = makeIntArray(&actx->markind, NULL, actx->markcap); CHKERRQ(ierr);
+	markcap = (PetscInt)(_cap_overhead_*(PetscScalar)nummark);
 
-		// reallocate memory for markers
-		ierr = PetscMalloc((size_t)actx->markcap*sizeof(Marker), &markers); CHKERRQ(ierr);
-		ierr = PetscMemzero(markers, (size_t)actx->markcap*sizeof(Marker)); CHKERRQ(ierr);
+	return (markcap/_mark_chunk_ + 1)*_mark_chunk_;
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVResizeStorage(AdvCtx *actx, PetscInt markcap)
+{
+	// change marker storage capacity (number of markers must fit)
 
-		// copy current data
-		if(actx->nummark)
-		{
-			ierr = PetscMemcpy(markers, actx->markers, (size_t)actx->nummark*sizeof(Marker)); CHKERRQ(ierr);
-		}
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
 
-		// update marker storage
-		ierr = PetscFree(actx->markers); CHKERRQ(ierr);
-		actx->markers = markers;
+	if(markcap < actx->nummark)
+	{
+		SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Marker storage capacity is smaller than number of markers");
+	}
+
+	// delete host cell and marker-in-cell indices before resizing
+	// (recomputed after every change of marker storage)
+	ierr = PetscFree(actx->cellnum); CHKERRQ(ierr);
+	ierr = PetscFree(actx->markind); CHKERRQ(ierr);
+
+	// resize marker storage (in place if the allocator permits)
+	ierr = PetscRealloc((size_t)markcap*sizeof(Marker), &actx->markers); CHKERRQ(ierr);
+
+	// clear new chunks only
+	if(markcap > actx->markcap)
+	{
+		ierr = PetscMemzero(actx->markers + actx->markcap, (size_t)(markcap - actx->markcap)*sizeof(Marker)); CHKERRQ(ierr);
+	}
+
+	// update capacity
+	actx->markcap = markcap;
+
+	// allocate memory for host cell and marker-in-cell indices
+	ierr = makeIntArray(&actx->cellnum, NULL, actx->markcap); CHKERRQ(ierr);
+	ierr = makeIntArray(&actx->markind, NULL, actx->markcap); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVShrinkStorage(AdvCtx *actx)
+{
+	// release unused storage lazily, i.e. only if capacity exceeds
+	// the growth overhead twice (prevents oscillating reallocations)
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(_cap_overhead_*_cap_overhead_*(PetscScalar)actx->nummark < (PetscScalar)(actx->markcap - _mark_chunk_))
+	{
+		ierr = ADVResizeStorage(actx, ADVGetStorageCapacity(actx->nummark)); CHKERRQ(ierr);
 	}
 
 	PetscFunctionReturn(0);
@@ -663,6 +825,7 @@ PetscErrorCode ADVInterpFieldToMark(AdvCtx *actx, InterpCase icase)
 	PetscScalar  UPXX, UPYY, UPZZ, UPXY, UPXZ, UPYZ;
 	PetscInt     nx, ny, sx, sy, sz;
 	PetscInt     jj, ID, I, J, K, II, JJ, KK;
+	Vec          gbxy, gbxz, gbyz;
 	PetscScalar *gxy, *gxz, *gyz, ***lxy, ***lxz, ***lyz;
 
 	PetscScalar  xc, yc, zc, xp, yp, zp, wx, wy, wz, d, dt;
@@ -691,10 +854,15 @@ PetscErrorCode ADVInterpFieldToMark(AdvCtx *actx, InterpCase icase)
 	}
 	else
 	{
+		// borrow global buffers
+		ierr = DMGetGlobalVector(fs->DA_XY, &gbxy); CHKERRQ(ierr);
+		ierr = DMGetGlobalVector(fs->DA_XZ, &gbxz); CHKERRQ(ierr);
+		ierr = DMGetGlobalVector(fs->DA_YZ, &gbyz); CHKERRQ(ierr);
+
 		// access 1D layouts of global vectors
-		ierr = VecGetArray(jr->gdxy, &gxy);  CHKERRQ(ierr);
-		ierr = VecGetArray(jr->gdxz, &gxz);  CHKERRQ(ierr);
-		ierr = VecGetArray(jr->gdyz, &gyz);  CHKERRQ(ierr);
+		ierr = VecGetArray(gbxy, &gxy);  CHKERRQ(ierr);
+		ierr = VecGetArray(gbxz, &gxz);  CHKERRQ(ierr);
+		ierr = VecGetArray(gbyz, &gyz);  CHKERRQ(ierr);
 
 		if(icase == _STRESS_)
 		{
@@ -716,14 +884,19 @@ PetscErrorCode ADVInterpFieldToMark(AdvCtx *actx, InterpCase icase)
 		}
 
 		// restore access
-		ierr = VecRestoreArray(jr->gdxy, &gxy); CHKERRQ(ierr);
-		ierr = VecRestoreArray(jr->gdxz, &gxz); CHKERRQ(ierr);
-		ierr = VecRestoreArray(jr->gdyz, &gyz); CHKERRQ(ierr);
+		ierr = VecRestoreArray(gbxy, &gxy); CHKERRQ(ierr);
+		ierr = VecRestoreArray(gbxz, &gxz); CHKERRQ(ierr);
+		ierr = VecRestoreArray(gbyz, &gyz); CHKERRQ(ierr);
 
 		// communicate boundary values
-		GLOBAL_TO_LOCAL(fs->DA_XY, jr->gdxy, jr->ldxy);
-		GLOBAL_TO_LOCAL(fs->DA_XZ, jr->gdxz, jr->ldxz);
-		GLOBAL_TO_LOCAL(fs->DA_YZ, jr->gdyz, jr->ldyz);
+		GLOBAL_TO_LOCAL(fs->DA_XY, gbxy, jr->ldxy);
+		GLOBAL_TO_LOCAL(fs->DA_XZ, gbxz, jr->ldxz);
+		GLOBAL_TO_LOCAL(fs->DA_YZ, gbyz, jr->ldyz);
+
+		// return global buffers
+		ierr = DMRestoreGlobalVector(fs->DA_XY, &gbxy); CHKERRQ(ierr);
+		ierr = DMRestoreGlobalVector(fs->DA_XZ, &gbxz); CHKERRQ(ierr);
+		ierr = DMRestoreGlobalVector(fs->DA_YZ, &gbyz); CHKERRQ(ierr);
 
 	}
 
@@ -838,17 +1011,21 @@ PetscErrorCode ADVAdvectMark(AdvCtx *actx)
 	// update marker positions from current velocities & time step
 	// WARNING! Forward Euler Explicit algorithm
 	// (need to implement more accurate schemes)
+	// markers are processed by host cells in blocks (see VelStencil)
 
 	FDSTAG      *fs;
 	JacRes      *jr;
 	Marker      *P;
 	SolVarCell  *svCell;
+	VelStencil   st;
 	PetscInt    sx, sy, sz, nx, ny;
-	PetscInt    jj, ID, I, J, K, II, JJ, KK, AirPhase;
+	PetscInt    i, ib, nb, n, ID, I, J, K, AirPhase, *ind;
 	PetscScalar *ncx, *ncy, *ncz;
 	PetscScalar *ccx, *ccy, *ccz;
 	PetscScalar ***lvx, ***lvy, ***lvz, ***lp, ***lT;
-	PetscScalar vx, vy, vz, xc, yc, zc, xp, yp, zp, dt, Ttop;
+	PetscScalar vx, vy, vz, dp, dT, dt, Ttop;
+	PetscScalar xb[_map_block_], yb[_map_block_], zb[_map_block_];
+	PetscScalar ub[_map_block_], vb[_map_block_], wb[_map_block_];
 
 	AirPhase = -1;
 	Ttop     =  0.0;
@@ -886,57 +1063,73 @@ PetscErrorCode ADVAdvectMark(AdvCtx *actx)
 	ierr = DMDAVecGetArray(fs->DA_CEN, jr->lp,  &lp);  CHKERRQ(ierr);
 	ierr = DMDAVecGetArray(fs->DA_CEN, jr->lT,  &lT);  CHKERRQ(ierr);
 
-	// scan all markers
-	for(jj = 0; jj < actx->nummark; jj++)
+	// scan all cells
+	for(ID = 0; ID < fs->nCells; ID++)
 	{
-		// access next marker
-		P = &actx->markers[jj];
+		// get number of markers in the cell
+		n = actx->markstart[ID+1] - actx->markstart[ID];
 
-		// get consecutive index of the host cell
-		ID = actx->cellnum[jj];
+		if(!n) continue;
 
 		// expand I, J, K cell indices
 		GET_CELL_IJK(ID, I, J, K, nx, ny)
 
-		// get marker coordinates
-		xp = P->X[0];
-		yp = P->X[1];
-		zp = P->X[2];
+		// load velocity stencil of the cell
+		VelStencilLoad(&st, lvx, lvy, lvz, I, J, K, sx, sy, sz, ncx, ncy, ncz, ccx, ccy, ccz);
 
-		// get coordinates of cell center
-		xc = ccx[I];
-		yc = ccy[J];
-		zc = ccz[K];
+		// access host cell solution variables
+		svCell = &jr->svCell[ID];
 
-		// map marker on the cells of X, Y, Z & center grids
-		if(xp > xc) { II = I; } else { II = I-1; }
-		if(yp > yc) { JJ = J; } else { JJ = J-1; }
-		if(zp > zc) { KK = K; } else { KK = K-1; }
+		// get pressure & temperature increments
+		dp = lp[sz+K][sy+J][sx+I] - svCell->svBulk.pn;
+		dT = lT[sz+K][sy+J][sx+I] - svCell->svBulk.Tn;
 
-		// interpolate velocity, pressure & temperature
-		vx = InterpLin3D(lvx, I,  JJ, KK, sx, sy, sz, xp, yp, zp, ncx, ccy, ccz);
-		vy = InterpLin3D(lvy, II, J,  KK, sx, sy, sz, xp, yp, zp, ccx, ncy, ccz);
-		vz = InterpLin3D(lvz, II, JJ, K,  sx, sy, sz, xp, yp, zp, ccx, ccy, ncz);
+		// process markers of the cell in blocks
+		ind = actx->markind + actx->markstart[ID];
 
-		// access host cell solution variables
-		svCell = &jr->svCell[ID];
+		for(ib = 0; ib < n; ib += _map_block_)
+		{
+			nb = PetscMin(_map_block_, n - ib);
+
+			// gather marker coordinates
+			for(i = 0; i < nb; i++)
+			{
+				P     = &actx->markers[ind[ib+i]];
+				xb[i] = P->X[0];
+				yb[i] = P->X[1];
+				zb[i] = P->X[2];
+			}
+
+			// interpolate velocity
+			VelStencilInterp(&st, nb, xb, yb, zb, ub, vb, wb);
+
+			for(i = 0; i < nb; i++)
+			{
+				// access next marker
+				P = &actx->markers[ind[ib+i]];
 
-		// update pressure & temperature variables
-		P->p += lp[sz+K][sy+J][sx+I]  	- 	svCell->svBulk.pn;
-		P->T += lT[sz+K][sy+J][sx+I] 	-	svCell->svBulk.Tn;
+				vx = ub[i];
+				vy = vb[i];
+				vz = wb[i];
 
-		// override temperature of air phase
-		if(AirPhase != -1 && P->phase == AirPhase) P->T = Ttop;
+				// update pressure & temperature variables
+				P->p += dp;
+				P->T += dT;
 
-		// advect marker
-		P->X[0] = xp + vx*dt;
-		P->X[1] = yp + vy*dt;
-		P->X[2] = zp + vz*dt;
+				// override temperature of air phase
+				if(AirPhase != -1 && P->phase == AirPhase) P->T = Ttop;
 
-		// update displacement
-		P->U[0] += vx*dt;
-		P->U[1] += vy*dt;
-		P->U[2] += vz*dt;
+				// advect marker
+				P->X[0] = xb[i] + vx*dt;
+				P->X[1] = yb[i] + vy*dt;
+				P->X[2] = zb[i] + vz*dt;
+
+				// update displacement
+				P->U[0] += vx*dt;
+				P->U[1] += vy*dt;
+				P->U[2] += vz*dt;
+			}
+		}
 	}
 
 	// restore access
@@ -1280,6 +1473,9 @@ PetscErrorCode ADVCollectGarbage(AdvCtx *actx)
 	// store new number of markers
 	actx->nummark = nummark;
 
+	// release unused storage
+	ierr = ADVShrinkStorage(actx); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //-----------------------------------------------------------------------------
@@ -1289,8 +1485,10 @@ PetscErrorCode ADVMapMarkToCells(AdvCtx *actx)
 	// NOTE: this routine MUST be called for the local markers only
 
 	FDSTAG      *fs;
-	PetscScalar *X;
-	PetscInt     i, ID, I, J, K, M, N, nummark;
+	PetscScalar *X, xb[_map_block_], yb[_map_block_], zb[_map_block_];
+	PetscInt     Ib[_map_block_], Jb[_map_block_], Kb[_map_block_];
+	PetscInt    *binx, *biny, *binz, nbinx, nbiny, nbinz;
+	PetscInt     i, ib, nb, ID, M, N, nummark;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -1300,28 +1498,48 @@ PetscErrorCode ADVMapMarkToCells(AdvCtx *actx)
 	M  = fs->dsx.ncels;
 	N  = fs->dsy.ncels;
 
-	// loop over all local particles
-	for(i = 0; i < actx->nummark; i++)
+	// setup lookup tables for non-uniform directions
+	ierr = Discret1DGetBins(&fs->dsx, &binx, &nbinx); CHKERRQ(ierr);
+	ierr = Discret1DGetBins(&fs->dsy, &biny, &nbiny); CHKERRQ(ierr);
+	ierr = Discret1DGetBins(&fs->dsz, &binz, &nbinz); CHKERRQ(ierr);
+
+	// loop over all local particles in blocks
+	for(ib = 0; ib < actx->nummark; ib += _map_block_)
 	{
-		// get marker coordinates
-		X = actx->markers[i].X;
+		nb = PetscMin(_map_block_, actx->nummark - ib);
 
-		// get host cell IDs in all directions
-		ierr = Discret1DFindPoint(&fs->dsx, X[0], I); CHKERRQ(ierr);
-		ierr = Discret1DFindPoint(&fs->dsy, X[1], J); CHKERRQ(ierr);
-		ierr = Discret1DFindPoint(&fs->dsz, X[2], K); CHKERRQ(ierr);
+		// gather marker coordinates
+		for(i = 0; i < nb; i++)
+		{
+			X     = actx->markers[ib+i].X;
+			xb[i] = X[0];
+			yb[i] = X[1];
+			zb[i] = X[2];
+		}
 
-		// compute and store consecutive index
-		GET_CELL_ID(ID, I, J, K, M, N);
+		// get host cell IDs in all directions
+		ierr = Discret1DFindPoints(&fs->dsx, nb, xb, Ib, binx, nbinx); CHKERRQ(ierr);
+		ierr = Discret1DFindPoints(&fs->dsy, nb, yb, Jb, biny, nbiny); CHKERRQ(ierr);
+		ierr = Discret1DFindPoints(&fs->dsz, nb, zb, Kb, binz, nbinz); CHKERRQ(ierr);
 
-		if(ID < 0 || ID > fs->nCells-1)
+		for(i = 0; i < nb; i++)
 		{
-			SETERRQ(PETSC_COMM_SELF, PETSC_ERR_USER, "Wrong marker-to-cell-mapping (cell ID)");
-		}
+			// compute and store consecutive index
+			GET_CELL_ID(ID, Ib[i], Jb[i], Kb[i], M, N);
+
+			if(ID < 0 || ID > fs->nCells-1)
+			{
+				SETERRQ(PETSC_COMM_SELF, PETSC_ERR_USER, "Wrong marker-to-cell-mapping (cell ID)");
+			}
 
-		actx->cellnum[i] = ID;
+			actx->cellnum[ib+i] = ID;
+		}
 	}
 
+	ierr = PetscFree(binx); CHKERRQ(ierr);
+	ierr = PetscFree(biny); CHKERRQ(ierr);
+	ierr = PetscFree(binz); CHKERRQ(ierr);
+
 	// count number of markers per cell
 	ierr = clearIntArray(actx->markstart, fs->nCells+1); CHKERRQ(ierr);
 
@@ -1748,31 +1966,41 @@ PetscErrorCode ADVProjHistMarkToGrid(AdvCtx *actx)
 	// EDGES
 	//======
 
-	// NOTE: edge phase ratio computation algorithm is the worst possible.
-	// The xy, xz, yz edge points phase ratios are first computed locally,
-	// and then assembled separately for each phase. This step involves
-	// excessive communication, which is proportional to the number of phases.
+	if(!fs->dsx.periodic && !fs->dsy.periodic && !fs->dsz.periodic)
+	{
+		// import ghost markers contributing to local edges (single exchange)
+		ierr = ADVGetGhostMarkers(actx); CHKERRQ(ierr);
 
-	// *****************************************
-	// SO PLEASE KEEP NUMBER OF PHASES MINIMIZED
-	// *****************************************
+		// project phase ratios & history fields to edges locally
+		ierr = ADVInterpMarkToEdgeGhost(actx); CHKERRQ(ierr);
 
-	// compute edge phase ratios (consecutively)
-	for(ii = 0; ii < numPhases; ii++)
-	{
-		ierr = ADVInterpMarkToEdge(actx, ii, _PHASE_); CHKERRQ(ierr);
+		// free ghost markers
+		ierr = ADVDestroyMPIBuff(actx); CHKERRQ(ierr);
 	}
+	else
+	{
+		// NOTE: periodic edges are shared between the first and last domains.
+		// The xy, xz, yz edge points phase ratios are first computed locally,
+		// and then assembled separately for each phase. This step involves
+		// excessive communication, which is proportional to the number of phases.
+
+		// compute edge phase ratios (consecutively)
+		for(ii = 0; ii < numPhases; ii++)
+		{
+			ierr = ADVInterpMarkToEdge(actx, ii, _PHASE_); CHKERRQ(ierr);
+		}
 
-	// normalize phase ratios
-	for(jj = 0; jj < fs->nXYEdg; jj++)  { ierr = getPhaseRatio(numPhases, jr->svXYEdge[jj].phRat, &jr->svXYEdge[jj].ws); CHKERRQ(ierr); }
-	for(jj = 0; jj < fs->nXZEdg; jj++)  { ierr = getPhaseRatio(numPhases, jr->svXZEdge[jj].phRat, &jr->svXZEdge[jj].ws); CHKERRQ(ierr); }
-	for(jj = 0; jj < fs->nYZEdg; jj++)  { ierr = getPhaseRatio(numPhases, jr->svYZEdge[jj].phRat, &jr->svYZEdge[jj].ws); CHKERRQ(ierr); }
+		// normalize phase ratios
+		for(jj = 0; jj < fs->nXYEdg; jj++)  { ierr = getPhaseRatio(numPhases, jr->svXYEdge[jj].phRat, &jr->svXYEdge[jj].ws); CHKERRQ(ierr); }
+		for(jj = 0; jj < fs->nXZEdg; jj++)  { ierr = getPhaseRatio(numPhases, jr->svXZEdge[jj].phRat, &jr->svXZEdge[jj].ws); CHKERRQ(ierr); }
+		for(jj = 0; jj < fs->nYZEdg; jj++)  { ierr = getPhaseRatio(numPhases, jr->svYZEdge[jj].phRat, &jr->svYZEdge[jj].ws); CHKERRQ(ierr); }
 
-	// interpolate history stress to edges
-	ierr = ADVInterpMarkToEdge(actx, 0, _STRESS_); CHKERRQ(ierr);
+		// interpolate history stress to edges
+		ierr = ADVInterpMarkToEdge(actx, 0, _STRESS_); CHKERRQ(ierr);
 
-	// interpolate plastic strain to edges
-	ierr = ADVInterpMarkToEdge(actx, 0, _APS_); CHKERRQ(ierr);
+		// interpolate plastic strain to edges
+		ierr = ADVInterpMarkToEdge(actx, 0, _APS_); CHKERRQ(ierr);
+	}
 
 	// update phase ratios taking into account actual free surface position
 	ierr = FreeSurfGetAirPhaseRatio(actx->surf); CHKERRQ(ierr);
@@ -1906,6 +2134,7 @@ PetscErrorCode ADVInterpMarkToEdge(AdvCtx *actx, PetscInt iphase, InterpCase ica
 	PetscScalar  UPXY, UPXZ, UPYZ;
 	PetscInt     nx, ny, sx, sy, sz;
 	PetscInt     jj, ID, I, J, K, II, JJ, KK;
+	Vec          gbxy, gbxz, gbyz;
 	PetscScalar *gxy, *gxz, *gyz, ***lxy, ***lxz, ***lyz;
 	PetscScalar  xc, yc, zc, xp, yp, zp, wxc, wyc, wzc, wxn, wyn, wzn;
 
@@ -1987,15 +2216,20 @@ PetscErrorCode ADVInterpMarkToEdge(AdvCtx *actx, PetscInt iphase, InterpCase ica
 	ierr = DMDAVecRestoreArray(fs->DA_XZ, jr->ldxz, &lxz); CHKERRQ(ierr);
 	ierr = DMDAVecRestoreArray(fs->DA_YZ, jr->ldyz, &lyz); CHKERRQ(ierr);
 
+	// borrow global assembly buffers
+	ierr = DMGetGlobalVector(fs->DA_XY, &gbxy); CHKERRQ(ierr);
+	ierr = DMGetGlobalVector(fs->DA_XZ, &gbxz); CHKERRQ(ierr);
+	ierr = DMGetGlobalVector(fs->DA_YZ, &gbyz); CHKERRQ(ierr);
+
 	// assemble global vectors
-	LOCAL_TO_GLOBAL(fs->DA_XY, jr->ldxy, jr->gdxy)
-	LOCAL_TO_GLOBAL(fs->DA_XZ, jr->ldxz, jr->gdxz)
-	LOCAL_TO_GLOBAL(fs->DA_YZ, jr->ldyz, jr->gdyz)
+	LOCAL_TO_GLOBAL(fs->DA_XY, jr->ldxy, gbxy)
+	LOCAL_TO_GLOBAL(fs->DA_XZ, jr->ldxz, gbxz)
+	LOCAL_TO_GLOBAL(fs->DA_YZ, jr->ldyz, gbyz)
 
 	// access 1D layouts of global vectors
-	ierr = VecGetArray(jr->gdxy, &gxy);  CHKERRQ(ierr);
-	ierr = VecGetArray(jr->gdxz, &gxz);  CHKERRQ(ierr);
-	ierr = VecGetArray(jr->gdyz, &gyz);  CHKERRQ(ierr);
+	ierr = VecGetArray(gbxy, &gxy);  CHKERRQ(ierr);
+	ierr = VecGetArray(gbxz, &gxz);  CHKERRQ(ierr);
+	ierr = VecGetArray(gbyz, &gyz);  CHKERRQ(ierr);
 
 	// copy (normalized) data to the residual context
 	if(icase == _PHASE_)
@@ -2018,9 +2252,261 @@ PetscErrorCode ADVInterpMarkToEdge(AdvCtx *actx, PetscInt iphase, InterpCase ica
 	}
 
 	// restore access
-	ierr = VecRestoreArray(jr->gdxy, &gxy); CHKERRQ(ierr);
-	ierr = VecRestoreArray(jr->gdxz, &gxz); CHKERRQ(ierr);
-	ierr = VecRestoreArray(jr->gdyz, &gyz); CHKERRQ(ierr);
+	ierr = VecRestoreArray(gbxy, &gxy); CHKERRQ(ierr);
+	ierr = VecRestoreArray(gbxz, &gxz); CHKERRQ(ierr);
+	ierr = VecRestoreArray(gbyz, &gyz); CHKERRQ(ierr);
+
+	// return global assembly buffers
+	ierr = DMRestoreGlobalVector(fs->DA_XY, &gbxy); CHKERRQ(ierr);
+	ierr = DMRestoreGlobalVector(fs->DA_XZ, &gbxz); CHKERRQ(ierr);
+	ierr = DMRestoreGlobalVector(fs->DA_YZ, &gbyz); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscInt ADVGetEdgeTargets(AdvCtx *actx, PetscInt jj, PetscInt *targ)
+{
+	// get local ranks of neighbor domains owning edges affected by a marker
+	// (a marker in the last cell layer contributes to the first node of the
+	//  next domain if it is located in the upper half of the cell)
+
+	FDSTAG   *fs;
+	Marker   *P;
+	PetscInt  I, J, K, nx, ny, nz, ex, ey, ez, t[3], k, l, n;
+
+	fs = actx->fs;
+	P  = &actx->markers[jj];
+	nx = fs->dsx.ncels;
+	ny = fs->dsy.ncels;
+	nz = fs->dsz.ncels;
+
+	GET_CELL_IJK(actx->cellnum[jj], I, J, K, nx, ny)
+
+	ex = (I == nx-1 && fs->dsx.grnext != -1 && P->X[0] > fs->dsx.ccoor[I]);
+	ey = (J == ny-1 && fs->dsy.grnext != -1 && P->X[1] > fs->dsy.ccoor[J]);
+	ez = (K == nz-1 && fs->dsz.grnext != -1 && P->X[2] > fs->dsz.ccoor[K]);
+
+	// xy, xz & yz edge owners (13 is the local rank of this domain)
+	t[0] = 13 + ex + 3*ey;
+	t[1] = 13 + ex + 9*ez;
+	t[2] = 13 + 3*ey + 9*ez;
+
+	// collect distinct neighbors
+	for(k = 0, n = 0; k < 3; k++)
+	{
+		if(t[k] == 13) continue;
+
+		for(l = 0; l < n; l++) if(targ[l] == t[k]) break;
+
+		if(l == n) targ[n++] = t[k];
+	}
+
+	return n;
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVGetGhostMarkers(AdvCtx *actx)
+{
+	// import ghost markers from previous neighbor domains, which contribute
+	// to the first layers of local edges (stored in receive buffer)
+
+	PetscInt  jj, k, n, targ[3];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// count number of markers to be sent to each neighbor domain
+	ierr = PetscMemzero(actx->nsendm, _num_neighb_*sizeof(PetscInt)); CHKERRQ(ierr);
+
+	for(jj = 0; jj < actx->nummark; jj++)
+	{
+		n = ADVGetEdgeTargets(actx, jj, targ);
+
+		for(k = 0; k < n; k++) actx->nsendm[targ[k]]++;
+	}
+
+	// communicate number of markers with neighbor processes
+	ierr = ADVExchangeNumMark(actx); CHKERRQ(ierr);
+
+	// compute buffer pointers
+	actx->nsend = getPtrCnt(_num_neighb_, actx->nsendm, actx->ptsend);
+	actx->nrecv = getPtrCnt(_num_neighb_, actx->nrecvm, actx->ptrecv);
+
+	actx->sendbuf = NULL;
+	actx->recvbuf = NULL;
+	actx->idel    = NULL;
+	actx->ndel    = 0;
+
+	// allocate exchange buffers
+	if(actx->nsend) { ierr = PetscMalloc((size_t)actx->nsend*sizeof(Marker), &actx->sendbuf); CHKERRQ(ierr); }
+	if(actx->nrecv) { ierr = PetscMalloc((size_t)actx->nrecv*sizeof(Marker), &actx->recvbuf); CHKERRQ(ierr); }
+
+	// copy markers to send buffer
+	for(jj = 0; jj < actx->nummark; jj++)
+	{
+		n = ADVGetEdgeTargets(actx, jj, targ);
+
+		for(k = 0; k < n; k++) actx->sendbuf[actx->ptsend[targ[k]]++] = actx->markers[jj];
+	}
+
+	// rewind send buffer pointers
+	rewindPtr(_num_neighb_, actx->ptsend);
+
+	// communicate markers with neighbor processes
+	ierr = ADVExchangeMark(actx); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+void ADVAddMarkToEdge(AdvCtx *actx, Marker *P, PetscInt I, PetscInt J, PetscInt K)
+{
+	// add marker contributions to local edges (cell indices of ghost markers
+	// are -1 in the directions of previous domains, non-local edges are skipped)
+
+	FDSTAG      *fs;
+	JacRes      *jr;
+	SolVarEdge  *svEdge;
+	PetscInt     nx, ny, nz, mx, my, mz, II, JJ, KK;
+	PetscScalar  xp, yp, zp, wxc, wyc, wzc, wxn, wyn, wzn, w;
+
+	fs = actx->fs;
+	jr = actx->jr;
+
+	// number of local cells & nodes
+	nx = fs->dsx.ncels; mx = fs->dsx.nnods;
+	ny = fs->dsy.ncels; my = fs->dsy.nnods;
+	nz = fs->dsz.ncels; mz = fs->dsz.nnods;
+
+	// get marker coordinates
+	xp = P->X[0];
+	yp = P->X[1];
+	zp = P->X[2];
+
+	// map marker on the control volumes of edge nodes
+	if(xp > fs->dsx.ccoor[I]) { II = I+1; } else { II = I; }
+	if(yp > fs->dsy.ccoor[J]) { JJ = J+1; } else { JJ = J; }
+	if(zp > fs->dsz.ccoor[K]) { KK = K+1; } else { KK = K; }
+
+	// get interpolation weights in cell control volumes
+	wxc = WEIGHT_POINT_CELL(I, xp, fs->dsx);
+	wyc = WEIGHT_POINT_CELL(J, yp, fs->dsy);
+	wzc = WEIGHT_POINT_CELL(K, zp, fs->dsz);
+
+	// get interpolation weights in node control volumes
+	wxn = WEIGHT_POINT_NODE(II, xp, fs->dsx);
+	wyn = WEIGHT_POINT_NODE(JJ, yp, fs->dsy);
+	wzn = WEIGHT_POINT_NODE(KK, zp, fs->dsz);
+
+	// xy edge
+	if(II >= 0 && II < mx && JJ >= 0 && JJ < my && K >= 0 && K < nz)
+	{
+		svEdge = &jr->svXYEdge[II + JJ*mx + K*mx*my];
+		w      =  wxn*wyn*wzc;
+
+		svEdge->phRat[P->phase] += w;
+		svEdge->h               += w*P->S.xy;
+		svEdge->svDev.APS       += w*P->APS;
+	}
+
+	// xz edge
+	if(II >= 0 && II < mx && J >= 0 && J < ny && KK >= 0 && KK < mz)
+	{
+		svEdge = &jr->svXZEdge[II + J*mx + KK*mx*ny];
+		w      =  wxn*wyc*wzn;
+
+		svEdge->phRat[P->phase] += w;
+		svEdge->h               += w*P->S.xz;
+		svEdge->svDev.APS       += w*P->APS;
+	}
+
+	// yz edge
+	if(I >= 0 && I < nx && JJ >= 0 && JJ < my && KK >= 0 && KK < mz)
+	{
+		svEdge = &jr->svYZEdge[I + JJ*nx + KK*nx*my];
+		w      =  wxc*wyn*wzn;
+
+		svEdge->phRat[P->phase] += w;
+		svEdge->h               += w*P->S.yz;
+		svEdge->svDev.APS       += w*P->APS;
+	}
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVInterpMarkToEdgeGhost(AdvCtx *actx)
+{
+	// marker-to-grid projection of phase ratios, history stress & plastic
+	// strain on edge nodes using local and ghost markers (no assembly)
+
+	FDSTAG      *fs;
+	JacRes      *jr;
+	Marker      *P;
+	SolVarEdge  *svEdge;
+	PetscInt     ii, jj, k, I, J, K, nx, ny, nEdg, numPhases;
+	PetscInt     ix, iy, iz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs        = actx->fs;
+	jr        = actx->jr;
+	numPhases = actx->dbm->numPhases;
+
+	nx = fs->dsx.ncels;
+	ny = fs->dsy.ncels;
+
+	// clear edge variables
+	nEdg = fs->nXYEdg + fs->nXZEdg + fs->nYZEdg;
+
+	for(jj = 0; jj < nEdg; jj++)
+	{
+		if     (jj < fs->nXYEdg)              svEdge = &jr->svXYEdge[jj];
+		else if(jj < fs->nXYEdg + fs->nXZEdg) svEdge = &jr->svXZEdge[jj - fs->nXYEdg];
+		else                                  svEdge = &jr->svYZEdge[jj - fs->nXYEdg - fs->nXZEdg];
+
+		for(ii = 0; ii < numPhases; ii++) svEdge->phRat[ii] = 0.0;
+
+		svEdge->h         = 0.0;
+		svEdge->svDev.APS = 0.0;
+	}
+
+	// local markers
+	for(jj = 0; jj < actx->nummark; jj++)
+	{
+		GET_CELL_IJK(actx->cellnum[jj], I, J, K, nx, ny)
+
+		ADVAddMarkToEdge(actx, &actx->markers[jj], I, J, K);
+	}
+
+	// ghost markers (first cell layer of previous neighbors)
+	for(k = 0; k < _num_neighb_; k++)
+	{
+		// relative position of the sending domain
+		ix = k % 3 - 1;
+		iy = (k / 3) % 3 - 1;
+		iz = k / 9 - 1;
+
+		for(jj = actx->ptrecv[k]; jj < actx->ptrecv[k] + actx->nrecvm[k]; jj++)
+		{
+			P = &actx->recvbuf[jj];
+
+			if(ix) I = -1; else { ierr = Discret1DFindPoint(&fs->dsx, P->X[0], I); CHKERRQ(ierr); }
+			if(iy) J = -1; else { ierr = Discret1DFindPoint(&fs->dsy, P->X[1], J); CHKERRQ(ierr); }
+			if(iz) K = -1; else { ierr = Discret1DFindPoint(&fs->dsz, P->X[2], K); CHKERRQ(ierr); }
+
+			ADVAddMarkToEdge(actx, P, I, J, K);
+		}
+	}
+
+	// normalize phase ratios & history fields
+	for(jj = 0; jj < nEdg; jj++)
+	{
+		if     (jj < fs->nXYEdg)              svEdge = &jr->svXYEdge[jj];
+		else if(jj < fs->nXYEdg + fs->nXZEdg) svEdge = &jr->svXZEdge[jj - fs->nXYEdg];
+		else                                  svEdge = &jr->svYZEdge[jj - fs->nXYEdg - fs->nXZEdg];
+
+		ierr = getPhaseRatio(numPhases, svEdge->phRat, &svEdge->ws); CHKERRQ(ierr);
+
+		svEdge->h         /= svEdge->ws;
+		svEdge->svDev.APS /= svEdge->ws;
+	}
 
 	PetscFunctionReturn(0);
 }
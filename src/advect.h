@@ -23,6 +23,7 @@ struct FDSTAG;
 struct JacRes;
 struct FreeSurf;
 struct DBMat;
+struct AdvVelHalo;
 
 //---------------------------------------------------------------------------
 //............   Material marker (history variables advection)   ............
@@ -47,6 +48,37 @@ PetscErrorCode MarkerMerge(Marker &A, Marker &B, Marker &C);
 
 //---------------------------------------------------------------------------
 
+// Compact marker record, used in restart files if activated by mark_compact.
+// Coordinates are kept in double precision, phase is stored as 16-bit integer,
+// history fields in single precision. Record size is ~60% of the full marker.
+// History is rounded once per restart, i.e. a restarted run is not bitwise
+// identical to an uninterrupted one.
+
+struct MarkerPack
+{
+	PetscScalar X[3];  // global coordinates
+	float       p;     // pressure
+	float       T;     // temperature
+	float       APS;   // accumulated plastic strain
+	float       ATS;   // accumulated total strain
+	float       S[6];  // deviatoric stress (xx, xy, xz, yy, yz, zz)
+	float       U[3];  // displacement
+	short       phase; // phase identifier
+};
+
+// pack marker to compact record
+void MarkerPackStore(Marker &A, MarkerPack &C);
+
+// unpack marker from compact record
+void MarkerPackLoad(MarkerPack &C, Marker &A);
+
+//---------------------------------------------------------------------------
+
+// number of markers located per batch in the marker-to-cell mapping
+#define _map_block_ 512
+
+//---------------------------------------------------------------------------
+
 // marker initialization type enumeration
 enum SetupType
 {
@@ -78,6 +110,7 @@ enum AdvectionType
 	BASIC_EULER,    // basic Euler implementation (STAG interpolation only)
 	EULER,          // Euler explicit in time
 	RUNGE_KUTTA_2,  // Runge-Kutta 2nd order in space
+	RUNGE_KUTTA_4,  // Runge-Kutta 4th order in space
 };
 
 //-----------------------------------------------------------------------------
@@ -144,6 +177,9 @@ struct AdvCtx
 	AdvectionType advect;              // advection scheme
 	VelInterpType interp;              // velocity interpolation scheme
 	PetscScalar   A;                   // FDSTAG velocity interpolation parameter
+	PetscInt      velHalo;             // wide-halo velocity interpolation flag (no marker exchange between stages)
+	PetscInt      compact;             // compact marker records flag (restart files)
+	AdvVelHalo   *vh;                  // wide-halo velocity context (created on first use)
 
 	MarkCtrlType  mctrl;               // marker control type
 
@@ -208,6 +244,11 @@ PetscErrorCode ADVReadRestart(AdvCtx *actx, FILE *fp);
 // read advection object from restart database
 PetscErrorCode ADVWriteRestart(AdvCtx *actx, FILE *fp);
 
+// read & write compact marker records
+PetscErrorCode ADVReadCompact(AdvCtx *actx, FILE *fp);
+
+PetscErrorCode ADVWriteCompact(AdvCtx *actx, FILE *fp);
+
 // create communicator and separator
 PetscErrorCode ADVCreateData(AdvCtx *actx);
 
@@ -220,6 +261,15 @@ PetscErrorCode ADVSetBGPhase(AdvCtx *actx);
 // (re)allocate marker storage
 PetscErrorCode ADVReAllocStorage(AdvCtx *actx, PetscInt capacity);
 
+// get marker storage capacity (with overhead & rounded up to whole chunks)
+PetscInt ADVGetStorageCapacity(PetscInt nummark);
+
+// change marker storage capacity
+PetscErrorCode ADVResizeStorage(AdvCtx *actx, PetscInt markcap);
+
+// release unused marker storage (with hysteresis)
+PetscErrorCode ADVShrinkStorage(AdvCtx *actx);
+
 // perform advection step
 PetscErrorCode ADVAdvect(AdvCtx *actx);
 
@@ -271,6 +321,18 @@ PetscErrorCode ADVInterpMarkToCell(AdvCtx *actx);
 // marker-to-edge projection
 PetscErrorCode ADVInterpMarkToEdge(AdvCtx *actx, PetscInt iphase, InterpCase icase);
 
+// get local ranks of neighbors owning edges affected by a marker
+PetscInt ADVGetEdgeTargets(AdvCtx *actx, PetscInt jj, PetscInt *targ);
+
+// import ghost markers contributing to local edges
+PetscErrorCode ADVGetGhostMarkers(AdvCtx *actx);
+
+// add marker contributions to local edges
+void ADVAddMarkToEdge(AdvCtx *actx, Marker *P, PetscInt I, PetscInt J, PetscInt K);
+
+// marker-to-edge projection of all edge fields with ghost markers
+PetscErrorCode ADVInterpMarkToEdgeGhost(AdvCtx *actx);
+
 // inject or delete markers
 PetscErrorCode ADVMarkControl(AdvCtx *actx);
 
@@ -117,6 +117,7 @@ PetscErrorCode ADVelInterpPT(AdvCtx *actx)
 PetscErrorCode ADVelAdvectScheme(AdvCtx *actx, AdvVelCtx *vi)
 {
 	PetscScalar  dt;
+	PetscInt     nmiss;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -133,13 +134,32 @@ PetscErrorCode ADVelAdvectScheme(AdvCtx *actx, AdvVelCtx *vi)
 	// get current time step
 	dt = actx->jr->ts->dt;
 
+	//=======================================================================
+	// WIDE-HALO ADVECTION (no marker exchange between the stages)
+	//=======================================================================
+
+	nmiss = 1;
+
+	if(actx->velHalo)
+	{
+		ierr = ADVelAdvectHalo(actx, vi, dt, &nmiss); CHKERRQ(ierr);
+
+		if(nmiss)
+		{
+			PetscPrintf(PETSC_COMM_WORLD, "Velocity halo does not cover %lld markers, exchanging markers between stages\n", (LLD)nmiss);
+
+			// restart from initial positions
+			ierr = ADVelInitCoord(actx, vi->interp, vi->nmark); CHKERRQ(ierr);
+		}
+	}
+
 	//=======================================================================
 	// START ADVECTION
 	//=======================================================================
 	// ---------------------------------
 	// EULER (1st order)
 	// ---------------------------------
-	if(actx->advect == EULER)
+	if(nmiss && actx->advect == EULER)
 	{
 		// 1. Velocity interpolation
 		ierr = ADVelInterpMain(vi); CHKERRQ(ierr);
@@ -154,7 +174,7 @@ PetscErrorCode ADVelAdvectScheme(AdvCtx *actx, AdvVelCtx *vi)
 	// ---------------------------------
 	// Runge-Kutta 2nd order in space
 	// ---------------------------------
-	else if(actx->advect == RUNGE_KUTTA_2)
+	else if(nmiss && actx->advect == RUNGE_KUTTA_2)
 	{
 		// velocity interpolation A
 		ierr = ADVelInterpMain(vi); CHKERRQ(ierr);
@@ -170,6 +190,28 @@ PetscErrorCode ADVelAdvectScheme(AdvCtx *actx, AdvVelCtx *vi)
 		ierr = ADVelAdvectCoord(vi->interp, vi->nmark, dt, 1); CHKERRQ(ierr);
 	}
 
+	// ---------------------------------
+	// Runge-Kutta 4th order in space
+	// ---------------------------------
+	else if(nmiss && actx->advect == RUNGE_KUTTA_4)
+	{
+		// velocity interpolation A
+		ierr = ADVelInterpMain(vi); CHKERRQ(ierr);
+		ierr = ADVelCalcEffVel(vi->interp, vi->nmark, 1.0/6.0); CHKERRQ(ierr);
+
+		// Runge-Kutta steps to B, C, D
+		ierr = ADVelRungeKuttaStep(vi, dt/2, 1.0/3.0, 0); CHKERRQ(ierr);
+		ierr = ADVelRungeKuttaStep(vi, dt/2, 1.0/3.0, 0); CHKERRQ(ierr);
+		ierr = ADVelRungeKuttaStep(vi, dt,   1.0/6.0, 0); CHKERRQ(ierr);
+
+		// needed for mapping between vi and actx in parallel
+		ierr = ADVelResetCoord(vi->interp, vi->nmark); CHKERRQ(ierr);
+		ierr = ADVelExchange(vi); CHKERRQ(ierr);
+
+		// final position
+		ierr = ADVelAdvectCoord(vi->interp, vi->nmark, dt, 1); CHKERRQ(ierr);
+	}
+
 	//=======================================================================
 	// END ADVECTION
 	//=======================================================================
@@ -807,8 +849,9 @@ PetscErrorCode ADVelReAllocStorage(AdvVelCtx *vi, PetscInt nmark)
 	// check whether current storage is insufficient
 	if(nmark > vi->nbuff)
 	{
-		// delete host cell numbers
+		// delete host cell numbers & marker indices
 		ierr = PetscFree(vi->cellnum); CHKERRQ(ierr);
+		ierr = PetscFree(vi->markind); CHKERRQ(ierr);
 
 		// compute new capacity
 		nbuff = (PetscInt)(_cap_overhead_*(PetscScalar)nmark);
@@ -847,8 +890,10 @@ PetscErrorCode ADVelMapMarkToCells(AdvVelCtx *vi)
 	// maps markers to cells (local)
 
 	FDSTAG      *fs;
-	PetscScalar *X;
-	PetscInt     i, ID, I, J, K, M, N;
+	PetscScalar *X, xb[_map_block_], yb[_map_block_], zb[_map_block_];
+	PetscInt     Ib[_map_block_], Jb[_map_block_], Kb[_map_block_];
+	PetscInt    *binx, *biny, *binz, nbinx, nbiny, nbinz;
+	PetscInt     i, ib, nb, ID, M, N;
 	PetscInt    *numMarkCell, *m, p;
 
 	PetscErrorCode ierr;
@@ -860,23 +905,43 @@ PetscErrorCode ADVelMapMarkToCells(AdvVelCtx *vi)
 	M = fs->dsx.ncels;
 	N = fs->dsy.ncels;
 
-	// loop over all local particles
-	for(i = 0; i < vi->nmark; i++)
+	// setup lookup tables for non-uniform directions
+	ierr = Discret1DGetBins(&fs->dsx, &binx, &nbinx); CHKERRQ(ierr);
+	ierr = Discret1DGetBins(&fs->dsy, &biny, &nbiny); CHKERRQ(ierr);
+	ierr = Discret1DGetBins(&fs->dsz, &binz, &nbinz); CHKERRQ(ierr);
+
+	// loop over all local particles in blocks
+	for(ib = 0; ib < vi->nmark; ib += _map_block_)
 	{
-		// get marker coordinates
-		X = vi->interp[i].x;
+		nb = PetscMin(_map_block_, vi->nmark - ib);
+
+		// gather marker coordinates
+		for(i = 0; i < nb; i++)
+		{
+			X     = vi->interp[ib+i].x;
+			xb[i] = X[0];
+			yb[i] = X[1];
+			zb[i] = X[2];
+		}
 
 		// get host cell IDs in all directions
-		ierr = Discret1DFindPoint(&fs->dsx, X[0], I); CHKERRQ(ierr);
-		ierr = Discret1DFindPoint(&fs->dsy, X[1], J); CHKERRQ(ierr);
-		ierr = Discret1DFindPoint(&fs->dsz, X[2], K); CHKERRQ(ierr);
+		ierr = Discret1DFindPoints(&fs->dsx, nb, xb, Ib, binx, nbinx); CHKERRQ(ierr);
+		ierr = Discret1DFindPoints(&fs->dsy, nb, yb, Jb, biny, nbiny); CHKERRQ(ierr);
+		ierr = Discret1DFindPoints(&fs->dsz, nb, zb, Kb, binz, nbinz); CHKERRQ(ierr);
 
 		// compute and store consecutive index
-		GET_CELL_ID(ID, I, J, K, M, N);
+		for(i = 0; i < nb; i++)
+		{
+			GET_CELL_ID(ID, Ib[i], Jb[i], Kb[i], M, N);
 
-		vi->cellnum[i] = ID;
+			vi->cellnum[ib+i] = ID;
+		}
 	}
 
+	ierr = PetscFree(binx); CHKERRQ(ierr);
+	ierr = PetscFree(biny); CHKERRQ(ierr);
+	ierr = PetscFree(binz); CHKERRQ(ierr);
+
 	// allocate marker counter array
 	ierr = makeIntArray(&numMarkCell, NULL, fs->nCells); CHKERRQ(ierr);
 
@@ -924,15 +989,18 @@ PetscErrorCode ADVelInterpMain(AdvVelCtx *vi)
 PetscErrorCode ADVelInterpSTAG(AdvVelCtx *vi)
 {
 	// interpolate velocities from STAG points to markers
+	// markers are processed by host cells in blocks (see VelStencil)
 
 	FDSTAG      *fs;
 	JacRes      *jr;
-	PetscInt    sx, sy, sz, nx, ny, nmark;
-	PetscInt    jj, ID, I, J, K, II, JJ, KK;
+	VelStencil   st;
+	PetscInt    sx, sy, sz, nx, ny;
+	PetscInt    i, ib, nb, pind, ID, I, J, K, *ind;
 	PetscScalar *ncx, *ncy, *ncz;
 	PetscScalar *ccx, *ccy, *ccz;
 	PetscScalar ***lvx, ***lvy, ***lvz;
-	PetscScalar xc, yc, zc, xp, yp, zp;
+	PetscScalar xb[_map_block_], yb[_map_block_], zb[_map_block_];
+	PetscScalar ub[_map_block_], vb[_map_block_], wb[_map_block_];
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -944,8 +1012,6 @@ PetscErrorCode ADVelInterpSTAG(AdvVelCtx *vi)
 	fs = vi->fs;
 	jr = vi->jr;
 
-	nmark = vi->nmark;
-
 	// starting indices & number of cells
 	sx = fs->dsx.pstart; nx = fs->dsx.ncels;
 	sy = fs->dsy.pstart; ny = fs->dsy.ncels;
@@ -956,39 +1022,51 @@ PetscErrorCode ADVelInterpSTAG(AdvVelCtx *vi)
 	ncy = fs->dsy.ncoor; ccy = fs->dsy.ccoor;
 	ncz = fs->dsz.ncoor; ccz = fs->dsz.ccoor;
 
-	// access velocity, pressure & temperature vectors
+	// access velocity vectors
 	ierr = DMDAVecGetArray(fs->DA_X,   jr->lvx, &lvx); CHKERRQ(ierr);
 	ierr = DMDAVecGetArray(fs->DA_Y,   jr->lvy, &lvy); CHKERRQ(ierr);
 	ierr = DMDAVecGetArray(fs->DA_Z,   jr->lvz, &lvz); CHKERRQ(ierr);
 
-	// scan all markers
-	for(jj = 0; jj < nmark; jj++)
+	// scan all cells
+	for(ID = 0; ID < fs->nCells; ID++)
 	{
-		// get marker coordinates
-		xp = vi->interp[jj].x[0];
-		yp = vi->interp[jj].x[1];
-		zp = vi->interp[jj].x[2];
-
-		// get consecutive index of the host cell
-		ID = vi->cellnum[jj];
+		// skip empty cells
+		if(vi->markstart[ID] == vi->markstart[ID+1]) continue;
 
 		// expand I, J, K cell indices
 		GET_CELL_IJK(ID, I, J, K, nx, ny)
 
-		// get coordinates of cell center
-		xc = ccx[I];
-		yc = ccy[J];
-		zc = ccz[K];
+		// load velocity stencil of the cell
+		VelStencilLoad(&st, lvx, lvy, lvz, I, J, K, sx, sy, sz, ncx, ncy, ncz, ccx, ccy, ccz);
 
-		// map marker on the cells of X, Y, Z & center grids
-		if(xp > xc) { II = I; } else { II = I-1; }
-		if(yp > yc) { JJ = J; } else { JJ = J-1; }
-		if(zp > zc) { KK = K; } else { KK = K-1; }
+		// process markers of the cell in blocks
+		ind = vi->markind + vi->markstart[ID];
 
-		// interpolate velocity, pressure & temperature
-		vi->interp[jj].v[0] = InterpLin3D(lvx, I,  JJ, KK, sx, sy, sz, xp, yp, zp, ncx, ccy, ccz);
-		vi->interp[jj].v[1] = InterpLin3D(lvy, II, J,  KK, sx, sy, sz, xp, yp, zp, ccx, ncy, ccz);
-		vi->interp[jj].v[2] = InterpLin3D(lvz, II, JJ, K,  sx, sy, sz, xp, yp, zp, ccx, ccy, ncz);
+		for(ib = 0; ib < vi->markstart[ID+1] - vi->markstart[ID]; ib += _map_block_)
+		{
+			nb = PetscMin(_map_block_, vi->markstart[ID+1] - vi->markstart[ID] - ib);
+
+			// gather marker coordinates
+			for(i = 0; i < nb; i++)
+			{
+				pind  = ind[ib+i];
+				xb[i] = vi->interp[pind].x[0];
+				yb[i] = vi->interp[pind].x[1];
+				zb[i] = vi->interp[pind].x[2];
+			}
+
+			// interpolate velocity
+			VelStencilInterp(&st, nb, xb, yb, zb, ub, vb, wb);
+
+			// scatter marker velocities
+			for(i = 0; i < nb; i++)
+			{
+				pind = ind[ib+i];
+				vi->interp[pind].v[0] = ub[i];
+				vi->interp[pind].v[1] = vb[i];
+				vi->interp[pind].v[2] = wb[i];
+			}
+		}
 	}
 
 	// restore access
@@ -1004,6 +1082,8 @@ PetscErrorCode ADVelInterpMINMOD(AdvVelCtx *vi)
 	// interpolation to nodes from fdstag points using a MINMOD limiter
 	// then trilinear interpolation to markers
 	// with velocity correction from Jenny et al (2001), Meyer and Jenny (2004) and Wang et al (2015)
+	// (node velocities & corrections are computed once per cell, which already
+	// batches the markers of a cell; the staggered VelStencil does not apply)
 
 	FDSTAG      *fs;
 	JacRes      *jr;
@@ -1461,3 +1541,531 @@ PetscErrorCode ADVelInterpSTAGP(AdvVelCtx *vi)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloCreate(AdvCtx *actx)
+{
+	// create wide-halo velocity context
+
+	FDSTAG      *fs;
+	AdvVelHalo  *vh;
+	Discret1D   *ds[3];
+	PetscInt     i, d, w, nmin, sz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = actx->fs;
+
+	ierr = PetscMalloc(sizeof(AdvVelHalo), &vh); CHKERRQ(ierr);
+	ierr = PetscMemzero(vh, sizeof(AdvVelHalo)); CHKERRQ(ierr);
+
+	ds[0] = &fs->dsx;
+	ds[1] = &fs->dsy;
+	ds[2] = &fs->dsz;
+
+	// halo width covers maximum CFL-bounded displacement + interpolation stencil
+	w = (PetscInt)PetscCeilReal(actx->jr->ts->CFLMAX) + 2;
+
+	// stencil width cannot exceed minimum local grid size
+	for(d = 0; d < 3; d++)
+	{
+		for(i = 0; i < ds[d]->nproc; i++)
+		{
+			nmin = ds[d]->starts[i+1] - ds[d]->starts[i];
+
+			if(w > nmin) w = nmin;
+		}
+	}
+
+	vh->width = w;
+
+	// create extended grids
+	ierr = ADVelHaloCreateDA(fs->DA_X, w, &vh->DA_X); CHKERRQ(ierr);
+	ierr = ADVelHaloCreateDA(fs->DA_Y, w, &vh->DA_Y); CHKERRQ(ierr);
+	ierr = ADVelHaloCreateDA(fs->DA_Z, w, &vh->DA_Z); CHKERRQ(ierr);
+
+	ierr = DMCreateGlobalVector(vh->DA_X, &vh->gvx); CHKERRQ(ierr);
+	ierr = DMCreateGlobalVector(vh->DA_Y, &vh->gvy); CHKERRQ(ierr);
+	ierr = DMCreateGlobalVector(vh->DA_Z, &vh->gvz); CHKERRQ(ierr);
+
+	ierr = DMCreateLocalVector (vh->DA_X, &vh->lvx); CHKERRQ(ierr);
+	ierr = DMCreateLocalVector (vh->DA_Y, &vh->lvy); CHKERRQ(ierr);
+	ierr = DMCreateLocalVector (vh->DA_Z, &vh->lvz); CHKERRQ(ierr);
+
+	// get host cells covered by the halo (faces in base direction, cells otherwise)
+	ierr = ADVelHaloGetRange(vh->DA_X, vh->DA_Y, 0, &vh->lo[0], &vh->hi[0]); CHKERRQ(ierr);
+	ierr = ADVelHaloGetRange(vh->DA_Y, vh->DA_X, 1, &vh->lo[1], &vh->hi[1]); CHKERRQ(ierr);
+	ierr = ADVelHaloGetRange(vh->DA_Z, vh->DA_X, 2, &vh->lo[2], &vh->hi[2]); CHKERRQ(ierr);
+
+	// allocate global coordinates (nodes & cells + 1 layer of ghost points)
+	sz = 0;
+
+	for(d = 0; d < 3; d++) sz += ds[d]->tnods + 2 + ds[d]->tcels + 2;
+
+	ierr = makeScalArray(&vh->cbuff, NULL, sz); CHKERRQ(ierr);
+
+	vh->ncx = vh->cbuff + 1;
+	vh->ccx = vh->ncx   + fs->dsx.tnods + 2;
+	vh->ncy = vh->ccx   + fs->dsx.tcels + 2;
+	vh->ccy = vh->ncy   + fs->dsy.tnods + 2;
+	vh->ncz = vh->ccy   + fs->dsy.tcels + 2;
+	vh->ccz = vh->ncz   + fs->dsz.tnods + 2;
+
+	actx->vh = vh;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloDestroy(AdvCtx *actx)
+{
+	AdvVelHalo *vh;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	vh = actx->vh;
+
+	if(!vh) PetscFunctionReturn(0);
+
+	ierr = DMDestroy (&vh->DA_X);  CHKERRQ(ierr);
+	ierr = DMDestroy (&vh->DA_Y);  CHKERRQ(ierr);
+	ierr = DMDestroy (&vh->DA_Z);  CHKERRQ(ierr);
+	ierr = VecDestroy(&vh->gvx);   CHKERRQ(ierr);
+	ierr = VecDestroy(&vh->gvy);   CHKERRQ(ierr);
+	ierr = VecDestroy(&vh->gvz);   CHKERRQ(ierr);
+	ierr = VecDestroy(&vh->lvx);   CHKERRQ(ierr);
+	ierr = VecDestroy(&vh->lvy);   CHKERRQ(ierr);
+	ierr = VecDestroy(&vh->lvz);   CHKERRQ(ierr);
+	ierr = PetscFree (vh->cbuff);  CHKERRQ(ierr);
+	ierr = PetscFree (actx->vh);   CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloCreateDA(DM da, PetscInt w, DM *dae)
+{
+	// create grid extended by 1 layer of boundary ghost points with wide stencil
+	// (boundary ghost points are owned by the first & last processors)
+
+	PetscInt        M, N, P, m, n, p;
+	const PetscInt *plx, *ply, *plz;
+	PetscInt       *lx, *ly, *lz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = DMDAGetInfo(da, 0, &M, &N, &P, &m, &n, &p, 0, 0, 0, 0, 0, 0); CHKERRQ(ierr);
+
+	ierr = DMDAGetOwnershipRanges(da, &plx, &ply, &plz); CHKERRQ(ierr);
+
+	ierr = makeIntArray(&lx, plx, m); CHKERRQ(ierr);
+	ierr = makeIntArray(&ly, ply, n); CHKERRQ(ierr);
+	ierr = makeIntArray(&lz, plz, p); CHKERRQ(ierr);
+
+	lx[0]++; lx[m-1]++;
+	ly[0]++; ly[n-1]++;
+	lz[0]++; lz[p-1]++;
+
+	ierr = DMDACreate3dSetUp(PETSC_COMM_WORLD,
+		DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_BOX,
+		M+2, N+2, P+2, m, n, p, 1, w, lx, ly, lz, dae); CHKERRQ(ierr);
+
+	ierr = PetscFree(lx); CHKERRQ(ierr);
+	ierr = PetscFree(ly); CHKERRQ(ierr);
+	ierr = PetscFree(lz); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloGetRange(DM daf, DM dac, PetscInt dir, PetscInt *lo, PetscInt *hi)
+{
+	// get global index range of host cells that can be interpolated locally
+	// daf - grid with nodes in the base direction
+	// dac - grid with cells in the base direction
+
+	PetscInt fs[3], fn[3], cs[3], cn[3];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = DMDAGetGhostCorners(daf, &fs[0], &fs[1], &fs[2], &fn[0], &fn[1], &fn[2]); CHKERRQ(ierr);
+	ierr = DMDAGetGhostCorners(dac, &cs[0], &cs[1], &cs[2], &cn[0], &cn[1], &cn[2]); CHKERRQ(ierr);
+
+	// extended indices are shifted by one w.r.t. to global indices
+	// nodes I & I+1, cells I-1, I & I+1 must be available
+
+	(*lo) = PetscMax(fs[dir] - 1,             cs[dir]);
+	(*hi) = PetscMin(fs[dir] + fn[dir] - 3,   cs[dir] + cn[dir] - 3);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloFill(DM da, Vec lv, DM dae, Vec gve)
+{
+	// copy owned velocities & boundary ghost points to extended global vector
+
+	PetscScalar ***v, ***ve;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = DMDAVecGetArray(da,  lv,  &v);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(dae, gve, &ve); CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(dae, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	START_STD_LOOP
+	{
+		ve[k][j][i] = v[k-1][j-1][i-1];
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(da,  lv,  &v);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(dae, gve, &ve); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloGatherCoord(Discret1D *ds, PetscScalar *ncoor, PetscScalar *ccoor)
+{
+	// gather global node & cell coordinates on all processors
+
+	PetscInt     i, n;
+	PetscMPIInt *recvcnts, *recvdisp;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	n = ds->tnods;
+
+	if(ds->nproc == 1)
+	{
+		ierr = PetscMemcpy(ncoor, ds->ncoor, (size_t)n*sizeof(PetscScalar)); CHKERRQ(ierr);
+	}
+	else
+	{
+		ierr = Discret1DGetColumnComm(ds); CHKERRQ(ierr);
+
+		ierr = makeMPIIntArray(&recvcnts, NULL, ds->nproc); CHKERRQ(ierr);
+		ierr = makeMPIIntArray(&recvdisp, NULL, ds->nproc); CHKERRQ(ierr);
+
+		for(i = 0; i < ds->nproc; i++)
+		{
+			recvcnts[i] = (PetscMPIInt)(ds->starts[i+1] - ds->starts[i]);
+			recvdisp[i] = (PetscMPIInt)ds->starts[i];
+		}
+
+		// last node is stored on last processor
+		recvcnts[ds->nproc-1]++;
+
+		ierr = MPI_Allgatherv(ds->ncoor, (PetscMPIInt)ds->nnods, MPIU_SCALAR,
+			ncoor, recvcnts, recvdisp, MPIU_SCALAR, ds->comm); CHKERRQ(ierr);
+
+		ierr = PetscFree(recvcnts); CHKERRQ(ierr);
+		ierr = PetscFree(recvdisp); CHKERRQ(ierr);
+	}
+
+	// set boundary ghost coordinates
+	ncoor[-1] = 2.0*ncoor[0]   - ncoor[1];
+	ncoor[n]  = 2.0*ncoor[n-1] - ncoor[n-2];
+
+	// compute coordinates of the cell centers including ghosts
+	for(i = -1; i < ds->tcels+1; i++) ccoor[i] = (ncoor[i] + ncoor[i+1])/2.0;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloUpdate(AdvCtx *actx)
+{
+	// import velocity halo & current grid coordinates
+
+	FDSTAG     *fs;
+	JacRes     *jr;
+	AdvVelHalo *vh;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = actx->fs;
+	jr = actx->jr;
+	vh = actx->vh;
+
+	ierr = ADVelHaloFill(fs->DA_X, jr->lvx, vh->DA_X, vh->gvx); CHKERRQ(ierr);
+	ierr = ADVelHaloFill(fs->DA_Y, jr->lvy, vh->DA_Y, vh->gvy); CHKERRQ(ierr);
+	ierr = ADVelHaloFill(fs->DA_Z, jr->lvz, vh->DA_Z, vh->gvz); CHKERRQ(ierr);
+
+	// post all scatters at once
+	ierr = DMGlobalToLocalBegin(vh->DA_X, vh->gvx, INSERT_VALUES, vh->lvx); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalBegin(vh->DA_Y, vh->gvy, INSERT_VALUES, vh->lvy); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalBegin(vh->DA_Z, vh->gvz, INSERT_VALUES, vh->lvz); CHKERRQ(ierr);
+
+	// grid can be stretched, gather coordinates every time step
+	ierr = ADVelHaloGatherCoord(&fs->dsx, vh->ncx, vh->ccx); CHKERRQ(ierr);
+	ierr = ADVelHaloGatherCoord(&fs->dsy, vh->ncy, vh->ccy); CHKERRQ(ierr);
+	ierr = ADVelHaloGatherCoord(&fs->dsz, vh->ncz, vh->ccz); CHKERRQ(ierr);
+
+	ierr = DMGlobalToLocalEnd(vh->DA_X, vh->gvx, INSERT_VALUES, vh->lvx); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalEnd(vh->DA_Y, vh->gvy, INSERT_VALUES, vh->lvy); CHKERRQ(ierr);
+	ierr = DMGlobalToLocalEnd(vh->DA_Z, vh->gvz, INSERT_VALUES, vh->lvz); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelHaloInterp(AdvVelCtx *vi, PetscInt *out, PetscInt *nmiss)
+{
+	// interpolate velocities from wide halo to markers (STAG)
+	// markers leaving the domain are flagged, markers outside the halo are counted
+	// markers are processed by host cells of the halo in blocks (see VelStencil)
+
+	FDSTAG      *fs;
+	AdvVelHalo  *vh;
+	VelStencil   st;
+	PetscInt    jj, i, ib, nb, I, J, K, ID, M, N, ncel, mx, my, mz, miss;
+	PetscInt    *cellnum, *markstart, *markind, *m, *ind;
+	PetscScalar ***lvx, ***lvy, ***lvz;
+	PetscScalar *ncx, *ncy, *ncz, *ccx, *ccy, *ccz;
+	PetscScalar xp, yp, zp;
+	PetscScalar xb[_map_block_], yb[_map_block_], zb[_map_block_];
+	PetscScalar ub[_map_block_], vb[_map_block_], wb[_map_block_];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = vi->fs;
+	vh = vi->actx->vh;
+
+	mx = fs->dsx.tcels;
+	my = fs->dsy.tcels;
+	mz = fs->dsz.tcels;
+
+	ncx = vh->ncx; ccx = vh->ccx;
+	ncy = vh->ncy; ccy = vh->ccy;
+	ncz = vh->ncz; ccz = vh->ccz;
+
+	// number of host cells covered by the halo
+	M    = vh->hi[0] - vh->lo[0] + 1;
+	N    = vh->hi[1] - vh->lo[1] + 1;
+	ncel = M*N*(vh->hi[2] - vh->lo[2] + 1);
+
+	ierr = makeIntArray(&cellnum,   NULL, vi->nmark); CHKERRQ(ierr);
+	ierr = makeIntArray(&markind,   NULL, vi->nmark); CHKERRQ(ierr);
+	ierr = makeIntArray(&markstart, NULL, ncel+1);    CHKERRQ(ierr);
+	ierr = makeIntArray(&m,         NULL, ncel);      CHKERRQ(ierr);
+
+	miss = 0;
+
+	// map markers on halo cells
+	for(jj = 0; jj < vi->nmark; jj++)
+	{
+		cellnum[jj] = -1;
+
+		if(out[jj]) continue;
+
+		// get marker coordinates
+		xp = vi->interp[jj].x[0];
+		yp = vi->interp[jj].x[1];
+		zp = vi->interp[jj].x[2];
+
+		// flag outflow markers
+		if(xp < ncx[0] || xp >= ncx[mx]
+		|| yp < ncy[0] || yp >= ncy[my]
+		|| zp < ncz[0] || zp >= ncz[mz])
+		{
+			out[jj] = 1;
+
+			continue;
+		}
+
+		// get global host cell
+		I = ADVelHaloFindCell(ncx, mx, xp);
+		J = ADVelHaloFindCell(ncy, my, yp);
+		K = ADVelHaloFindCell(ncz, mz, zp);
+
+		// check halo coverage
+		if(I < vh->lo[0] || I > vh->hi[0]
+		|| J < vh->lo[1] || J > vh->hi[1]
+		|| K < vh->lo[2] || K > vh->hi[2])
+		{
+			miss++;
+
+			continue;
+		}
+
+		GET_CELL_ID(ID, I - vh->lo[0], J - vh->lo[1], K - vh->lo[2], M, N);
+
+		cellnum[jj] = ID;
+
+		// count number of markers in the cells
+		markstart[ID+1]++;
+	}
+
+	// store starting indices & marker indices belonging to a cell
+	for(i = 0; i < ncel; i++) markstart[i+1] += markstart[i];
+
+	for(jj = 0; jj < vi->nmark; jj++)
+	{
+		if(cellnum[jj] < 0) continue;
+
+		markind[markstart[cellnum[jj]] + m[cellnum[jj]]++] = jj;
+	}
+
+	ierr = DMDAVecGetArray(vh->DA_X, vh->lvx, &lvx); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(vh->DA_Y, vh->lvy, &lvy); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(vh->DA_Z, vh->lvz, &lvz); CHKERRQ(ierr);
+
+	// scan all halo cells
+	for(ID = 0; ID < ncel; ID++)
+	{
+		// skip empty cells
+		if(markstart[ID] == markstart[ID+1]) continue;
+
+		// expand global I, J, K cell indices
+		GET_CELL_IJK(ID, I, J, K, M, N)
+
+		I += vh->lo[0];
+		J += vh->lo[1];
+		K += vh->lo[2];
+
+		// load velocity stencil of the cell (extended indices are shifted by one)
+		VelStencilLoad(&st, lvx, lvy, lvz, I, J, K, 1, 1, 1, ncx, ncy, ncz, ccx, ccy, ccz);
+
+		// process markers of the cell in blocks
+		ind = markind + markstart[ID];
+
+		for(ib = 0; ib < markstart[ID+1] - markstart[ID]; ib += _map_block_)
+		{
+			nb = PetscMin(_map_block_, markstart[ID+1] - markstart[ID] - ib);
+
+			// gather marker coordinates
+			for(i = 0; i < nb; i++)
+			{
+				jj    = ind[ib+i];
+				xb[i] = vi->interp[jj].x[0];
+				yb[i] = vi->interp[jj].x[1];
+				zb[i] = vi->interp[jj].x[2];
+			}
+
+			// interpolate velocity
+			VelStencilInterp(&st, nb, xb, yb, zb, ub, vb, wb);
+
+			// scatter marker velocities
+			for(i = 0; i < nb; i++)
+			{
+				jj = ind[ib+i];
+				vi->interp[jj].v[0] = ub[i];
+				vi->interp[jj].v[1] = vb[i];
+				vi->interp[jj].v[2] = wb[i];
+			}
+		}
+	}
+
+	ierr = DMDAVecRestoreArray(vh->DA_X, vh->lvx, &lvx); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(vh->DA_Y, vh->lvy, &lvy); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(vh->DA_Z, vh->lvz, &lvz); CHKERRQ(ierr);
+
+	ierr = PetscFree(cellnum);   CHKERRQ(ierr);
+	ierr = PetscFree(markind);   CHKERRQ(ierr);
+	ierr = PetscFree(markstart); CHKERRQ(ierr);
+	ierr = PetscFree(m);         CHKERRQ(ierr);
+
+	(*nmiss) += miss;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode ADVelAdvectHalo(AdvCtx *actx, AdvVelCtx *vi, PetscScalar dt, PetscInt *nmiss)
+{
+	// advect markers with all stages evaluated in the wide velocity halo
+	// outflow markers are left outside the domain (deleted in ADVExchange)
+	// returns global number of stage positions not covered by the halo
+
+	VelInterp   *P;
+	PetscScalar c[4], b[4];
+	PetscInt    jj, is, ns, lmiss, *out;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// explicit Runge-Kutta tableau (stage s only depends on stage s-1)
+	if(actx->advect == EULER)
+	{
+		ns = 1;
+		c[0] = 0.0; b[0] = 1.0;
+	}
+	else if(actx->advect == RUNGE_KUTTA_2)
+	{
+		ns = 2;
+		c[0] = 0.0; b[0] = 0.0;
+		c[1] = 0.5; b[1] = 1.0;
+	}
+	else
+	{
+		ns = 4;
+		c[0] = 0.0; b[0] = 1.0/6.0;
+		c[1] = 0.5; b[1] = 1.0/3.0;
+		c[2] = 0.5; b[2] = 1.0/3.0;
+		c[3] = 1.0; b[3] = 1.0/6.0;
+	}
+
+	// create context on first use
+	if(!actx->vh) { ierr = ADVelHaloCreate(actx); CHKERRQ(ierr); }
+
+	// import velocity halo
+	ierr = ADVelHaloUpdate(actx); CHKERRQ(ierr);
+
+	// allocate outflow flags
+	ierr = makeIntArray(&out, NULL, vi->nmark); CHKERRQ(ierr);
+
+	lmiss = 0;
+
+	for(is = 0; is < ns; is++)
+	{
+		// intermediate position
+		if(is)
+		{
+			for(jj = 0; jj < vi->nmark; jj++)
+			{
+				if(out[jj]) continue;
+
+				P = &vi->interp[jj];
+
+				P->x[0] = P->x0[0] + P->v[0]*c[is]*dt;
+				P->x[1] = P->x0[1] + P->v[1]*c[is]*dt;
+				P->x[2] = P->x0[2] + P->v[2]*c[is]*dt;
+			}
+		}
+
+		// velocity interpolation
+		ierr = ADVelHaloInterp(vi, out, &lmiss); CHKERRQ(ierr);
+
+		// update effective velocity
+		ierr = ADVelCalcEffVel(vi->interp, vi->nmark, b[is]); CHKERRQ(ierr);
+	}
+
+	// final position (outflow markers keep the last stage position)
+	for(jj = 0; jj < vi->nmark; jj++)
+	{
+		if(out[jj]) continue;
+
+		P = &vi->interp[jj];
+
+		P->x[0] = P->x0[0] + P->v_eff[0]*dt;
+		P->x[1] = P->x0[1] + P->v_eff[1]*dt;
+		P->x[2] = P->x0[2] + P->v_eff[2]*dt;
+	}
+
+	ierr = PetscFree(out); CHKERRQ(ierr);
+
+	// check halo coverage on all processors
+	if(ISParallel(PETSC_COMM_WORLD))
+	{
+		ierr = MPI_Allreduce(&lmiss, nmiss, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD); CHKERRQ(ierr);
+	}
+	else
+	{
+		(*nmiss) = lmiss;
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
@@ -15,6 +15,7 @@
 //-----------------------------------------------------------------------------
 
 struct FDSTAG;
+struct Discret1D;
 struct JacRes;
 struct AdvCtx;
 
@@ -69,6 +70,27 @@ struct AdvVelCtx
 
 };
 
+//-----------------------------------------------------------------------------
+// Wide-halo velocity context. Velocity grids are extended by the boundary
+// ghost points and imported with a halo that covers the CFL-bounded marker
+// displacement, so that all Runge-Kutta stages are evaluated locally and
+// markers are exchanged only once per time step (in ADVExchange). If any
+// stage position is not covered by the halo, the step falls back to the
+// marker exchange between the stages. Only STAG interpolation is supported.
+//-----------------------------------------------------------------------------
+
+struct AdvVelHalo
+{
+	DM           DA_X, DA_Y, DA_Z;  // velocity grids (+ 1 layer of boundary ghost points, wide stencil)
+	Vec          gvx, gvy, gvz;     // global velocity vectors
+	Vec          lvx, lvy, lvz;     // local velocity vectors (wide halo)
+	PetscInt     width;             // halo width (cells)
+	PetscInt     lo[3], hi[3];      // global index range of host cells covered by the halo
+	PetscScalar *ncx, *ncy, *ncz;   // global node coordinates (+ 1 layer of ghost points)
+	PetscScalar *ccx, *ccy, *ccz;   // global cell coordinates (+ 1 layer of ghost points)
+	PetscScalar *cbuff;             // coordinate buffer
+};
+
 //-----------------------------------------------------------------------------
 // main routines
 //-----------------------------------------------------------------------------
@@ -107,6 +129,17 @@ PetscErrorCode ADVelCollectGarbage (AdvVelCtx *vi);
 PetscErrorCode ADVelReAllocStorage (AdvVelCtx *vi, PetscInt nmark);
 PetscErrorCode ADVelMapMarkToCells (AdvVelCtx *vi);
 
+// wide-halo advection
+PetscErrorCode ADVelHaloCreate       (AdvCtx *actx);
+PetscErrorCode ADVelHaloDestroy      (AdvCtx *actx);
+PetscErrorCode ADVelHaloCreateDA     (DM da, PetscInt w, DM *dae);
+PetscErrorCode ADVelHaloGetRange     (DM daf, DM dac, PetscInt dir, PetscInt *lo, PetscInt *hi);
+PetscErrorCode ADVelHaloFill         (DM da, Vec lv, DM dae, Vec gve);
+PetscErrorCode ADVelHaloGatherCoord  (Discret1D *ds, PetscScalar *ncoor, PetscScalar *ccoor);
+PetscErrorCode ADVelHaloUpdate       (AdvCtx *actx);
+PetscErrorCode ADVelHaloInterp       (AdvVelCtx *vi, PetscInt *out, PetscInt *nmiss);
+PetscErrorCode ADVelAdvectHalo       (AdvCtx *actx, AdvVelCtx *vi, PetscScalar dt, PetscInt *nmiss);
+
 // velocity interpolation
 PetscErrorCode ADVelInterpMain       (AdvVelCtx *vi);
 PetscErrorCode ADVelInterpSTAG       (AdvVelCtx *vi);
@@ -180,4 +213,149 @@ static inline PetscScalar InterpLinMinmod(
 	return X;
 }
 //-----------------------------------------------------------------------------
+// Velocity stencil of a host cell. Staggered velocities that can be reached
+// by trilinear interpolation from any point inside the cell are loaded once,
+// all markers of the cell are then interpolated from the stencil in a block.
+// Results are identical to InterpLin3D (same operations & summation order).
+//-----------------------------------------------------------------------------
+
+struct VelStencil
+{
+	PetscScalar vx[3][3][2]; // x-velocity [K-1:K+1][J-1:J+1][I:I+1]
+	PetscScalar vy[3][2][3]; // y-velocity [K-1:K+1][J:J+1][I-1:I+1]
+	PetscScalar vz[2][3][3]; // z-velocity [K:K+1][J-1:J+1][I-1:I+1]
+	PetscScalar nx[2], ny[2], nz[2]; // node coordinates  [I:I+1]
+	PetscScalar cx[3], cy[3], cz[3]; // cell coordinates  [I-1:I+1]
+};
+
+//-----------------------------------------------------------------------------
+static inline void VelStencilLoad(
+	VelStencil   *st,
+	PetscScalar ***lvx,
+	PetscScalar ***lvy,
+	PetscScalar ***lvz,
+	PetscInt      I,
+	PetscInt      J,
+	PetscInt      K,
+	PetscInt      sx,
+	PetscInt      sy,
+	PetscInt      sz,
+	PetscScalar  *ncx,
+	PetscScalar  *ncy,
+	PetscScalar  *ncz,
+	PetscScalar  *ccx,
+	PetscScalar  *ccy,
+	PetscScalar  *ccz)
+{
+	// load velocity stencil & coordinates of a cell (I, J, K - local cell indices)
+	PetscInt i, j, k;
+
+	for(k = 0; k < 3; k++)
+	for(j = 0; j < 3; j++)
+	for(i = 0; i < 2; i++)
+	{
+		st->vx[k][j][i] = lvx[sz+K-1+k][sy+J-1+j][sx+I  +i];
+		st->vy[k][i][j] = lvy[sz+K-1+k][sy+J  +i][sx+I-1+j];
+		st->vz[i][k][j] = lvz[sz+K  +i][sy+J-1+k][sx+I-1+j];
+	}
+
+	for(i = 0; i < 2; i++)
+	{
+		st->nx[i] = ncx[I+i];
+		st->ny[i] = ncy[J+i];
+		st->nz[i] = ncz[K+i];
+	}
+
+	for(i = 0; i < 3; i++)
+	{
+		st->cx[i] = ccx[I-1+i];
+		st->cy[i] = ccy[J-1+i];
+		st->cz[i] = ccz[K-1+i];
+	}
+}
+//-----------------------------------------------------------------------------
+static inline PetscScalar InterpLinStencil(
+	const PetscScalar *a,
+	PetscInt           dj,
+	PetscInt           dk,
+	PetscScalar        xe,
+	PetscScalar        ye,
+	PetscScalar        ze)
+{
+	// trilinear interpolation in a stencil block (dj, dk - strides)
+	PetscScalar xb, yb, zb;
+
+	xb = 1.0 - xe;
+	yb = 1.0 - ye;
+	zb = 1.0 - ze;
+
+	return
+	a[0      ]*xb*yb*zb +
+	a[1      ]*xe*yb*zb +
+	a[dj     ]*xb*ye*zb +
+	a[dj+1   ]*xe*ye*zb +
+	a[dk     ]*xb*yb*ze +
+	a[dk+1   ]*xe*yb*ze +
+	a[dk+dj  ]*xb*ye*ze +
+	a[dk+dj+1]*xe*ye*ze;
+}
+//-----------------------------------------------------------------------------
+static inline void VelStencilInterp(
+	VelStencil  *st,
+	PetscInt     n,
+	PetscScalar *xp,
+	PetscScalar *yp,
+	PetscScalar *zp,
+	PetscScalar *vx,
+	PetscScalar *vy,
+	PetscScalar *vz)
+{
+	// interpolate velocities to a block of points inside the cell
+	// relative coordinates are shared between the velocity components
+	PetscInt    i, ox, oy, oz;
+	PetscScalar xn, yn, zn, xc, yc, zc;
+
+	for(i = 0; i < n; i++)
+	{
+		// map point on the cells of X, Y, Z grids
+		ox = (xp[i] > st->cx[1]);
+		oy = (yp[i] > st->cy[1]);
+		oz = (zp[i] > st->cz[1]);
+
+		// relative coordinates w.r.t. nodes & cell centers
+		xn = (xp[i] - st->nx[0])/(st->nx[1] - st->nx[0]);
+		yn = (yp[i] - st->ny[0])/(st->ny[1] - st->ny[0]);
+		zn = (zp[i] - st->nz[0])/(st->nz[1] - st->nz[0]);
+
+		xc = (xp[i] - st->cx[ox])/(st->cx[ox+1] - st->cx[ox]);
+		yc = (yp[i] - st->cy[oy])/(st->cy[oy+1] - st->cy[oy]);
+		zc = (zp[i] - st->cz[oz])/(st->cz[oz+1] - st->cz[oz]);
+
+		vx[i] = InterpLinStencil(&st->vx[oz][oy][0],  2, 6, xn, yc, zc);
+		vy[i] = InterpLinStencil(&st->vy[oz][0][ox],  3, 6, xc, yn, zc);
+		vz[i] = InterpLinStencil(&st->vz[0][oy][ox],  3, 9, xc, yc, zn);
+	}
+}
+//-----------------------------------------------------------------------------
+static inline PetscInt ADVelHaloFindCell(
+	PetscScalar *ncoor,
+	PetscInt     ncels,
+	PetscScalar  x)
+{
+	// find global index of a cell containing point (binary search)
+	PetscInt L, R, M;
+
+	L = 0;
+	R = ncels;
+
+	while((R - L) > 1)
+	{
+		M = (L + R)/2;
+		if(ncoor[M] <= x) L = M;
+		else              R = M;
+	}
+
+	return L;
+}
+//-----------------------------------------------------------------------------
 #endif
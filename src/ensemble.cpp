@@ -0,0 +1,265 @@
+/*@ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **
+ **   Project      : LaMEM
+ **   License      : MIT, see LICENSE file for details
+ **   Contributors : Anton Popov, Boris Kaus, see AUTHORS file for complete list
+ **   Organization : Institute of Geosciences, Johannes-Gutenberg University, Mainz
+ **   Contact      : kaus@uni-mainz.de, popov@uni-mainz.de
+ **
+ ** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ @*/
+//---------------------------------------------------------------------------
+//.......................... ENSEMBLE EXECUTION MODE ........................
+//---------------------------------------------------------------------------
+#include "LaMEM.h"
+#include "ensemble.h"
+#include "parsing.h"
+#include "tools.h"
+//---------------------------------------------------------------------------
+static void EnsembleAbort(const char *msg, const char *arg)
+{
+	// PETSc error handling is not available yet
+	fprintf(stderr, "ERROR! %s %s\n", msg, arg);
+
+	MPI_Abort(MPI_COMM_WORLD, 1);
+}
+//---------------------------------------------------------------------------
+int EnsembleCreate(Ensemble *ens, int *argc, char ***argv)
+{
+	FILE          *fp;
+	vector <char*> members;
+	char          *fname, *buff, *line, *next, *end;
+	int            i, nchar, size, rank, ierr;
+
+	memset(ens, 0, sizeof(Ensemble));
+
+	// check whether ensemble mode is requested
+	fname = NULL;
+
+	for(i = 1; i < (*argc)-1; i++)
+	{
+		if(!strcmp((*argv)[i], "-ensemble_file")) fname = (*argv)[i+1];
+	}
+
+	if(!fname) return 0;
+
+	// initialize MPI before PETSc to set PETSC_COMM_WORLD
+	ierr = MPI_Init(argc, argv); if(ierr) return ierr;
+
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	// read ensemble file on first process
+	nchar = 0;
+	buff  = NULL;
+
+	if(!rank)
+	{
+		fp = fopen(fname, "rb");
+
+		if(fp == NULL) EnsembleAbort("Cannot open ensemble file", fname);
+
+		fseek(fp, 0L, SEEK_END);
+
+		nchar = (int)ftell(fp) + 1;
+
+		rewind(fp);
+
+		buff = (char*)malloc((size_t)nchar*sizeof(char));
+
+		if(fread(buff, (size_t)(nchar-1)*sizeof(char), 1, fp) != 1 && nchar > 1)
+		{
+			EnsembleAbort("Cannot read ensemble file", fname);
+		}
+
+		fclose(fp);
+
+		buff[nchar-1] = '\0';
+	}
+
+	// broadcast file contents
+	MPI_Bcast(&nchar, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+	if(rank) buff = (char*)malloc((size_t)nchar*sizeof(char));
+
+	MPI_Bcast(buff, nchar, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+	// collect member option strings (skip empty & comment lines)
+	line = buff;
+
+	while(line)
+	{
+		next = strchr(line, '\n');
+
+		if(next) *next++ = '\0';
+
+		// trim leading & trailing white spaces
+		while(isspace(*line)) line++;
+
+		end = line + strlen(line);
+
+		while(end > line && isspace(end[-1])) *(--end) = '\0';
+
+		if(*line && *line != '#') members.push_back(line);
+
+		line = next;
+	}
+
+	ens->nmemb = (PetscMPIInt)members.size();
+
+	if(!ens->nmemb)     EnsembleAbort("Ensemble file contains no members:", fname);
+	if(ens->nmemb > size) EnsembleAbort("Number of ensemble members exceeds number of processes in", fname);
+
+	// assign contiguous & balanced process groups to members
+	ens->imemb = (PetscMPIInt)(((long long)rank*(long long)ens->nmemb)/(long long)size);
+
+	ierr = MPI_Comm_split(MPI_COMM_WORLD, ens->imemb, rank, &ens->comm); if(ierr) return ierr;
+
+	ens->opts = strdup(members[(size_t)ens->imemb]);
+
+	free(buff);
+
+	// every member sees its own group as the world
+	PETSC_COMM_WORLD = ens->comm;
+
+	return 0;
+}
+//---------------------------------------------------------------------------
+PetscErrorCode EnsembleSetOptions(Ensemble *ens)
+{
+	PetscBool found;
+	char      str[_str_len_];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!ens->nmemb) PetscFunctionReturn(0);
+
+	// add member options (they take priority over the input file)
+	ierr = PetscOptionsInsertString(NULL, ens->opts); CHKERRQ(ierr);
+
+	// restart database location is shared by all members
+	ierr = PetscOptionsGetCheckString("-mode", str, &found); CHKERRQ(ierr);
+
+	if(found && !strcmp(str, "restart"))
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Restart is not supported in ensemble mode (check -mode option)");
+	}
+
+	ierr = PetscOptionsSetValue(NULL, "-nstep_rdb", "0"); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode EnsembleSetOutput(Ensemble *ens, FB *fb)
+{
+	char  name[_str_len_], *str;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!ens->nmemb) PetscFunctionReturn(0);
+
+	ierr = getStringParam(fb, _OPTIONAL_, "out_file_name", name, "output"); CHKERRQ(ierr);
+
+	// append member index to output file name, unless specified explicitly
+	if(!strstr(ens->opts, "-out_file_name"))
+	{
+		asprintf(&str, "%s_m%lld", name, (LLD)ens->imemb);
+
+		ierr = PetscStrncpy(name, str, _str_len_); CHKERRQ(ierr);
+
+		free(str);
+
+		ierr = PetscOptionsSetValue(NULL, "-out_file_name", name); CHKERRQ(ierr);
+	}
+
+	// redirect standard output of the member to log file
+	if(ISRankZero(PETSC_COMM_WORLD))
+	{
+		asprintf(&str, "%s.log", name);
+
+		ens->log = fopen(str, "w");
+
+		if(ens->log == NULL)
+		{
+			SETERRQ(PETSC_COMM_SELF, PETSC_ERR_FILE_OPEN, "Cannot open ensemble member log file %s", str);
+		}
+
+		free(str);
+
+		PETSC_STDOUT = ens->log;
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode EnsembleReport(Ensemble *ens, RunSummary *sum, PetscErrorCode status)
+{
+	PetscMPIInt  i, size, rank, gsize;
+	PetscScalar  loc[6], *all, *mem;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!ens->nmemb) PetscFunctionReturn(0);
+
+	ierr = MPI_Comm_size(ens->comm, &gsize);      CHKERRQ(ierr);
+	ierr = MPI_Comm_size(MPI_COMM_WORLD, &size);  CHKERRQ(ierr);
+	ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank);  CHKERRQ(ierr);
+
+	// pack member summary
+	loc[0] = (PetscScalar)ens->imemb;
+	loc[1] = (PetscScalar)gsize;
+	loc[2] = (PetscScalar)status;
+	loc[3] = (PetscScalar)sum->istep;
+	loc[4] = sum->time;
+	loc[5] = (PetscScalar)sum->wtime;
+
+	all = NULL;
+
+	if(!rank)
+	{
+		ierr = PetscMalloc((size_t)(6*size)*sizeof(PetscScalar), &all); CHKERRQ(ierr);
+	}
+
+	ierr = MPI_Gather(loc, 6, MPIU_SCALAR, all, 6, MPIU_SCALAR, 0, MPI_COMM_WORLD); CHKERRQ(ierr);
+
+	if(!rank)
+	{
+		PetscFPrintf(PETSC_COMM_SELF, stdout, "--------------------------------------------------------------------------\n");
+		PetscFPrintf(PETSC_COMM_SELF, stdout, "Ensemble summary : %lld members on %lld processes \n", (LLD)ens->nmemb, (LLD)size);
+		PetscFPrintf(PETSC_COMM_SELF, stdout, "   member  ranks  status    steps        final time    wall time (sec) \n");
+
+		// first process of every member group reports
+		for(i = 0; i < size; i++)
+		{
+			mem = all + 6*i;
+
+			if(i && mem[0] == all[6*(i-1)]) continue;
+
+			PetscFPrintf(PETSC_COMM_SELF, stdout, "   %6lld %6lld %7lld %8lld  %16g  %16g \n",
+				(LLD)mem[0], (LLD)mem[1], (LLD)mem[2], (LLD)mem[3], mem[4], mem[5]);
+		}
+
+		PetscFPrintf(PETSC_COMM_SELF, stdout, "--------------------------------------------------------------------------\n");
+
+		ierr = PetscFree(all); CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+int EnsembleDestroy(Ensemble *ens)
+{
+	if(!ens->nmemb) return 0;
+
+	if(ens->log) fclose(ens->log);
+
+	free(ens->opts);
+
+	MPI_Comm_free(&ens->comm);
+
+	// MPI was initialized by ensemble, PETSc does not finalize it
+	return MPI_Finalize();
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+/*@ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **
+ **   Project      : LaMEM
+ **   License      : MIT, see LICENSE file for details
+ **   Contributors : Anton Popov, Boris Kaus, see AUTHORS file for complete list
+ **   Organization : Institute of Geosciences, Johannes-Gutenberg University, Mainz
+ **   Contact      : kaus@uni-mainz.de, popov@uni-mainz.de
+ **
+ ** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ @*/
+//---------------------------------------------------------------------------
+//.......................... ENSEMBLE EXECUTION MODE ........................
+//---------------------------------------------------------------------------
+#ifndef __ensemble_h__
+#define __ensemble_h__
+//---------------------------------------------------------------------------
+
+struct FB;
+
+//---------------------------------------------------------------------------
+// Ensemble mode is activated by the -ensemble_file command line option.
+// Every non-empty line of the ensemble file (lines starting with # are
+// ignored) defines one ensemble member by a string of command line options
+// that override the input file parameters, e.g.:
+//
+//    -eta[1] 1e21 -rho[1] 3300
+//    -eta[1] 1e22 -rho[1] 3300
+//
+// The world communicator is split into contiguous groups of processes,
+// one group per member, and PETSC_COMM_WORLD is replaced by the group
+// communicator before PETSc is initialized. Output file names of the members
+// receive a suffix (unless set explicitly), standard output of every member is
+// redirected to a separate log file, and summaries of all members are
+// gathered and printed by the first process in the end.
+//---------------------------------------------------------------------------
+
+struct Ensemble
+{
+	PetscMPIInt  nmemb;  // number of ensemble members (zero if inactive)
+	PetscMPIInt  imemb;  // member index of this process
+	MPI_Comm     comm;   // member communicator
+	char        *opts;   // member options
+	FILE        *log;    // member log file
+};
+
+//---------------------------------------------------------------------------
+
+// read ensemble file & split communicator (must be called before PetscInitialize)
+int EnsembleCreate(Ensemble *ens, int *argc, char ***argv);
+
+// add member options to database (must be called before input file is parsed)
+PetscErrorCode EnsembleSetOptions(Ensemble *ens);
+
+// set member output file names & log file
+PetscErrorCode EnsembleSetOutput(Ensemble *ens, FB *fb);
+
+// gather & print member summaries
+PetscErrorCode EnsembleReport(Ensemble *ens, RunSummary *sum, PetscErrorCode status);
+
+// free communicator & finalize MPI (must be called after PetscFinalize)
+int EnsembleDestroy(Ensemble *ens);
+
+//---------------------------------------------------------------------------
+#endif
@@ -243,8 +243,9 @@ PetscErrorCode Discret1DCreate(
 	// column color
 	ds->color = (PetscMPIInt) color;
 
-	// column communicator
-	ds->comm = MPI_COMM_NULL;
+	// column communicators
+	ds->comm  = MPI_COMM_NULL;
+	ds->rcomm = MPI_COMM_NULL;
 
 	// geometric tolerance
 	ds->gtol = gtol;
@@ -447,6 +448,111 @@ PetscErrorCode Discret1DFreeColumnComm(Discret1D *ds)
 		ds->comm = MPI_COMM_NULL;
 	}
 
+	if(ds->rcomm != MPI_COMM_NULL)
+	{
+		ierr = MPI_Comm_free(&ds->rcomm); CHKERRQ(ierr);
+
+		ds->rcomm = MPI_COMM_NULL;
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode Discret1DColumnExscan(Discret1D *ds, PetscScalar *a, PetscInt n, PetscBool reverse)
+{
+	// Exclusive prefix sum of the array along the processor column.
+	// Replaces chains of point-to-point messages passed rank by rank,
+	// latency grows logarithmically with the number of processors.
+	// Typical use is column integration: compute local partial integrals,
+	// scan them, then add the result as an offset in a local fix-up pass.
+
+	MPI_Comm comm;
+	PetscInt i;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// sequential case
+	if(ds->nproc == 1)
+	{
+		for(i = 0; i < n; i++) a[i] = 0.0;
+
+		PetscFunctionReturn(0);
+	}
+
+	// get communicator
+	if(reverse)
+	{
+		if(ds->rcomm == MPI_COMM_NULL)
+		{
+			ierr = MPI_Comm_split(PETSC_COMM_WORLD, ds->color, ds->nproc - 1 - ds->rank, &ds->rcomm); CHKERRQ(ierr);
+		}
+
+		comm = ds->rcomm;
+	}
+	else
+	{
+		ierr = Discret1DGetColumnComm(ds); CHKERRQ(ierr);
+
+		comm = ds->comm;
+	}
+
+	ierr = MPI_Exscan(MPI_IN_PLACE, a, (PetscMPIInt)n, MPIU_SCALAR, MPI_SUM, comm); CHKERRQ(ierr);
+
+	// result is undefined on the first processor of the scan
+	if((!reverse && ds->rank == 0) || (reverse && ds->rank == ds->nproc - 1))
+	{
+		for(i = 0; i < n; i++) a[i] = 0.0;
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode Discret1DColumnAllreduce(Discret1D *ds, PetscScalar *a, PetscInt n, MPI_Op op)
+{
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// sequential case
+	if(ds->nproc == 1) PetscFunctionReturn(0);
+
+	ierr = Discret1DGetColumnComm(ds); CHKERRQ(ierr);
+
+	ierr = MPI_Allreduce(MPI_IN_PLACE, a, (PetscMPIInt)n, MPIU_SCALAR, op, ds->comm); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode Discret1DExchangeNeighbors(Discret1D *ds, PetscScalar *a, PetscScalar *aprev, PetscScalar *anext, PetscInt n, PetscMPIInt tag)
+{
+	// All processors post receives & sends simultaneously,
+	// no serialization along the processor column.
+
+	MPI_Request req[4];
+	PetscMPIInt nreq;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// sequential case
+	if(ds->nproc == 1) PetscFunctionReturn(0);
+
+	nreq = 0;
+
+	if(ds->grprev != -1)
+	{
+		ierr = MPI_Irecv(aprev, (PetscMPIInt)n, MPIU_SCALAR, ds->grprev, tag, PETSC_COMM_WORLD, &req[nreq++]); CHKERRQ(ierr);
+		ierr = MPI_Isend(a,     (PetscMPIInt)n, MPIU_SCALAR, ds->grprev, tag, PETSC_COMM_WORLD, &req[nreq++]); CHKERRQ(ierr);
+	}
+
+	if(ds->grnext != -1)
+	{
+		ierr = MPI_Irecv(anext, (PetscMPIInt)n, MPIU_SCALAR, ds->grnext, tag, PETSC_COMM_WORLD, &req[nreq++]); CHKERRQ(ierr);
+		ierr = MPI_Isend(a,     (PetscMPIInt)n, MPIU_SCALAR, ds->grnext, tag, PETSC_COMM_WORLD, &req[nreq++]); CHKERRQ(ierr);
+	}
+
+	ierr = MPI_Waitall(nreq, req, MPI_STATUSES_IGNORE); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -635,6 +741,129 @@ PetscErrorCode Discret1DgetMaxInvStep(Discret1D *ds, DM da, Vec gv, PetscInt dir
 
 }
 //---------------------------------------------------------------------------
+PetscErrorCode Discret1DGetBins(Discret1D *ds, PetscInt **bins, PetscInt *nbins)
+{
+	// Bin width is set by the smallest cell (up to 16 bins per average cell),
+	// such that only a few cells overlap any bin of a stretched grid.
+	// Table is not required for uniform grids (NULL is returned).
+	// WARNING! the table must be destroyed after use, and rebuilt after grid change!
+
+	PetscScalar *px, len, dxmin, xb;
+	PetscInt     n, nb, b, c;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	(*bins)  = NULL;
+	(*nbins) = 0;
+
+	if(ds->uniform) PetscFunctionReturn(0);
+
+	n   =  ds->ncels;
+	px  =  ds->ncoor;
+	len =  px[n] - px[0];
+
+	// get minimum cell size
+	dxmin = len;
+
+	for(c = 0; c < n; c++) dxmin = PetscMin(dxmin, px[c+1] - px[c]);
+
+	// get number of bins
+	nb = (PetscInt)PetscCeilReal(len/dxmin);
+
+	if(nb < n)    nb = n;
+	if(nb > 16*n) nb = 16*n;
+
+	ierr = makeIntArray(bins, NULL, nb); CHKERRQ(ierr);
+
+	// store first cell overlapping every bin
+	for(b = 0, c = 0; b < nb; b++)
+	{
+		xb = px[0] + len*(PetscScalar)b/(PetscScalar)nb;
+
+		while(c < n-1 && px[c+1] <= xb) c++;
+
+		(*bins)[b] = c;
+	}
+
+	(*nbins) = nb;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode Discret1DFindPoints(Discret1D *ds, PetscInt np, PetscScalar *x, PetscInt *ID, PetscInt *bins, PetscInt nbins)
+{
+	// Returns the same cell index as Discret1DFindPoint for every point.
+	// Bin gives a starting cell, which is corrected by a short linear walk
+	// (this also makes the result insensitive to round-off in the bin index).
+
+	PetscScalar *px, dx, tol, ibw;
+	PetscInt     n, p, b, c, nerr;
+
+	PetscFunctionBeginUser;
+
+	n   =  ds->ncels;
+	px  =  ds->ncoor;
+	dx  = (px[n] - px[0])/((PetscScalar)n);
+	tol =  ds->gtol*dx;
+
+	// check bounds
+	nerr = 0;
+
+	for(p = 0; p < np; p++)
+	{
+		nerr += (x[p] < px[0] - tol || x[p] > px[n] + tol);
+	}
+
+	if(nerr)
+	{
+		SETERRQ(PETSC_COMM_SELF, PETSC_ERR_USER, "Non-local point cannot be mapped to local cell");
+	}
+
+	if(ds->uniform)
+	{
+		for(p = 0; p < np; p++)
+		{
+			// get cell index
+			c = (PetscInt)PetscFloorReal((x[p] - px[0])/dx);
+
+			// check bounds
+			if(c < 0)   c = 0;
+			if(c > n-1) c = n-1;
+
+			ID[p] = c;
+		}
+	}
+	else
+	{
+		if(!bins)
+		{
+			SETERRQ(PETSC_COMM_SELF, PETSC_ERR_USER, "Lookup table is not set for non-uniform grid");
+		}
+
+		ibw = (PetscScalar)nbins/(px[n] - px[0]);
+
+		for(p = 0; p < np; p++)
+		{
+			// get bin index
+			b = (PetscInt)((x[p] - px[0])*ibw);
+
+			if(b < 0)       b = 0;
+			if(b > nbins-1) b = nbins-1;
+
+			// find largest cell index with left node not exceeding the point
+			c = bins[b];
+
+			while(c > 0   && px[c]   >  x[p]) c--;
+			while(c < n-1 && px[c+1] <= x[p]) c++;
+
+			ID[p] = c;
+		}
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
 PetscErrorCode Discret1DFindPoint(Discret1D *ds, PetscScalar x, PetscInt &ID)
 {
 	// find index of a cell containing point (local points only)
@@ -1055,6 +1284,10 @@ PetscErrorCode FDSTAGReadRestart(FDSTAG *fs, FILE *fp)
 	fs->dsy.comm = MPI_COMM_NULL;
 	fs->dsz.comm = MPI_COMM_NULL;
 
+	fs->dsx.rcomm = MPI_COMM_NULL;
+	fs->dsy.rcomm = MPI_COMM_NULL;
+	fs->dsz.rcomm = MPI_COMM_NULL;
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -78,6 +78,7 @@ struct Discret1D
 
 	PetscMPIInt   color;    // color of processor column in base direction
 	MPI_Comm      comm;     // column communicator
+	MPI_Comm      rcomm;    // column communicator (reverse processor order)
 
 	PetscInt      uniform;  // uniform grid flag
 	PetscInt      periodic; // periodic topology flag
@@ -123,6 +124,18 @@ PetscErrorCode Discret1DGetColumnComm(Discret1D *ds);
 // destroy 1D communicator
 PetscErrorCode Discret1DFreeColumnComm(Discret1D *ds);
 
+// exclusive prefix sum of array along processor column (in-place)
+// reverse = PETSC_FALSE - sum over all previous processors (zero on first processor)
+// reverse = PETSC_TRUE  - sum over all next processors (zero on last processor)
+PetscErrorCode Discret1DColumnExscan(Discret1D *ds, PetscScalar *a, PetscInt n, PetscBool reverse);
+
+// reduction of array along processor column, result is available on all processors (in-place)
+PetscErrorCode Discret1DColumnAllreduce(Discret1D *ds, PetscScalar *a, PetscInt n, MPI_Op op);
+
+// exchange array with previous & next processors in the base direction (non-blocking)
+// receive buffers are not accessed if corresponding neighbor does not exist
+PetscErrorCode Discret1DExchangeNeighbors(Discret1D *ds, PetscScalar *a, PetscScalar *aprev, PetscScalar *anext, PetscInt n, PetscMPIInt tag);
+
 // gather coordinate array on rank zero of PETSC_COMM_WORLD
 // WARNING! the array only exists on rank zero of PETSC_COMM_WORLD
 // WARNING! the array must be destroyed after use!
@@ -137,6 +150,13 @@ PetscErrorCode Discret1DgetMaxInvStep(Discret1D *ds, DM da, Vec gv, PetscInt dir
 // find index of a cell containing point (local points only)
 PetscErrorCode Discret1DFindPoint(Discret1D *ds, PetscScalar x, PetscInt &ID);
 
+// find indices of cells containing a batch of points (local points only)
+// uniform-bin lookup table replaces binary search on non-uniform grids
+PetscErrorCode Discret1DFindPoints(Discret1D *ds, PetscInt np, PetscScalar *x, PetscInt *ID, PetscInt *bins, PetscInt nbins);
+
+// setup uniform-bin lookup table (first cell overlapping every bin)
+PetscErrorCode Discret1DGetBins(Discret1D *ds, PetscInt **bins, PetscInt *nbins);
+
 //---------------------------------------------------------------------------
 
 enum idxtype { IDXNONE, IDXCOUPLED, IDXUNCOUPLED };
@@ -417,6 +417,212 @@ PetscErrorCode InterpYZEdgeCorner(FDSTAG *fs, Vec YZEdge, Vec Corner, InterpFlag
 	ierr = DMDAVecRestoreArray(fs->DA_COR, Corner, &lCorner);  CHKERRQ(ierr);
 
 
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode InterpCenterCornerBlock(FDSTAG *fs, DM da, Vec Center, DM dacor, Vec Corner, PetscInt n, PetscInt *map)
+{
+	PetscInt    i, j, k, f, nx, ny, nz, sx, sy, sz, mx, my, mz, I1, I2, J1, J2, K1, K2;
+	PetscScalar ****lCenter, ****lCorner, *A1, *A2, *A3, *A4, *A5, *A6, *A7, *A8, *C;
+	PetscScalar B1, B2, B3, E1, E2, E3, W1, W2, W3, W4, W5, W6, W7, W8;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access vectors
+	ierr = DMDAVecGetArrayDOF(da,    Center, &lCenter); CHKERRQ(ierr);
+	ierr = DMDAVecGetArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	// set index boundaries in all directions
+	mx = fs->dsx.tnods - 1;
+	my = fs->dsy.tnods - 1;
+	mz = fs->dsz.tnods - 1;
+
+	// interpolate center vectors to corners
+	GET_NODE_RANGE(nx, sx, fs->dsx)
+	GET_NODE_RANGE(ny, sy, fs->dsy)
+	GET_NODE_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		// set index bounds (ghost points are undefined)
+		I1 = i;   if(I1 == mx) I1--;
+		I2 = i-1; if(I2 == -1) I2++;
+		J1 = j;   if(J1 == my) J1--;
+		J2 = j-1; if(J2 == -1) J2++;
+		K1 = k;   if(K1 == mz) K1--;
+		K2 = k-1; if(K2 == -1) K2++;
+
+		// access source values of all components
+		A1 = lCenter[K2][J2][I2];
+		A2 = lCenter[K2][J2][I1];
+		A3 = lCenter[K2][J1][I2];
+		A4 = lCenter[K2][J1][I1];
+		A5 = lCenter[K1][J2][I2];
+		A6 = lCenter[K1][J2][I1];
+		A7 = lCenter[K1][J1][I2];
+		A8 = lCenter[K1][J1][I1];
+		C  = lCorner[k][j][i];
+
+		// get weight coefficients
+		E1 = WEIGHT_NODE(i, sx, fs->dsx); B1 = 1.0 - E1;
+		E2 = WEIGHT_NODE(j, sy, fs->dsy); B2 = 1.0 - E2;
+		E3 = WEIGHT_NODE(k, sz, fs->dsz); B3 = 1.0 - E3;
+
+		W1 = B1*B2*B3; W2 = E1*B2*B3; W3 = B1*E2*B3; W4 = E1*E2*B3;
+		W5 = B1*B2*E3; W6 = E1*B2*E3; W7 = B1*E2*E3; W8 = E1*E2*E3;
+
+		// interpolate all components in 3D cube
+		for(f = 0; f < n; f++)
+		{
+			C[map[f]] += A1[f]*W1 + A2[f]*W2 + A3[f]*W3 + A4[f]*W4
+			+            A5[f]*W5 + A6[f]*W6 + A7[f]*W7 + A8[f]*W8;
+		}
+	}
+	END_STD_LOOP
+
+	// restore access
+	ierr = DMDAVecRestoreArrayDOF(da,    Center, &lCenter); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode InterpXYEdgeCornerBlock(FDSTAG *fs, DM da, Vec XYEdge, DM dacor, Vec Corner, PetscInt n, PetscInt *map)
+{
+	PetscInt    i, j, k, f, nx, ny, nz, sx, sy, sz, mz, K1, K2;
+	PetscScalar ****lXYEdge, ****lCorner, *A1, *A2, *C, B1, E1;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access vectors
+	ierr = DMDAVecGetArrayDOF(da,    XYEdge, &lXYEdge); CHKERRQ(ierr);
+	ierr = DMDAVecGetArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	// set index boundaries in Z direction
+	mz = fs->dsz.tnods - 1;
+
+	// interpolate xy-edge vectors to corners
+	GET_NODE_RANGE(nx, sx, fs->dsx)
+	GET_NODE_RANGE(ny, sy, fs->dsy)
+	GET_NODE_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		// set index bounds
+		K1 = k;   if(K1 == mz) K1--;
+		K2 = k-1; if(K2 == -1) K2++;
+
+		// access source values of all components
+		A1 = lXYEdge[K2][j][i];
+		A2 = lXYEdge[K1][j][i];
+		C  = lCorner[k][j][i];
+
+		// get weight coefficients
+		E1 = WEIGHT_NODE(k, sz, fs->dsz); B1 = 1.0 - E1;
+
+		// interpolate all components along Z-edge
+		for(f = 0; f < n; f++) C[map[f]] += A1[f]*B1 + A2[f]*E1;
+	}
+	END_STD_LOOP
+
+	// restore access
+	ierr = DMDAVecRestoreArrayDOF(da,    XYEdge, &lXYEdge); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode InterpXZEdgeCornerBlock(FDSTAG *fs, DM da, Vec XZEdge, DM dacor, Vec Corner, PetscInt n, PetscInt *map)
+{
+	PetscInt    i, j, k, f, nx, ny, nz, sx, sy, sz, my, J1, J2;
+	PetscScalar ****lXZEdge, ****lCorner, *A1, *A2, *C, B1, E1;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access vectors
+	ierr = DMDAVecGetArrayDOF(da,    XZEdge, &lXZEdge); CHKERRQ(ierr);
+	ierr = DMDAVecGetArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	// set index boundaries in Y direction
+	my = fs->dsy.tnods - 1;
+
+	// interpolate xz-edge vectors to corners
+	GET_NODE_RANGE(nx, sx, fs->dsx)
+	GET_NODE_RANGE(ny, sy, fs->dsy)
+	GET_NODE_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		// set index bounds
+		J1 = j;   if(J1 == my) J1--;
+		J2 = j-1; if(J2 == -1) J2++;
+
+		// access source values of all components
+		A1 = lXZEdge[k][J2][i];
+		A2 = lXZEdge[k][J1][i];
+		C  = lCorner[k][j][i];
+
+		// get weight coefficients
+		E1 = WEIGHT_NODE(j, sy, fs->dsy); B1 = 1.0 - E1;
+
+		// interpolate all components along Y-edge
+		for(f = 0; f < n; f++) C[map[f]] += A1[f]*B1 + A2[f]*E1;
+	}
+	END_STD_LOOP
+
+	// restore access
+	ierr = DMDAVecRestoreArrayDOF(da,    XZEdge, &lXZEdge); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode InterpYZEdgeCornerBlock(FDSTAG *fs, DM da, Vec YZEdge, DM dacor, Vec Corner, PetscInt n, PetscInt *map)
+{
+	PetscInt    i, j, k, f, nx, ny, nz, sx, sy, sz, mx, I1, I2;
+	PetscScalar ****lYZEdge, ****lCorner, *A1, *A2, *C, B1, E1;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access vectors
+	ierr = DMDAVecGetArrayDOF(da,    YZEdge, &lYZEdge); CHKERRQ(ierr);
+	ierr = DMDAVecGetArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
+	// set index boundaries in X direction
+	mx = fs->dsx.tnods - 1;
+
+	// interpolate yz-edge vectors to corners
+	GET_NODE_RANGE(nx, sx, fs->dsx)
+	GET_NODE_RANGE(ny, sy, fs->dsy)
+	GET_NODE_RANGE(nz, sz, fs->dsz)
+
+	START_STD_LOOP
+	{
+		// set index bounds
+		I1 = i;   if(I1 == mx) I1--;
+		I2 = i-1; if(I2 == -1) I2++;
+
+		// access source values of all components
+		A1 = lYZEdge[k][j][I2];
+		A2 = lYZEdge[k][j][I1];
+		C  = lCorner[k][j][i];
+
+		// get weight coefficients
+		E1 = WEIGHT_NODE(i, sx, fs->dsx); B1 = 1.0 - E1;
+
+		// interpolate all components along X-edge
+		for(f = 0; f < n; f++) C[map[f]] += A1[f]*B1 + A2[f]*E1;
+	}
+	END_STD_LOOP
+
+	// restore access
+	ierr = DMDAVecRestoreArrayDOF(da,    YZEdge, &lYZEdge); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArrayDOF(dacor, Corner, &lCorner); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -64,5 +64,27 @@ PetscErrorCode InterpXZEdgeCorner(FDSTAG *fs, Vec XZEdge, Vec Corner, InterpFlag
 
 PetscErrorCode InterpYZEdgeCorner(FDSTAG *fs, Vec YZEdge, Vec Corner, InterpFlags iflag);
 
+//---------------------------------------------------------------------------
+// Block interpolation functions (fused output):
+//
+// center  -> corner   InterpCenterCornerBlock
+// xy-edge -> corner   InterpXYEdgeCornerBlock
+// xz-edge -> corner   InterpXZEdgeCornerBlock
+// yz-edge -> corner   InterpYZEdgeCornerBlock
+//
+// Source & target are stacked (multi-component) local vectors defined on
+// grids with the same layout as the corresponding FDSTAG grids. Source
+// component f is ADDED to target component map[f]. Boundary ghost points
+// are not used (same as use_bound = 0).
+//---------------------------------------------------------------------------
+
+PetscErrorCode InterpCenterCornerBlock(FDSTAG *fs, DM da, Vec Center, DM dacor, Vec Corner, PetscInt n, PetscInt *map);
+
+PetscErrorCode InterpXYEdgeCornerBlock(FDSTAG *fs, DM da, Vec XYEdge, DM dacor, Vec Corner, PetscInt n, PetscInt *map);
+
+PetscErrorCode InterpXZEdgeCornerBlock(FDSTAG *fs, DM da, Vec XZEdge, DM dacor, Vec Corner, PetscInt n, PetscInt *map);
+
+PetscErrorCode InterpYZEdgeCornerBlock(FDSTAG *fs, DM da, Vec YZEdge, DM dacor, Vec Corner, PetscInt n, PetscInt *map);
+
 //---------------------------------------------------------------------------
 #endif
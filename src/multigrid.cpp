@@ -17,6 +17,7 @@
 #include "JacRes.h"
 #include "bc.h"
 #include "tools.h"
+#include "tssolve.h"
 //---------------------------------------------------------------------------
 // * remove hierarchy of grids & bc-objects (use info from fine level)
 // * preallocate all restriction & interpolation operators
@@ -1715,6 +1716,14 @@ PetscErrorCode MGCreate(MG *mg, JacRes *jr)
 	// set boundary constraint restriction flag
 	ierr = PetscOptionsHasName(NULL, NULL, "-gmg_no_restric_bc", &mg->no_restric_bc); CHKERRQ(ierr);
 
+	// set coarse hierarchy reuse tolerance
+	ierr = PetscOptionsGetScalar(NULL, NULL, "-gmg_reuse_tol", &mg->lag_tol, NULL); CHKERRQ(ierr);
+
+	mg->lag_step = -1;
+
+	// set mixed precision smoothing flag
+	ierr = PetscOptionsHasName(NULL, NULL, "-gmg_mixed_precision", &mg->mixed); CHKERRQ(ierr);
+
 	// check multigrid mesh restrictions & get actual number of levels
 	ierr = MGGetNumLevels(mg); CHKERRQ(ierr);
 
@@ -1747,6 +1756,19 @@ PetscErrorCode MGCreate(MG *mg, JacRes *jr)
 		ierr = PCMGSetInterpolation(mg->pc, l, mg->lvls[i].P); CHKERRQ(ierr);
 	}
 
+	// create storage for reference fine viscosity
+	if(mg->lag_tol)
+	{
+		ierr = VecDuplicate(mg->lvls[0].eta, &mg->eta_ref); CHKERRQ(ierr);
+	}
+
+	// allocate single precision level operators
+	if(mg->mixed)
+	{
+		ierr = PetscMalloc(sizeof(MatSP)*(size_t)mg->nlvl, &mg->sp); CHKERRQ(ierr);
+		ierr = PetscMemzero(mg->sp, sizeof(MatSP)*(size_t)mg->nlvl); CHKERRQ(ierr);
+	}
+
 	// set coarse solver setup flag
 	mg->crs_setup = PETSC_FALSE;
 
@@ -1776,6 +1798,12 @@ PetscErrorCode MGDestroy(MG *mg)
 
 	ierr = PetscFree(mg->lvls); CHKERRQ(ierr);
 
+	ierr = VecDestroy(&mg->eta_ref); CHKERRQ(ierr);
+
+	ierr = MGDestroyMixed(mg); CHKERRQ(ierr);
+
+	ierr = PetscFree(mg->sp); CHKERRQ(ierr);
+
 	ierr = PCDestroy(&mg->pc); CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
@@ -1835,11 +1863,20 @@ PetscErrorCode MGSetup(MG *mg, Mat A)
 	// so changing boundary condition would also require re-assembly.
 
 	PetscInt  i;
+	PetscBool reuse;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
 
 	ierr = MGLevelInitEta(mg->lvls, mg->jr); CHKERRQ(ierr);
+
+	// keep coarse hierarchy if fine viscosity did not change significantly
+	ierr = MGCheckReuse(mg, &reuse); CHKERRQ(ierr);
+
+	ierr = PCSetReusePreconditioner(mg->pc, reuse); CHKERRQ(ierr);
+
+	if(reuse) PetscFunctionReturn(0);
+
 	ierr = MGLevelAverageEta(mg->lvls);      CHKERRQ(ierr);
 
 	for(i = 1; i < mg->nlvl; i++)
@@ -1851,6 +1888,9 @@ PetscErrorCode MGSetup(MG *mg, Mat A)
 		ierr = MGLevelSetupProlong (&mg->lvls[i], &mg->lvls[i-1]);                    CHKERRQ(ierr);
 	}
 
+	// restore double precision smoother operators (required by Galerkin products)
+	ierr = MGDestroyMixed(mg); CHKERRQ(ierr);
+
 	// setup coarse grid solver if necessary
 	ierr = MGSetupCoarse(mg, A); CHKERRQ(ierr);
 
@@ -1860,6 +1900,9 @@ PetscErrorCode MGSetup(MG *mg, Mat A)
 	// force setup operators
 	ierr = PCSetUp(mg->pc); CHKERRQ(ierr);
 
+	// replace smoother operators with single precision copies if requested
+	ierr = MGSetupMixed(mg); CHKERRQ(ierr);
+
 	// store matrices in the file if requested
 	ierr = MGDumpMat(mg); CHKERRQ(ierr);
 
@@ -1867,6 +1910,144 @@ PetscErrorCode MGSetup(MG *mg, Mat A)
 
 }
 //---------------------------------------------------------------------------
+PetscErrorCode MGCheckReuse(MG *mg, PetscBool *reuse)
+{
+	// Check whether the coarse hierarchy (restricted viscosity, R & P matrices,
+	// Galerkin coarse operators & coarse solver) can be kept from the previous setup.
+	// Fine cells are grouped in the blocks of the first coarsening step.
+	// Hierarchy is rebuilt if viscosity in any block changed by more than a relative
+	// tolerance, and at the first setup of every time step (boundary conditions).
+
+	MGLevel     *fine;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, I, J, K, refine_y;
+	PetscScalar ***eta, ***eta_ref, deta;
+	PetscBool   *blocks;
+	PetscInt    nbx, nby, nbz, nchanged, gchanged;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	*reuse = PETSC_FALSE;
+
+	// reuse is deactivated or impossible
+	if(!mg->lag_tol || mg->nlvl < 2) PetscFunctionReturn(0);
+
+	fine = mg->lvls;
+
+	if(mg->lag_step == mg->jr->ts->istep)
+	{
+		ierr = DMDAGetCorners(fine->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+		ierr = DMDAGetRefinementFactor(fine->DA_CEN, NULL, &refine_y, NULL); CHKERRQ(ierr);
+
+		// allocate block change flags
+		nbx = nx/2;
+		nby = ny/refine_y;
+		nbz = nz/2;
+
+		ierr = PetscMalloc((size_t)(nbx*nby*nbz)*sizeof(PetscBool), &blocks); CHKERRQ(ierr);
+		ierr = PetscMemzero(blocks, (size_t)(nbx*nby*nbz)*sizeof(PetscBool)); CHKERRQ(ierr);
+
+		ierr = DMDAVecGetArray(fine->DA_CEN, fine->eta,   &eta);     CHKERRQ(ierr);
+		ierr = DMDAVecGetArray(fine->DA_CEN, mg->eta_ref, &eta_ref); CHKERRQ(ierr);
+
+		START_STD_LOOP
+		{
+			// get local block indices
+			I = (i-sx)/2;
+			J = (j-sy)/refine_y;
+			K = (k-sz)/2;
+
+			deta = PetscAbsScalar(eta[k][j][i] - eta_ref[k][j][i])/eta_ref[k][j][i];
+
+			if(deta > mg->lag_tol) blocks[K*nbx*nby + J*nbx + I] = PETSC_TRUE;
+		}
+		END_STD_LOOP
+
+		ierr = DMDAVecRestoreArray(fine->DA_CEN, fine->eta,   &eta);     CHKERRQ(ierr);
+		ierr = DMDAVecRestoreArray(fine->DA_CEN, mg->eta_ref, &eta_ref); CHKERRQ(ierr);
+
+		// count changed blocks
+		nchanged = 0;
+
+		for(i = 0; i < nbx*nby*nbz; i++)
+		{
+			if(blocks[i]) nchanged++;
+		}
+
+		ierr = PetscFree(blocks); CHKERRQ(ierr);
+
+		ierr = MPI_Allreduce(&nchanged, &gchanged, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD); CHKERRQ(ierr);
+
+		if(!gchanged)
+		{
+			*reuse = PETSC_TRUE;
+
+			PetscFunctionReturn(0);
+		}
+	}
+
+	// store reference viscosity of the new hierarchy
+	ierr = VecCopy(fine->eta, mg->eta_ref); CHKERRQ(ierr);
+
+	mg->lag_step = mg->jr->ts->istep;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode MGSetupMixed(MG *mg)
+{
+	// Replace operators of the level smoothers with single precision copies.
+	// Preconditioning matrices (used by point-block smoothers, Galerkin products,
+	// and residual evaluation cached by PCMG at the first setup) remain in double
+	// precision. Coarse grid solver is not affected.
+
+	KSP      ksp;
+	Mat      B;
+	PetscInt l;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!mg->mixed) PetscFunctionReturn(0);
+
+	for(l = 1; l < mg->nlvl; l++)
+	{
+		ierr = PCMGGetSmoother(mg->pc, l, &ksp);   CHKERRQ(ierr);
+		ierr = KSPGetOperators(ksp, NULL, &B);     CHKERRQ(ierr);
+		ierr = MatSPCreate(&mg->sp[l], B);         CHKERRQ(ierr);
+		ierr = KSPSetOperators(ksp, mg->sp[l].A, B); CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode MGDestroyMixed(MG *mg)
+{
+	// restore double precision smoother operators, destroy single precision copies
+
+	KSP      ksp;
+	Mat      B;
+	PetscInt l;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!mg->mixed || !mg->sp) PetscFunctionReturn(0);
+
+	for(l = 1; l < mg->nlvl; l++)
+	{
+		if(!mg->sp[l].A) continue;
+
+		ierr = PCMGGetSmoother(mg->pc, l, &ksp); CHKERRQ(ierr);
+		ierr = KSPGetOperators(ksp, NULL, &B);   CHKERRQ(ierr);
+		ierr = KSPSetOperators(ksp, B, B);       CHKERRQ(ierr);
+		ierr = MatSPDestroy(&mg->sp[l]);         CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
 PetscErrorCode MGApply(PC pc, Vec x, Vec y)
 {
 	MG *mg;
@@ -1910,7 +2091,7 @@ PetscErrorCode MGDumpMat(MG *mg)
 		{
 			// level matrix
 			ierr = PCMGGetSmoother(mg->pc, l, &ksp); CHKERRQ(ierr);
-			ierr = KSPGetOperators(ksp, &A, NULL);   CHKERRQ(ierr);
+			ierr = KSPGetOperators(ksp, NULL, &A);   CHKERRQ(ierr);
 			ierr = MatView(A, viewer);               CHKERRQ(ierr);
 
 			if(l != 0)
@@ -1996,3 +2177,195 @@ PetscErrorCode MGGetNumLevels(MG *mg)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+//...................   SINGLE PRECISION LEVEL OPERATOR   ...................
+//---------------------------------------------------------------------------
+PetscErrorCode MatSPCreate(MatSP *sp, Mat A)
+{
+	Mat             Ad, Ao;
+	Vec             x;
+	IS              is;
+	const PetscInt *garray;
+	PetscInt        m, n, M, N, nghost;
+	PetscBool       flg;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// clear object
+	ierr = PetscMemzero(sp, sizeof(MatSP)); CHKERRQ(ierr);
+
+	// get diagonal & off-diagonal blocks
+	ierr = PetscObjectTypeCompare((PetscObject)A, MATMPIAIJ, &flg); CHKERRQ(ierr);
+
+	if(flg)
+	{
+		ierr = MatMPIAIJGetSeqAIJ(A, &Ad, &Ao, &garray); CHKERRQ(ierr);
+	}
+	else
+	{
+		ierr = PetscObjectTypeCompare((PetscObject)A, MATSEQAIJ, &flg); CHKERRQ(ierr);
+
+		if(!flg)
+		{
+			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "Mixed precision multigrid requires AIJ level matrices");
+		}
+
+		Ad     = A;
+		Ao     = NULL;
+		garray = NULL;
+	}
+
+	// copy diagonal block
+	ierr = MatSPCopyBlock(Ad, &sp->m, &sp->dia, &sp->dja, &sp->da); CHKERRQ(ierr);
+
+	// copy off-diagonal block, create ghost values scatter
+	if(Ao)
+	{
+		ierr = MatSPCopyBlock(Ao, &m, &sp->oia, &sp->oja, &sp->oa); CHKERRQ(ierr);
+
+		// off-diagonal block columns are compressed to ghost indices
+		ierr = MatGetSize(Ao, NULL, &nghost); CHKERRQ(ierr);
+
+		ierr = VecCreateSeq(PETSC_COMM_SELF, nghost, &sp->lvec); CHKERRQ(ierr);
+
+		ierr = ISCreateGeneral(PETSC_COMM_SELF, nghost, garray, PETSC_COPY_VALUES, &is); CHKERRQ(ierr);
+
+		ierr = MatCreateVecs(A, &x, NULL); CHKERRQ(ierr);
+
+		ierr = VecScatterCreate(x, is, sp->lvec, NULL, &sp->sct); CHKERRQ(ierr);
+
+		ierr = VecDestroy(&x); CHKERRQ(ierr);
+
+		ierr = ISDestroy(&is); CHKERRQ(ierr);
+	}
+
+	// create shell matrix
+	ierr = MatGetLocalSize(A, &m, &n); CHKERRQ(ierr);
+	ierr = MatGetSize     (A, &M, &N); CHKERRQ(ierr);
+
+	ierr = MatCreateShell(PetscObjectComm((PetscObject)A), m, n, M, N, (void*)sp, &sp->A); CHKERRQ(ierr);
+	ierr = MatShellSetOperation(sp->A, MATOP_MULT, (void(*)(void))MatSPMult);              CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode MatSPCopyBlock(Mat B, PetscInt *m, PetscInt **ia, PetscInt **ja, float **a)
+{
+	// copy sequential AIJ block to single precision CSR storage
+
+	const PetscInt    *bi, *bj;
+	const PetscScalar *ba;
+	PetscInt           n, nnz, i;
+	PetscBool          done;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = MatGetRowIJ(B, 0, PETSC_FALSE, PETSC_FALSE, &n, &bi, &bj, &done); CHKERRQ(ierr);
+
+	if(!done)
+	{
+		SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot access AIJ matrix structure");
+	}
+
+	nnz = bi[n];
+
+	ierr = PetscMalloc(sizeof(PetscInt)*(size_t)(n+1), ia); CHKERRQ(ierr);
+	ierr = PetscMalloc(sizeof(PetscInt)*(size_t)nnz,   ja); CHKERRQ(ierr);
+	ierr = PetscMalloc(sizeof(float)   *(size_t)nnz,   a);  CHKERRQ(ierr);
+
+	ierr = PetscMemcpy(*ia, bi, sizeof(PetscInt)*(size_t)(n+1)); CHKERRQ(ierr);
+	ierr = PetscMemcpy(*ja, bj, sizeof(PetscInt)*(size_t)nnz);   CHKERRQ(ierr);
+
+	ierr = MatSeqAIJGetArrayRead(B, &ba); CHKERRQ(ierr);
+
+	for(i = 0; i < nnz; i++) (*a)[i] = (float)ba[i];
+
+	ierr = MatSeqAIJRestoreArrayRead(B, &ba); CHKERRQ(ierr);
+
+	ierr = MatRestoreRowIJ(B, 0, PETSC_FALSE, PETSC_FALSE, &n, &bi, &bj, &done); CHKERRQ(ierr);
+
+	*m = n;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode MatSPDestroy(MatSP *sp)
+{
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = MatDestroy       (&sp->A);    CHKERRQ(ierr);
+	ierr = VecScatterDestroy(&sp->sct);  CHKERRQ(ierr);
+	ierr = VecDestroy       (&sp->lvec); CHKERRQ(ierr);
+	ierr = PetscFree(sp->dia);           CHKERRQ(ierr);
+	ierr = PetscFree(sp->dja);           CHKERRQ(ierr);
+	ierr = PetscFree(sp->da);            CHKERRQ(ierr);
+	ierr = PetscFree(sp->oia);           CHKERRQ(ierr);
+	ierr = PetscFree(sp->oja);           CHKERRQ(ierr);
+	ierr = PetscFree(sp->oa);            CHKERRQ(ierr);
+
+	ierr = PetscMemzero(sp, sizeof(MatSP)); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode MatSPMult(Mat A, Vec x, Vec y)
+{
+	// y = A*x, single precision coefficients, double precision accumulation
+
+	MatSP             *sp;
+	const PetscScalar *xa, *la;
+	PetscScalar       *ya, sum;
+	PetscInt           i, k;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = MatShellGetContext(A, (void**)&sp); CHKERRQ(ierr);
+
+	// start receiving ghost values
+	if(sp->sct)
+	{
+		ierr = VecScatterBegin(sp->sct, x, sp->lvec, INSERT_VALUES, SCATTER_FORWARD); CHKERRQ(ierr);
+	}
+
+	ierr = VecGetArrayRead(x, &xa); CHKERRQ(ierr);
+	ierr = VecGetArray    (y, &ya); CHKERRQ(ierr);
+
+	// diagonal block (overlaps ghost exchange)
+	for(i = 0; i < sp->m; i++)
+	{
+		sum = 0.0;
+
+		for(k = sp->dia[i]; k < sp->dia[i+1]; k++) sum += (PetscScalar)sp->da[k]*xa[sp->dja[k]];
+
+		ya[i] = sum;
+	}
+
+	// off-diagonal block
+	if(sp->sct)
+	{
+		ierr = VecScatterEnd(sp->sct, x, sp->lvec, INSERT_VALUES, SCATTER_FORWARD); CHKERRQ(ierr);
+
+		ierr = VecGetArrayRead(sp->lvec, &la); CHKERRQ(ierr);
+
+		for(i = 0; i < sp->m; i++)
+		{
+			sum = 0.0;
+
+			for(k = sp->oia[i]; k < sp->oia[i+1]; k++) sum += (PetscScalar)sp->oa[k]*la[sp->oja[k]];
+
+			ya[i] += sum;
+		}
+
+		ierr = VecRestoreArrayRead(sp->lvec, &la); CHKERRQ(ierr);
+	}
+
+	ierr = VecRestoreArrayRead(x, &xa); CHKERRQ(ierr);
+	ierr = VecRestoreArray    (y, &ya); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
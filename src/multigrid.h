@@ -83,6 +83,36 @@ void getRowProlong(PetscBool scale,
 
 //---------------------------------------------------------------------------
 
+// single precision copy of a level operator (applied by the smoothers)
+
+struct MatSP
+{
+	// Local rows are stored in CSR format separately for the diagonal (owned columns)
+	// and off-diagonal (ghost columns) blocks of the parallel AIJ matrix.
+	// Matrix coefficients are stored in single precision, products are
+	// accumulated in double precision.
+
+	Mat         A;             // shell matrix (MATOP_MULT only)
+	PetscInt    m;             // number of local rows
+	PetscInt   *dia, *dja;     // diagonal block row pointers & column indices
+	float      *da;            // diagonal block coefficients
+	PetscInt   *oia, *oja;     // off-diagonal block row pointers & compressed column indices
+	float      *oa;            // off-diagonal block coefficients
+	VecScatter  sct;           // ghost values scatter
+	Vec         lvec;          // ghost values
+
+};
+
+PetscErrorCode MatSPCreate(MatSP *sp, Mat A);
+
+PetscErrorCode MatSPCopyBlock(Mat B, PetscInt *m, PetscInt **ia, PetscInt **ja, float **a);
+
+PetscErrorCode MatSPDestroy(MatSP *sp);
+
+PetscErrorCode MatSPMult(Mat A, Vec x, Vec y);
+
+//---------------------------------------------------------------------------
+
 struct MG
 {
 	// PETSc level numbering (inverse w.r.t. coarsening sequence):
@@ -106,6 +136,15 @@ struct MG
 	PetscBool crs_setup;     // coarse solver setup flag
 	PetscBool no_restric_bc; // boundary constraint restriction deactivation flag
 
+	// coarse hierarchy reuse (lagging) between nonlinear iterations
+	PetscScalar lag_tol;     // relative fine viscosity change tolerance (0 - rebuild at every setup)
+	PetscInt    lag_step;    // time step of the last full hierarchy setup
+	Vec         eta_ref;     // fine viscosity of the last full hierarchy setup
+
+	// mixed precision smoothing
+	PetscBool   mixed;       // apply smoother operators in single precision
+	MatSP      *sp;          // single precision level operators (PETSc level numbering)
+
 };
 
 //---------------------------------------------------------------------------
@@ -118,6 +157,12 @@ PetscErrorCode MGSetupCoarse(MG *mg, Mat A);
 
 PetscErrorCode MGSetup(MG *mg, Mat A);
 
+PetscErrorCode MGCheckReuse(MG *mg, PetscBool *reuse);
+
+PetscErrorCode MGSetupMixed(MG *mg);
+
+PetscErrorCode MGDestroyMixed(MG *mg);
+
 PetscErrorCode MGApply(PC pc, Vec x, Vec y);
 
 PetscErrorCode MGDumpMat(MG *mg);
@@ -70,6 +70,7 @@ struct ModParam
 	PetscInt 		 par_log10[_MAX_PAR_];				// Is the value indicated log10(par)
 	PetscScalar      grd[_MAX_PAR_];                    // gradient value
 	PetscBool 		 BruteForce_FD;						// indicate whether we compute Brute force FD or not
+	PetscInt 		 FD_InProcess;						// compute Brute force FD gradients in-process (reuse initialized model) rather than by relaunching LaMEM?
 
 	PetscScalar     *val;                               // model value
 	PetscScalar      mfit, mfitCenter;                  // misfit value for current model parameters
@@ -81,6 +82,7 @@ struct ModParam
 	Vec              xini;      	                    // Comparison velocity field for adjoint inversion
 	Vec              P;				                    // vector containing parameters
 	Vec              fcconv;                            // Vector containing all f/fini values to track convergence
+	Vec              psi;                               // adjoint solution of the previous iteration (initial guess of the next adjoint solve)
 	PetscInt         Ab;    		                    // Use adjoint bounds (only works with Tao)?
 	PetscInt         Tao;    		                    // Use TAO?
     PetscInt         ScalLaws;                          // Print scaling laws?
@@ -32,24 +32,6 @@
 //
 // As usual, this isn't documented anywhere !!! Take care of this in future versions.
 //---------------------------------------------------------------------------
-// interpolation function header
-#define COPY_FUNCTION_HEADER \
-	JacRes      *jr; \
-	OutBuf      *outbuf; \
-	FDSTAG      *fs; \
-	Scaling     *scal; \
-	PetscScalar ***buff, cf; \
-	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, iter; \
-	InterpFlags iflag; \
-	PetscErrorCode ierr; \
-	PetscFunctionBeginUser; \
-	jr     = outvec->jr; \
-	outbuf = outvec->outbuf; \
-	fs     = outbuf->fs; \
-	scal   = jr->scal; \
-	iflag.update    = 0; \
-	iflag.use_bound = 0;
-//---------------------------------------------------------------------------
 // access function header
 #define ACCESS_FUNCTION_HEADER \
 	JacRes      *jr; \
@@ -65,21 +47,6 @@
 	iflag.update    = 0; \
 	iflag.use_bound = 0;
 //---------------------------------------------------------------------------
-#define COPY_TO_LOCAL_BUFFER(da, vec, FIELD) \
-	ierr = DMDAGetCorners (da, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr); \
-	ierr = DMDAVecGetArray(da, vec, &buff); CHKERRQ(ierr); \
-	iter = 0; \
-	START_STD_LOOP \
-		FIELD \
-	END_STD_LOOP \
-	ierr = DMDAVecRestoreArray(da, vec, &buff); CHKERRQ(ierr); \
-	LOCAL_TO_LOCAL(da, vec)
-//---------------------------------------------------------------------------
-#define INTERPOLATE_COPY(da, vec, IFUNCT, FIELD, ncomp, dir) \
-	COPY_TO_LOCAL_BUFFER(da, vec, FIELD) \
-	ierr = IFUNCT(fs, vec, outbuf->lbcor, iflag); CHKERRQ(ierr); \
-	if(!iflag.update) { ierr = OutBufPut3DVecComp(outbuf, ncomp, dir, cf, 0.0); CHKERRQ(ierr); }
-//---------------------------------------------------------------------------
 #define INTERPOLATE_ACCESS(vec, IFUNCT, ncomp, dir, shift) \
 	ierr = IFUNCT(outbuf->fs, vec, outbuf->lbcor, iflag); CHKERRQ(ierr); \
 	ierr = OutBufPut3DVecComp(outbuf, ncomp, dir, cf, shift); CHKERRQ(ierr);
@@ -127,107 +94,521 @@ void OutVecCreate(
 	outvec->OutVecWrite = OutVecWrite;
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWritePhase(OutVec* outvec)
+void OutVecCreateFused(
+	OutVec         *outvec,
+	JacRes         *jr,
+	OutBuf         *outbuf,
+	const char     *name,
+	const char     *label,
+	void           (*OutVecFuse)(OutVec*),
+	PetscInt        num,
+	PetscInt       *phase_ID)
 {
-	Material_t  *phases;
-	PetscScalar *phRat, mID;
-	PetscInt     jj, numPhases;
+	// create vector (written from stacked corner buffer)
+	OutVecCreate(outvec, jr, outbuf, name, label, &PVOutWriteFused, num, phase_ID);
 
-	COPY_FUNCTION_HEADER
+	// set defaults
+	outvec->nfc  = 0;
+	outvec->cf   = jr->scal->unit;
+	outvec->sqrt = 0;
 
-	// macro to copy phase parameter to buffer
-	#define GET_PHASE \
-		phRat = jr->svCell[iter++].phRat; \
-		mID = 0.0; \
-		for(jj = 0; jj < numPhases; jj++) \
-			mID += phRat[jj]*(PetscScalar)phases[jj].visID; \
-		buff[k][j][i] = mID;
+	// setup fused components
+	OutVecFuse(outvec);
+}
+//---------------------------------------------------------------------------
+void OutVecAddComp(OutVec *outvec, OutGetCell cen, OutGetEdge xy, OutGetEdge xz, OutGetEdge yz)
+{
+	OutComp *fc;
 
-	// no scaling is necessary for the phase
-	cf = scal->unit;
+	fc = &outvec->fc[outvec->nfc++];
+
+	fc->cen = cen;
+	fc->xy  = xy;
+	fc->xz  = xz;
+	fc->yz  = yz;
+}
+//---------------------------------------------------------------------------
+PetscErrorCode OutVecComputeFused(OutVec *outvecs, PetscInt nvec, PetscInt ib)
+{
+	// evaluate all fused vectors of the batch in a single pass:
+	//    * copy sources to stacked center & edge buffers (one sweep per array)
+	//    * exchange ghost points (once per grid)
+	//    * interpolate to stacked corner buffer (one pass per grid)
+	//    * exchange ghost points of stacked corner buffer
+
+	JacRes      *jr;
+	FDSTAG      *fs;
+	OutBuf      *outbuf;
+	OutVec      *outvec;
+	OutComp     *fc;
+	Vec          lvec;
+	PetscScalar *a;
+	PetscInt     i, c, ic, p, np, dof, ncen, nxy, nxz, nyz;
+	OutVec      *vcen[_max_num_fused_comp_], *vxy[_max_num_fused_comp_], *vxz[_max_num_fused_comp_], *vyz[_max_num_fused_comp_];
+	OutGetCell   gcen[_max_num_fused_comp_];
+	OutGetEdge   gxy [_max_num_fused_comp_],  gxz[_max_num_fused_comp_],  gyz[_max_num_fused_comp_];
+	PetscInt     mcen[_max_num_fused_comp_],  mxy[_max_num_fused_comp_],  mxz[_max_num_fused_comp_],  myz[_max_num_fused_comp_];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access context
+	jr     = outvecs[0].jr;
+	outbuf = outvecs[0].outbuf;
+	fs     = outbuf->fs;
+	dof    = outbuf->nfcor;
+
+	// collect sources of all components in the batch
+	ncen = 0;
+	nxy  = 0;
+	nxz  = 0;
+	nyz  = 0;
+
+	for(i = 0; i < nvec; i++)
+	{
+		outvec = &outvecs[i];
+
+		if(!outvec->nfc || outvec->ibatch != ib) continue;
+
+		for(c = 0; c < outvec->nfc; c++)
+		{
+			fc = &outvec->fc[c];
+			ic =  outvec->icomp + c;
+
+			if(fc->cen) { vcen[ncen] = outvec; gcen[ncen] = fc->cen; mcen[ncen++] = ic; }
+			if(fc->xy)  { vxy [nxy]  = outvec; gxy [nxy]  = fc->xy;  mxy [nxy++]  = ic; }
+			if(fc->xz)  { vxz [nxz]  = outvec; gxz [nxz]  = fc->xz;  mxz [nxz++]  = ic; }
+			if(fc->yz)  { vyz [nyz]  = outvec; gyz [nyz]  = fc->yz;  myz [nyz++]  = ic; }
+		}
+	}
+
+	// clear stacked corner buffer (all sources are accumulated)
+	ierr = VecSet(outbuf->lfcor, 0.0); CHKERRQ(ierr);
+
+	if(ncen)
+	{
+		ierr = DMGetLocalVector       (outbuf->DA_FCEN, &lvec); CHKERRQ(ierr);
+		ierr = OutVecCopyFusedCell    (jr, outbuf->DA_FCEN, lvec, ncen, gcen, vcen); CHKERRQ(ierr);
+		ierr = InterpCenterCornerBlock(fs, outbuf->DA_FCEN, lvec, outbuf->DA_FCOR, outbuf->lfcor, ncen, mcen); CHKERRQ(ierr);
+		ierr = DMRestoreLocalVector   (outbuf->DA_FCEN, &lvec); CHKERRQ(ierr);
+	}
+
+	if(nxy)
+	{
+		ierr = DMGetLocalVector       (outbuf->DA_FXY, &lvec); CHKERRQ(ierr);
+		ierr = OutVecCopyFusedEdge    (fs->DA_XY, outbuf->DA_FXY, lvec, jr->svXYEdge, nxy, gxy, vxy); CHKERRQ(ierr);
+		ierr = InterpXYEdgeCornerBlock(fs, outbuf->DA_FXY, lvec, outbuf->DA_FCOR, outbuf->lfcor, nxy, mxy); CHKERRQ(ierr);
+		ierr = DMRestoreLocalVector   (outbuf->DA_FXY, &lvec); CHKERRQ(ierr);
+	}
 
-	// access material parameters
-	phases    = jr->dbm->phases;
-	numPhases = jr->dbm->numPhases;
+	if(nyz)
+	{
+		ierr = DMGetLocalVector       (outbuf->DA_FYZ, &lvec); CHKERRQ(ierr);
+		ierr = OutVecCopyFusedEdge    (fs->DA_YZ, outbuf->DA_FYZ, lvec, jr->svYZEdge, nyz, gyz, vyz); CHKERRQ(ierr);
+		ierr = InterpYZEdgeCornerBlock(fs, outbuf->DA_FYZ, lvec, outbuf->DA_FCOR, outbuf->lfcor, nyz, myz); CHKERRQ(ierr);
+		ierr = DMRestoreLocalVector   (outbuf->DA_FYZ, &lvec); CHKERRQ(ierr);
+	}
+
+	if(nxz)
+	{
+		ierr = DMGetLocalVector       (outbuf->DA_FXZ, &lvec); CHKERRQ(ierr);
+		ierr = OutVecCopyFusedEdge    (fs->DA_XZ, outbuf->DA_FXZ, lvec, jr->svXZEdge, nxz, gxz, vxz); CHKERRQ(ierr);
+		ierr = InterpXZEdgeCornerBlock(fs, outbuf->DA_FXZ, lvec, outbuf->DA_FCOR, outbuf->lfcor, nxz, mxz); CHKERRQ(ierr);
+		ierr = DMRestoreLocalVector   (outbuf->DA_FXZ, &lvec); CHKERRQ(ierr);
+	}
 
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_PHASE, 1, 0)
+	// scatter ghost points of all corner components at once
+	LOCAL_TO_LOCAL(outbuf->DA_FCOR, outbuf->lfcor)
+
+	// take square root of absolute value (second invariants)
+	ierr = VecGetLocalSize(outbuf->lfcor, &np); CHKERRQ(ierr);
+	ierr = VecGetArray    (outbuf->lfcor, &a);  CHKERRQ(ierr);
+
+	np /= dof;
+
+	for(i = 0; i < nvec; i++)
+	{
+		outvec = &outvecs[i];
+
+		if(!outvec->nfc || outvec->ibatch != ib || !outvec->sqrt) continue;
+
+		for(c = 0; c < outvec->nfc; c++)
+		{
+			ic = outvec->icomp + c;
+
+			for(p = 0; p < np; p++) a[p*dof + ic] = PetscSqrtReal(PetscAbsScalar(a[p*dof + ic]));
+		}
+	}
+
+	ierr = VecRestoreArray(outbuf->lfcor, &a); CHKERRQ(ierr);
+
+	// store evaluated batch
+	outbuf->ifb = ib;
 
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWritePhaseAgg(OutVec* outvec)
+PetscErrorCode OutVecCopyFusedCell(
+	JacRes      *jr,
+	DM           da,
+	Vec          lvec,
+	PetscInt     n,
+	OutGetCell  *get,
+	OutVec     **vec)
 {
-	PetscScalar *phRat, agg;
-	PetscInt     jj, numPhases, *phase_mask;
+	SolVarCell   *svCell;
+	PetscScalar ****buff, *v;
+	PetscInt      i, j, k, f, nx, ny, nz, sx, sy, sz, iter;
 
-	COPY_FUNCTION_HEADER
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
 
-	// macro to copy aggregated phase ratio to buffer
-	#define GET_PHASE_AGG \
-		phRat = jr->svCell[iter++].phRat; \
-		agg   = 0.0; \
-		for(jj = 0; jj < numPhases; jj++) \
-			if(phase_mask[jj]) agg += phRat[jj]; \
-		buff[k][j][i] = agg;
+	ierr = DMDAGetCorners    (jr->fs->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+	ierr = DMDAVecGetArrayDOF(da, lvec, &buff); CHKERRQ(ierr);
 
-	// no scaling is necessary for the phase
-	cf = scal->unit;
+	iter = 0;
+
+	START_STD_LOOP
+	{
+		svCell = &jr->svCell[iter++];
+		v      =  buff[k][j][i];
+
+		// copy all sources
+		for(f = 0; f < n; f++) v[f] = get[f](vec[f], svCell);
+	}
+	END_STD_LOOP
 
-	// access material parameters
-	numPhases  = jr->dbm->numPhases;
-	phase_mask = outvec->phase_mask;
+	ierr = DMDAVecRestoreArrayDOF(da, lvec, &buff); CHKERRQ(ierr);
 
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_PHASE_AGG, 1, 0)
+	LOCAL_TO_LOCAL(da, lvec)
 
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteDensity(OutVec* outvec)
+PetscErrorCode OutVecCopyFusedEdge(
+	DM           daf,
+	DM           da,
+	Vec          lvec,
+	SolVarEdge  *svEdge,
+	PetscInt     n,
+	OutGetEdge  *get,
+	OutVec     **vec)
 {
-	COPY_FUNCTION_HEADER
+	SolVarEdge   *sv;
+	PetscScalar ****buff, *v;
+	PetscInt      i, j, k, f, nx, ny, nz, sx, sy, sz, iter;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
 
-	// macro to copy density to buffer
-	#define GET_DENSITY buff[k][j][i] = jr->svCell[iter++].svBulk.rho;
+	ierr = DMDAGetCorners    (daf, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+	ierr = DMDAVecGetArrayDOF(da, lvec, &buff); CHKERRQ(ierr);
 
-	cf = scal->density;
+	iter = 0;
+
+	START_STD_LOOP
+	{
+		sv = &svEdge[iter++];
+		v  =  buff[k][j][i];
+
+		// copy all sources
+		for(f = 0; f < n; f++) v[f] = get[f](vec[f], sv);
+	}
+	END_STD_LOOP
 
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DENSITY, 1, 0)
+	ierr = DMDAVecRestoreArrayDOF(da, lvec, &buff); CHKERRQ(ierr);
+
+	LOCAL_TO_LOCAL(da, lvec)
 
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteViscTotal(OutVec* outvec)
+PetscErrorCode PVOutWriteFused(OutVec* outvec)
 {
-	COPY_FUNCTION_HEADER
-
-	// macro to copy viscosity to buffer
-	#define GET_VISC_TOTAL buff[k][j][i] = jr->svCell[iter++].svDev.eta;
+	PetscInt c;
 
-	// output viscosity logarithm in GEO-mode
-	// (negative scaling requests logarithmic output)
-	if(scal->utype == _GEO_) cf = -scal->viscosity;
-	else                     cf =  scal->viscosity;
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
 
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_VISC_TOTAL, 1, 0)
+	// components are evaluated in advance (see OutVecComputeFused)
+	for(c = 0; c < outvec->nfc; c++)
+	{
+		ierr = OutBufPutStackedComp(outvec->outbuf, outvec->ncomp, c, outvec->icomp + c, outvec->cf); CHKERRQ(ierr);
+	}
 
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteViscCreep(OutVec* outvec)
+//........................  Fused component sources  ........................
+//---------------------------------------------------------------------------
+// deviatoric stress pre-factor
+#define STRESS_PF(outvec) ((outvec)->jr->ctrl.initGuess ? 0.0 : 2.0)
+//---------------------------------------------------------------------------
+static PetscScalar OutGetPhase(OutVec *outvec, SolVarCell *svCell)
 {
-	COPY_FUNCTION_HEADER
+	Material_t  *phases;
+	PetscScalar  mID;
+	PetscInt     jj, numPhases;
 
-	// macro to copy viscosity to buffer
-	#define GET_VISC_CREEP buff[k][j][i] = jr->svCell[iter++].eta_cr;
+	phases    = outvec->jr->dbm->phases;
+	numPhases = outvec->jr->dbm->numPhases;
+
+	mID = 0.0;
+
+	for(jj = 0; jj < numPhases; jj++) mID += svCell->phRat[jj]*(PetscScalar)phases[jj].visID;
+
+	return mID;
+}
+
+static PetscScalar OutGetPhaseAgg(OutVec *outvec, SolVarCell *svCell)
+{
+	PetscScalar agg;
+	PetscInt    jj, numPhases;
+
+	numPhases = outvec->jr->dbm->numPhases;
+
+	agg = 0.0;
+
+	for(jj = 0; jj < numPhases; jj++) if(outvec->phase_mask[jj]) agg += svCell->phRat[jj];
+
+	return agg;
+}
+
+static PetscScalar OutGetDensity  (OutVec*, SolVarCell *svCell) { return svCell->svBulk.rho;    }
+static PetscScalar OutGetViscTotal(OutVec*, SolVarCell *svCell) { return svCell->svDev.eta;     }
+static PetscScalar OutGetViscCreep(OutVec*, SolVarCell *svCell) { return svCell->eta_cr;        }
+static PetscScalar OutGetCond     (OutVec*, SolVarCell *svCell) { return svCell->svBulk.cond;   }
+static PetscScalar OutGetMF       (OutVec*, SolVarCell *svCell) { return svCell->svBulk.mf;     }
+static PetscScalar OutGetRhoPF    (OutVec*, SolVarCell *svCell) { return svCell->svBulk.rho_pf; }
+static PetscScalar OutGetStAngle  (OutVec*, SolVarCell *svCell) { return svCell->svBulk.phi;    }
+static PetscScalar OutGetATS      (OutVec*, SolVarCell *svCell) { return svCell->ATS;           }
+static PetscScalar OutGetAPS      (OutVec*, SolVarCell *svCell) { return svCell->svDev.APS;     }
+static PetscScalar OutGetYield    (OutVec*, SolVarCell *svCell) { return svCell->yield;         }
+static PetscScalar OutGetDIIdif   (OutVec*, SolVarCell *svCell) { return svCell->DIIdif;        }
+static PetscScalar OutGetDIIdis   (OutVec*, SolVarCell *svCell) { return svCell->DIIdis;        }
+static PetscScalar OutGetDIIprl   (OutVec*, SolVarCell *svCell) { return svCell->DIIprl;        }
+static PetscScalar OutGetDIIpl    (OutVec*, SolVarCell *svCell) { return svCell->DIIpl;         }
+static PetscScalar OutGetDisplX   (OutVec*, SolVarCell *svCell) { return svCell->U[0];          }
+static PetscScalar OutGetDisplY   (OutVec*, SolVarCell *svCell) { return svCell->U[1];          }
+static PetscScalar OutGetDisplZ   (OutVec*, SolVarCell *svCell) { return svCell->U[2];          }
+
+// deviatoric stress
+static PetscScalar OutGetSXX(OutVec *outvec, SolVarCell *svCell) { return svCell->sxx + STRESS_PF(outvec)*svCell->svDev.eta_st*svCell->dxx; }
+static PetscScalar OutGetSYY(OutVec *outvec, SolVarCell *svCell) { return svCell->syy + STRESS_PF(outvec)*svCell->svDev.eta_st*svCell->dyy; }
+static PetscScalar OutGetSZZ(OutVec *outvec, SolVarCell *svCell) { return svCell->szz + STRESS_PF(outvec)*svCell->svDev.eta_st*svCell->dzz; }
+static PetscScalar OutGetSE (OutVec *outvec, SolVarEdge *svEdge) { return svEdge->s   + STRESS_PF(outvec)*svEdge->svDev.eta_st*svEdge->d;   }
+
+// deviatoric strain rate
+static PetscScalar OutGetDXX(OutVec*, SolVarCell *svCell) { return svCell->dxx; }
+static PetscScalar OutGetDYY(OutVec*, SolVarCell *svCell) { return svCell->dyy; }
+static PetscScalar OutGetDZZ(OutVec*, SolVarCell *svCell) { return svCell->dzz; }
+static PetscScalar OutGetDE (OutVec*, SolVarEdge *svEdge) { return svEdge->d;   }
+
+// second invariant contributions (center part includes 1/2 factor)
+static PetscScalar OutGetJ2StressCell(OutVec *outvec, SolVarCell *svCell)
+{
+	PetscScalar s, J2;
+
+	s = OutGetSXX(outvec, svCell); J2  = s*s;
+	s = OutGetSYY(outvec, svCell); J2 += s*s;
+	s = OutGetSZZ(outvec, svCell); J2 += s*s;
+
+	return 0.5*J2;
+}
+
+static PetscScalar OutGetJ2StressEdge(OutVec *outvec, SolVarEdge *svEdge)
+{
+	PetscScalar s = OutGetSE(outvec, svEdge);
+
+	return s*s;
+}
+
+static PetscScalar OutGetJ2StrainRateCell(OutVec*, SolVarCell *svCell)
+{
+	PetscScalar d, J2;
+
+	d = svCell->dxx; J2  = d*d;
+	d = svCell->dyy; J2 += d*d;
+	d = svCell->dzz; J2 += d*d;
+
+	return 0.5*J2;
+}
+
+static PetscScalar OutGetJ2StrainRateEdge(OutVec*, SolVarEdge *svEdge) { return svEdge->d*svEdge->d; }
+
+// shear heating
+static PetscScalar OutGetHrCell(OutVec*, SolVarCell *svCell) { return svCell->svDev.Hr; }
+static PetscScalar OutGetHrEdge(OutVec*, SolVarEdge *svEdge) { return svEdge->svDev.Hr; }
+
+//---------------------------------------------------------------------------
+//......................  Fused components setup  ...........................
+//---------------------------------------------------------------------------
+// NOTE! See warning about component ordering scheme above
+//---------------------------------------------------------------------------
+void PVOutFusePhase(OutVec* outvec)
+{
+	// no scaling is necessary for the phase
+	OutVecAddComp(outvec, &OutGetPhase, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFusePhaseAgg(OutVec* outvec)
+{
+	// no scaling is necessary for the phase
+	OutVecAddComp(outvec, &OutGetPhaseAgg, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseDensity(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->density;
+
+	OutVecAddComp(outvec, &OutGetDensity, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseViscTotal(OutVec* outvec)
+{
+	Scaling *scal = outvec->jr->scal;
 
 	// output viscosity logarithm in GEO-mode
 	// (negative scaling requests logarithmic output)
-	if(scal->utype == _GEO_) cf = -scal->viscosity;
-	else                     cf =  scal->viscosity;
+	if(scal->utype == _GEO_) outvec->cf = -scal->viscosity;
+	else                     outvec->cf =  scal->viscosity;
 
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_VISC_CREEP, 1, 0)
+	OutVecAddComp(outvec, &OutGetViscTotal, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseViscCreep(OutVec* outvec)
+{
+	Scaling *scal = outvec->jr->scal;
 
-	PetscFunctionReturn(0);
+	// output viscosity logarithm in GEO-mode
+	// (negative scaling requests logarithmic output)
+	if(scal->utype == _GEO_) outvec->cf = -scal->viscosity;
+	else                     outvec->cf =  scal->viscosity;
+
+	OutVecAddComp(outvec, &OutGetViscCreep, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseConductivity(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->conductivity;
+
+	OutVecAddComp(outvec, &OutGetCond, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseDevStress(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->stress;
+
+	OutVecAddComp(outvec, &OutGetSXX, NULL,      NULL,      NULL);
+	OutVecAddComp(outvec, NULL,       &OutGetSE, NULL,      NULL);
+	OutVecAddComp(outvec, NULL,       NULL,      &OutGetSE, NULL);
+	OutVecAddComp(outvec, NULL,       &OutGetSE, NULL,      NULL);
+	OutVecAddComp(outvec, &OutGetSYY, NULL,      NULL,      NULL);
+	OutVecAddComp(outvec, NULL,       NULL,      NULL,      &OutGetSE);
+	OutVecAddComp(outvec, NULL,       NULL,      &OutGetSE, NULL);
+	OutVecAddComp(outvec, NULL,       NULL,      NULL,      &OutGetSE);
+	OutVecAddComp(outvec, &OutGetSZZ, NULL,      NULL,      NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseJ2DevStress(OutVec* outvec)
+{
+	outvec->cf   = outvec->jr->scal->stress;
+	outvec->sqrt = 1;
+
+	OutVecAddComp(outvec, &OutGetJ2StressCell, &OutGetJ2StressEdge, &OutGetJ2StressEdge, &OutGetJ2StressEdge);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseStrainRate(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->strain_rate;
+
+	OutVecAddComp(outvec, &OutGetDXX, NULL,      NULL,      NULL);
+	OutVecAddComp(outvec, NULL,       &OutGetDE, NULL,      NULL);
+	OutVecAddComp(outvec, NULL,       NULL,      &OutGetDE, NULL);
+	OutVecAddComp(outvec, NULL,       &OutGetDE, NULL,      NULL);
+	OutVecAddComp(outvec, &OutGetDYY, NULL,      NULL,      NULL);
+	OutVecAddComp(outvec, NULL,       NULL,      NULL,      &OutGetDE);
+	OutVecAddComp(outvec, NULL,       NULL,      &OutGetDE, NULL);
+	OutVecAddComp(outvec, NULL,       NULL,      NULL,      &OutGetDE);
+	OutVecAddComp(outvec, &OutGetDZZ, NULL,      NULL,      NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseJ2StrainRate(OutVec* outvec)
+{
+	outvec->cf   = outvec->jr->scal->strain_rate;
+	outvec->sqrt = 1;
+
+	OutVecAddComp(outvec, &OutGetJ2StrainRateCell, &OutGetJ2StrainRateEdge, &OutGetJ2StrainRateEdge, &OutGetJ2StrainRateEdge);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseMeltFraction(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetMF, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseFluidDensity(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->density;
+
+	OutVecAddComp(outvec, &OutGetRhoPF, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseTotStrain(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetATS, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFusePlastStrain(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetAPS, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFusePlastDissip(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->dissipation_rate;
+
+	OutVecAddComp(outvec, &OutGetHrCell, &OutGetHrEdge, &OutGetHrEdge, &OutGetHrEdge);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseTotDispl(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->length;
+
+	OutVecAddComp(outvec, &OutGetDisplX, NULL, NULL, NULL);
+	OutVecAddComp(outvec, &OutGetDisplY, NULL, NULL, NULL);
+	OutVecAddComp(outvec, &OutGetDisplZ, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseStAngle(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetStAngle, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseYield(OutVec* outvec)
+{
+	outvec->cf = outvec->jr->scal->stress;
+
+	OutVecAddComp(outvec, &OutGetYield, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseRelDIIdif(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetDIIdif, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseRelDIIdis(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetDIIdis, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseRelDIIprl(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetDIIprl, NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------------
+void PVOutFuseRelDIIpl(OutVec* outvec)
+{
+	OutVecAddComp(outvec, &OutGetDIIpl, NULL, NULL, NULL);
 }
 //---------------------------------------------------------------------------
 PetscErrorCode PVOutWriteVelocity(OutVec* outvec)
@@ -275,20 +656,6 @@ PetscErrorCode PVOutWriteGradient(OutVec* outvec)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteStAngle(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy PSD angle to buffer
-	#define GET_STANGLE buff[k][j][i] = jr->svCell[iter++].svBulk.phi;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_STANGLE, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
 PetscErrorCode PVOutWriteTotalPress(OutVec* outvec)
 {
 	PetscScalar pShift, biot;
@@ -379,197 +746,6 @@ PetscErrorCode PVOutWriteTemperature(OutVec* outvec)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteConductivity(OutVec* outvec)
-{
-
-  COPY_FUNCTION_HEADER
-
-	// macros to copy conductivity to buffer  
-        #define GET_COND_CENTER buff[k][j][i] = jr->svCell[iter++].svBulk.cond;
-
-        cf = scal->conductivity;
-	
-        INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_COND_CENTER, 1, 0)
-
-        PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteDevStress(OutVec* outvec)
-{
-	// NOTE! See warning about component ordering scheme above
-
-	SolVarEdge  *svEdge;
-	SolVarCell  *svCell;
-	PetscScalar  pf;
-
-	COPY_FUNCTION_HEADER
-
-	// get pre-factor
-	if(jr->ctrl.initGuess) pf = 0.0;
-	else                   pf = 2.0;
-
-	// macro to copy deviatoric stress components to buffer
-	#define GET_SXX { svCell = &jr->svCell  [iter++]; buff[k][j][i] = svCell->sxx + pf*svCell->svDev.eta_st*svCell->dxx; }
-	#define GET_SYY { svCell = &jr->svCell  [iter++]; buff[k][j][i] = svCell->syy + pf*svCell->svDev.eta_st*svCell->dyy; }
-	#define GET_SZZ { svCell = &jr->svCell  [iter++]; buff[k][j][i] = svCell->szz + pf*svCell->svDev.eta_st*svCell->dzz; }
-	#define GET_SXY { svEdge = &jr->svXYEdge[iter++]; buff[k][j][i] = svEdge->s   + pf*svEdge->svDev.eta_st*svEdge->d;   }
-	#define GET_SYZ { svEdge = &jr->svYZEdge[iter++]; buff[k][j][i] = svEdge->s   + pf*svEdge->svDev.eta_st*svEdge->d;   }
-	#define GET_SXZ { svEdge = &jr->svXZEdge[iter++]; buff[k][j][i] = svEdge->s   + pf*svEdge->svDev.eta_st*svEdge->d;   }
-
-	cf = scal->stress;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_SXX, 9, 0)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_SXY, 9, 1)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_SXZ, 9, 2)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_SXY, 9, 3)
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_SYY, 9, 4)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_SYZ, 9, 5)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_SXZ, 9, 6)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_SYZ, 9, 7)
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_SZZ, 9, 8)
-	
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteJ2DevStress(OutVec* outvec)
-{
-	SolVarCell  *svCell;
-	SolVarEdge  *svEdge;
-	PetscScalar s, J2, pf;
-
-	COPY_FUNCTION_HEADER
-
-	// get pre-factor
-	if(jr->ctrl.initGuess) pf = 0.0;
-	else                   pf = 2.0;
-
-	// macros to copy deviatoric strain rate invariant to buffer
-	#define GET_J2_STRESS_CENTER \
-		svCell = &jr->svCell[iter++]; \
-		s = svCell->sxx + pf*svCell->svDev.eta_st*svCell->dxx; J2  = s*s; \
-		s = svCell->syy + pf*svCell->svDev.eta_st*svCell->dyy; J2 += s*s; \
-		s = svCell->szz + pf*svCell->svDev.eta_st*svCell->dzz; J2 += s*s; \
-		buff[k][j][i] = 0.5*J2;
-
-	#define GET_J2_STRESS_XY_EDGE { svEdge = &jr->svXYEdge[iter++]; s = svEdge->s + pf*svEdge->svDev.eta_st*svEdge->d; buff[k][j][i] = s*s;}
-	#define GET_J2_STRESS_YZ_EDGE { svEdge = &jr->svYZEdge[iter++]; s = svEdge->s + pf*svEdge->svDev.eta_st*svEdge->d; buff[k][j][i] = s*s;}
-	#define GET_J2_STRESS_XZ_EDGE { svEdge = &jr->svXZEdge[iter++]; s = svEdge->s + pf*svEdge->svDev.eta_st*svEdge->d; buff[k][j][i] = s*s;}
-
-	cf = scal->stress;
-
-	iflag.update = 1;
-
-	ierr = VecSet(outbuf->lbcor, 0.0); CHKERRQ(ierr);
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_J2_STRESS_CENTER,  1, 0)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_J2_STRESS_XY_EDGE, 1, 0)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_J2_STRESS_YZ_EDGE, 1, 0)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_J2_STRESS_XZ_EDGE, 1, 0)
-
-	// compute & store second invariant
-	ierr = VecSqrtAbs(outbuf->lbcor); CHKERRQ(ierr);
-
-	ierr = OutBufPut3DVecComp(outbuf, 1, 0, cf, 0.0); CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteStrainRate(OutVec* outvec)
-{
-	// NOTE! See warning about component ordering scheme above
-
-	COPY_FUNCTION_HEADER
-
-	// macro to copy deviatoric strain rate components to buffer
-	#define GET_DXX buff[k][j][i] = jr->svCell[iter++].dxx;
-	#define GET_DYY buff[k][j][i] = jr->svCell[iter++].dyy;
-	#define GET_DZZ buff[k][j][i] = jr->svCell[iter++].dzz;
-	#define GET_DXY buff[k][j][i] = jr->svXYEdge[iter++].d;
-	#define GET_DYZ buff[k][j][i] = jr->svYZEdge[iter++].d;
-	#define GET_DXZ buff[k][j][i] = jr->svXZEdge[iter++].d;
-
-	cf = scal->strain_rate;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DXX, 9, 0)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_DXY, 9, 1)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_DXZ, 9, 2)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_DXY, 9, 3)
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DYY, 9, 4)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_DYZ, 9, 5)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_DXZ, 9, 6)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_DYZ, 9, 7)
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DZZ, 9, 8)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteJ2StrainRate(OutVec* outvec)
-{
-	SolVarCell *svCell;
-	PetscScalar d, J2;
-
-	COPY_FUNCTION_HEADER
-
-	// macros to copy deviatoric strain rate invariant to buffer
-	#define GET_J2_STRAIN_RATE_CENTER \
-		svCell = &jr->svCell[iter++]; \
-		d = svCell->dxx; J2  = d*d; \
-		d = svCell->dyy; J2 += d*d; \
-		d = svCell->dzz; J2 += d*d; \
-		buff[k][j][i] = 0.5*J2;
-
-	#define GET_J2_STRAIN_RATE_XY_EDGE d = jr->svXYEdge[iter++].d; buff[k][j][i] = d*d;
-	#define GET_J2_STRAIN_RATE_YZ_EDGE d = jr->svYZEdge[iter++].d; buff[k][j][i] = d*d;
-	#define GET_J2_STRAIN_RATE_XZ_EDGE d = jr->svXZEdge[iter++].d; buff[k][j][i] = d*d;
-
-	cf = scal->strain_rate;
-
-	iflag.update = 1;
-
-	ierr = VecSet(outbuf->lbcor, 0.0); CHKERRQ(ierr);
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_J2_STRAIN_RATE_CENTER,  1, 0)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_J2_STRAIN_RATE_XY_EDGE, 1, 0)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_J2_STRAIN_RATE_YZ_EDGE, 1, 0)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_J2_STRAIN_RATE_XZ_EDGE, 1, 0)
-
-	// compute & store second invariant
-	ierr = VecSqrtAbs(outbuf->lbcor); CHKERRQ(ierr);
-
-	ierr = OutBufPut3DVecComp(outbuf, 1, 0, cf, 0.0); CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteFluidDensity(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macros to copy fluid density to buffer
-	#define GET_RHOPF_CENTER  buff[k][j][i] = jr->svCell[iter++].svBulk.rho_pf;
-
-	cf = scal->density;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_RHOPF_CENTER,  1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteMeltFraction(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macros to copy melt fraction to buffer
-	#define GET_MF_CENTER  buff[k][j][i] = jr->svCell[iter++].svBulk.mf;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_MF_CENTER,  1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------
 PetscErrorCode PVOutWriteVolRate(OutVec* outvec)
@@ -605,87 +781,6 @@ PetscErrorCode PVOutWriteAngVelMag(OutVec* outvec)
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteTotStrain(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy accumulated total strain (ATS) to buffer
-	#define GET_ATS buff[k][j][i] = jr->svCell[iter++].ATS;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_ATS, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWritePlastStrain(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy accumulated plastic strain (APS) to buffer
-	#define GET_APS buff[k][j][i] = jr->svCell[iter++].svDev.APS;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_APS, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWritePlastDissip(OutVec* outvec)
-{
-	SolVarCell *svCell;
-	SolVarEdge *svEdge;
-	PetscScalar Hr;
-
-	COPY_FUNCTION_HEADER
-
-	// macros to copy shear heating  to buffer
-	#define GET_SHEAR_HEATING_CENTER \
-		svCell = &jr->svCell[iter++];  \
-		Hr = svCell->svDev.Hr; \
-		buff[k][j][i] = Hr;
-
-	#define GET_SHEAR_HEATING_XY_EDGE svEdge = &jr->svXYEdge[iter++]; Hr = svEdge->svDev.Hr; buff[k][j][i] = Hr;
-	#define GET_SHEAR_HEATING_YZ_EDGE svEdge = &jr->svYZEdge[iter++]; Hr = svEdge->svDev.Hr; buff[k][j][i] = Hr;
-	#define GET_SHEAR_HEATING_XZ_EDGE svEdge = &jr->svXZEdge[iter++]; Hr = svEdge->svDev.Hr; buff[k][j][i] = Hr;
-
-	cf = scal->dissipation_rate;
-
-	iflag.update = 1;
-
-	ierr = VecSet(outbuf->lbcor, 0.0); CHKERRQ(ierr);
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_SHEAR_HEATING_CENTER,  1, 0)
-	INTERPOLATE_COPY(fs->DA_XY,  outbuf->lbxy,  InterpXYEdgeCorner, GET_SHEAR_HEATING_XY_EDGE, 1, 0)
-	INTERPOLATE_COPY(fs->DA_YZ,  outbuf->lbyz,  InterpYZEdgeCorner, GET_SHEAR_HEATING_YZ_EDGE, 1, 0)
-	INTERPOLATE_COPY(fs->DA_XZ,  outbuf->lbxz,  InterpXZEdgeCorner, GET_SHEAR_HEATING_XZ_EDGE, 1, 0)
-
-	ierr = OutBufPut3DVecComp(outbuf, 1, 0, cf, 0.0); CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteTotDispl(OutVec* outvec)
-{
-
-	COPY_FUNCTION_HEADER
-
-	cf = scal->length;
-
-	// macros to copy displacement in cell to buffer
-	#define GET_DISPLX buff[k][j][i] = jr->svCell[iter++].U[0];
-	#define GET_DISPLY buff[k][j][i] = jr->svCell[iter++].U[1];
-	#define GET_DISPLZ buff[k][j][i] = jr->svCell[iter++].U[2];
-
-	INTERPOLATE_COPY(jr->fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DISPLX, 3, 0);
-	INTERPOLATE_COPY(jr->fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DISPLY, 3, 1);
-	INTERPOLATE_COPY(jr->fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DISPLZ, 3, 2);
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
 PetscErrorCode PVOutWriteSHmax(OutVec* outvec)
 {
 	ACCESS_FUNCTION_HEADER
@@ -695,8 +790,8 @@ PetscErrorCode PVOutWriteSHmax(OutVec* outvec)
 	// compute maximum horizontal compressive stress (SHmax) orientation
 	ierr = JacResGetSHmax(jr); CHKERRQ(ierr);
 
-	INTERPOLATE_ACCESS(jr->ldxx, InterpCenterCorner, 3, 0, 0.0)
-	INTERPOLATE_ACCESS(jr->ldyy, InterpCenterCorner, 3, 1, 0.0)
+	INTERPOLATE_ACCESS(jr->lshx, InterpCenterCorner, 3, 0, 0.0)
+	INTERPOLATE_ACCESS(jr->lshy, InterpCenterCorner, 3, 1, 0.0)
 
 	ierr = OutBufZero3DVecComp(outbuf, 3, 2); CHKERRQ(ierr);
 
@@ -712,89 +807,14 @@ PetscErrorCode PVOutWriteEHmax(OutVec* outvec)
 	// compute maximum horizontal extension rate (EHmax) orientation
 	ierr = JacResGetEHmax(jr); CHKERRQ(ierr);
 
-	INTERPOLATE_ACCESS(jr->ldxx, InterpCenterCorner, 3, 0, 0.0)
-	INTERPOLATE_ACCESS(jr->ldyy, InterpCenterCorner, 3, 1, 0.0)
+	INTERPOLATE_ACCESS(jr->lehx, InterpCenterCorner, 3, 0, 0.0)
+	INTERPOLATE_ACCESS(jr->lehy, InterpCenterCorner, 3, 1, 0.0)
 
 	ierr = OutBufZero3DVecComp(outbuf, 3, 2); CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteYield(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy yield stress to buffer
-
-	#define GET_YIELD buff[k][j][i] = jr->svCell[iter++].yield;
-
-	cf = scal->stress;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_YIELD, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteRelDIIdif(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy diffusion creep relative strain rate to buffer
-
-	#define GET_DIIdif buff[k][j][i] = jr->svCell[iter++].DIIdif;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DIIdif, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteRelDIIdis(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy diffusion creep relative strain rate to buffer
-
-	#define GET_DIIdis buff[k][j][i] = jr->svCell[iter++].DIIdis;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DIIdis, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteRelDIIprl(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy diffusion creep relative strain rate to buffer
-
-	#define GET_DIIprl buff[k][j][i] = jr->svCell[iter++].DIIprl;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DIIprl, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
-PetscErrorCode PVOutWriteRelDIIpl(OutVec* outvec)
-{
-	COPY_FUNCTION_HEADER
-
-	// macro to copy plastic relative strain rate to buffer
-
-	#define GET_DIIpl buff[k][j][i] = jr->svCell[iter++].DIIpl;
-
-	cf = scal->unit;
-
-	INTERPOLATE_COPY(fs->DA_CEN, outbuf->lbcen, InterpCenterCorner, GET_DIIpl, 1, 0)
-
-	PetscFunctionReturn(0);
-}
-//---------------------------------------------------------------------------
 // DEBUG VECTORS
 //---------------------------------------------------------------------------
 PetscErrorCode PVOutWriteMomentRes(OutVec* outvec)
@@ -868,21 +888,29 @@ PetscErrorCode PVOutWriteVelocityGr(OutVec* outvec)
 {
 	// NOTE! See warning about component ordering scheme above
 
-	//COPY_FUNCTION_HEADER
 	ACCESS_FUNCTION_HEADER
-//	// macro to copy deviatoric strain rate components to buffer
 
 	cf = scal->strain_rate;
 
-	INTERPOLATE_ACCESS(jr->dvxdx, InterpCenterCorner, 9, 0,0.0)
-	INTERPOLATE_ACCESS(jr->dvxdy, InterpXYEdgeCorner, 9, 1,0.0)
-	INTERPOLATE_ACCESS(jr->dvxdz, InterpXZEdgeCorner, 9, 2,0.0)
-	INTERPOLATE_ACCESS(jr->dvydx, InterpXYEdgeCorner, 9, 3,0.0)
-	INTERPOLATE_ACCESS(jr->dvydy, InterpCenterCorner, 9, 4,0.0)
-	INTERPOLATE_ACCESS(jr->dvydz, InterpYZEdgeCorner, 9, 5,0.0)
-	INTERPOLATE_ACCESS(jr->dvzdx, InterpXZEdgeCorner, 9, 6,0.0)
-	INTERPOLATE_ACCESS(jr->dvzdy, InterpYZEdgeCorner, 9, 7,0.0)
-	INTERPOLATE_ACCESS(jr->dvzdz, InterpCenterCorner, 9, 8,0.0)
+	// compute gradient components one by one in center & edge buffers
+	ierr = JacResGetVelGradComp(jr, 0, 0, outbuf->lbcen); CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbcen, InterpCenterCorner, 9, 0, 0.0)
+	ierr = JacResGetVelGradComp(jr, 0, 1, outbuf->lbxy);  CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbxy,  InterpXYEdgeCorner, 9, 1, 0.0)
+	ierr = JacResGetVelGradComp(jr, 0, 2, outbuf->lbxz);  CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbxz,  InterpXZEdgeCorner, 9, 2, 0.0)
+	ierr = JacResGetVelGradComp(jr, 1, 0, outbuf->lbxy);  CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbxy,  InterpXYEdgeCorner, 9, 3, 0.0)
+	ierr = JacResGetVelGradComp(jr, 1, 1, outbuf->lbcen); CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbcen, InterpCenterCorner, 9, 4, 0.0)
+	ierr = JacResGetVelGradComp(jr, 1, 2, outbuf->lbyz);  CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbyz,  InterpYZEdgeCorner, 9, 5, 0.0)
+	ierr = JacResGetVelGradComp(jr, 2, 0, outbuf->lbxz);  CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbxz,  InterpXZEdgeCorner, 9, 6, 0.0)
+	ierr = JacResGetVelGradComp(jr, 2, 1, outbuf->lbyz);  CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbyz,  InterpYZEdgeCorner, 9, 7, 0.0)
+	ierr = JacResGetVelGradComp(jr, 2, 2, outbuf->lbcen); CHKERRQ(ierr);
+	INTERPOLATE_ACCESS(outbuf->lbcen, InterpCenterCorner, 9, 8, 0.0)
 
 	PetscFunctionReturn(0);
 }
@@ -16,6 +16,8 @@
 
 struct OutBuf;
 struct JacRes;
+struct SolVarCell;
+struct SolVarEdge;
 
 //---------------------------------------------------------------------------
 //...........  Multi-component output vector data structure .................
@@ -23,6 +25,33 @@ struct JacRes;
 
 typedef struct OutVec OutVec;
 
+//---------------------------------------------------------------------------
+// Fused output components
+//
+// Vectors that are obtained directly from the cell & edge solution variables
+// are not evaluated one by one. Every component of such vector is defined by
+// a set of source functions (cell center and/or edges). Sources of all fused
+// components are copied in a single sweep over the svCell & svEdge arrays
+// into stacked (multi-component) buffers, which are interpolated to corners
+// in one batched pass with a single ghost exchange per grid. Corner value of
+// the component is the sum of interpolated values of all its sources (e.g.
+// center & edge contributions of the second invariant). Fused vectors are
+// processed in batches of at most _max_num_fused_comp_ components.
+//---------------------------------------------------------------------------
+
+typedef PetscScalar (*OutGetCell)(OutVec*, SolVarCell*);
+typedef PetscScalar (*OutGetEdge)(OutVec*, SolVarEdge*);
+
+struct OutComp
+{
+	OutGetCell cen; // cell center source
+	OutGetEdge xy;  // xy-edge source
+	OutGetEdge xz;  // xz-edge source
+	OutGetEdge yz;  // yz-edge source
+};
+
+//---------------------------------------------------------------------------
+
 struct OutVec
 {
 	JacRes   *jr;
@@ -31,6 +60,14 @@ struct OutVec
 	char      name      [_str_len_];        // output vector name
 	PetscInt  phase_mask[_max_num_phases_]; // phase mask for phase aggregate
 	PetscErrorCode (*OutVecWrite)(OutVec*); // output function pointer
+
+	// fused components
+	PetscInt    nfc;                 // number of fused components (zero if not fused)
+	OutComp     fc[_max_num_comp_];  // fused component sources
+	PetscScalar cf;                  // scaling coefficient (negative -> logarithmic output)
+	PetscInt    sqrt;                // output square root of absolute value
+	PetscInt    ibatch;              // batch index
+	PetscInt    icomp;               // first component in stacked corner buffer
 };
 
 void OutVecCreate(
@@ -43,13 +80,69 @@ void OutVecCreate(
 	PetscInt        num,       // number of vector components or phases to aggregate
 	PetscInt       *phase_ID); // phase IDs to aggregate
 
+void OutVecCreateFused(
+	OutVec         *outvec,
+	JacRes         *jr,
+	OutBuf         *outbuf,
+	const char     *name,
+	const char     *label,
+	void           (*OutVecFuse)(OutVec*), // fused components setup function
+	PetscInt        num,
+	PetscInt       *phase_ID);
+
+// add fused component (edge sources are optional)
+void OutVecAddComp(OutVec *outvec, OutGetCell cen, OutGetEdge xy, OutGetEdge xz, OutGetEdge yz);
+
+// evaluate one batch of fused vectors in a single pass
+PetscErrorCode OutVecComputeFused(OutVec *outvecs, PetscInt nvec, PetscInt ib);
+
+PetscErrorCode OutVecCopyFusedCell(
+	JacRes      *jr,
+	DM           da,    // stacked center grid
+	Vec          lvec,  // stacked center buffer
+	PetscInt     n,     // number of sources
+	OutGetCell  *get,   // source functions
+	OutVec     **vec);  // source vectors
+
+PetscErrorCode OutVecCopyFusedEdge(
+	DM           daf,   // edge grid
+	DM           da,    // stacked edge grid
+	Vec          lvec,  // stacked edge buffer
+	SolVarEdge  *svEdge,
+	PetscInt     n,     // number of sources
+	OutGetEdge  *get,   // source functions
+	OutVec     **vec);  // source vectors
+
+// write fused vector from stacked corner buffer
+PetscErrorCode PVOutWriteFused(OutVec*);
+
+//---------------------------------------------------------------------------
+// fused components setup functions
+void PVOutFusePhase       (OutVec*);
+void PVOutFusePhaseAgg    (OutVec*);
+void PVOutFuseDensity     (OutVec*);
+void PVOutFuseViscTotal   (OutVec*);
+void PVOutFuseViscCreep   (OutVec*);
+void PVOutFuseConductivity(OutVec*);
+void PVOutFuseDevStress   (OutVec*);
+void PVOutFuseJ2DevStress (OutVec*);
+void PVOutFuseStrainRate  (OutVec*);
+void PVOutFuseJ2StrainRate(OutVec*);
+void PVOutFuseMeltFraction(OutVec*);
+void PVOutFuseFluidDensity(OutVec*);
+void PVOutFuseTotStrain   (OutVec*);
+void PVOutFusePlastStrain (OutVec*);
+void PVOutFusePlastDissip (OutVec*);
+void PVOutFuseTotDispl    (OutVec*);
+void PVOutFuseStAngle     (OutVec*);
+void PVOutFuseYield       (OutVec*);
+void PVOutFuseRelDIIdif   (OutVec*);
+void PVOutFuseRelDIIdis   (OutVec*);
+void PVOutFuseRelDIIprl   (OutVec*);
+void PVOutFuseRelDIIpl    (OutVec*);
+
 //---------------------------------------------------------------------------
 
-PetscErrorCode PVOutWritePhase       (OutVec*);
-PetscErrorCode PVOutWritePhaseAgg    (OutVec*);
-PetscErrorCode PVOutWriteDensity     (OutVec*);
-PetscErrorCode PVOutWriteViscTotal   (OutVec*);
-PetscErrorCode PVOutWriteViscCreep   (OutVec*);
 PetscErrorCode PVOutWriteVelocity    (OutVec*);
 PetscErrorCode PVOutWritePressure    (OutVec*);
 PetscErrorCode PVOutWriteGradient    (OutVec*);
@@ -59,28 +152,11 @@ PetscErrorCode PVOutWriteOverPress   (OutVec*);
 PetscErrorCode PVOutWriteLithoPress  (OutVec*);
 PetscErrorCode PVOutWritePorePress   (OutVec*);
 PetscErrorCode PVOutWriteTemperature (OutVec*);
-PetscErrorCode PVOutWriteConductivity(OutVec*);
-PetscErrorCode PVOutWriteDevStress   (OutVec*);
-PetscErrorCode PVOutWriteJ2DevStress (OutVec*);
-PetscErrorCode PVOutWriteStrainRate  (OutVec*);
-PetscErrorCode PVOutWriteJ2StrainRate(OutVec*);
-PetscErrorCode PVOutWriteMeltFraction(OutVec*);
-PetscErrorCode PVOutWriteFluidDensity(OutVec*);
 PetscErrorCode PVOutWriteVolRate     (OutVec*);
 PetscErrorCode PVOutWriteVorticity   (OutVec*);
 PetscErrorCode PVOutWriteAngVelMag   (OutVec*);
-PetscErrorCode PVOutWriteTotStrain   (OutVec*);
-PetscErrorCode PVOutWritePlastStrain (OutVec*);
-PetscErrorCode PVOutWritePlastDissip (OutVec*);
-PetscErrorCode PVOutWriteTotDispl    (OutVec*);
 PetscErrorCode PVOutWriteSHmax       (OutVec*);
-PetscErrorCode PVOutWriteStAngle     (OutVec*);
 PetscErrorCode PVOutWriteEHmax       (OutVec*);
-PetscErrorCode PVOutWriteYield       (OutVec*);
-PetscErrorCode PVOutWriteRelDIIdif   (OutVec*);
-PetscErrorCode PVOutWriteRelDIIdis   (OutVec*);
-PetscErrorCode PVOutWriteRelDIIprl   (OutVec*);
-PetscErrorCode PVOutWriteRelDIIpl    (OutVec*);
 // === debug vectors ===============================================
 PetscErrorCode PVOutWriteMomentRes   (OutVec*);
 PetscErrorCode PVOutWriteContRes     (OutVec*);
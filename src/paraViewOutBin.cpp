@@ -48,13 +48,114 @@ PetscErrorCode OutBufCreate(OutBuf *outbuf, JacRes *jr)
 	// allocate output buffer
 	ierr = PetscMalloc((size_t)(_max_num_comp_*nx*ny*nz)*sizeof(float), &outbuf->buff); CHKERRQ(ierr);
 
-	// set pointers to center, corner & edge buffers (reuse from JacRes object)
+	// set pointers to center & edge buffers (reuse from JacRes object)
+	// corner buffer is borrowed from DMDA cache during output
 	outbuf->lbcen = jr->ldxx;
-	outbuf->lbcor = jr->lbcor;
+	outbuf->lbcor = NULL;
 	outbuf->lbxy  = jr->ldxy;
 	outbuf->lbxz  = jr->ldxz;
 	outbuf->lbyz  = jr->ldyz;
 
+	// stacked buffers are created with output vectors
+	outbuf->nfb     = 0;
+	outbuf->ifb     = -1;
+	outbuf->nfcor   = 0;
+	outbuf->DA_FCEN = NULL;
+	outbuf->DA_FXY  = NULL;
+	outbuf->DA_FXZ  = NULL;
+	outbuf->DA_FYZ  = NULL;
+	outbuf->DA_FCOR = NULL;
+	outbuf->lfcor   = NULL;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode OutBufCreateFused(OutBuf *outbuf, OutVec *outvecs, PetscInt nvec)
+{
+	// pack fused vectors into batches in the output order,
+	// stacked grids are sized by the largest batch
+
+	OutVec   *outvec;
+	OutComp  *fc;
+	FDSTAG   *fs;
+	PetscInt  i, c, ib, ncor, ncen, nxy, nxz, nyz, mcen, mxy, mxz, myz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs   = outbuf->fs;
+	ib   = 0;
+	ncor = ncen = nxy = nxz = nyz = 0;
+	mcen = mxy  = mxz = myz = 0;
+
+	for(i = 0; i < nvec; i++)
+	{
+		outvec = &outvecs[i];
+
+		if(!outvec->nfc) continue;
+
+		// start new batch
+		if(ncor + outvec->nfc > _max_num_fused_comp_)
+		{
+			ib++;
+			ncor = ncen = nxy = nxz = nyz = 0;
+		}
+
+		outvec->ibatch = ib;
+		outvec->icomp  = ncor;
+
+		// count sources
+		for(c = 0; c < outvec->nfc; c++)
+		{
+			fc = &outvec->fc[c];
+
+			if(fc->cen) ncen++;
+			if(fc->xy)  nxy++;
+			if(fc->xz)  nxz++;
+			if(fc->yz)  nyz++;
+		}
+
+		ncor += outvec->nfc;
+
+		outbuf->nfb   = ib + 1;
+		outbuf->nfcor = PetscMax(outbuf->nfcor, ncor);
+
+		mcen = PetscMax(mcen, ncen);
+		mxy  = PetscMax(mxy,  nxy);
+		mxz  = PetscMax(mxz,  nxz);
+		myz  = PetscMax(myz,  nyz);
+	}
+
+	if(!outbuf->nfb) PetscFunctionReturn(0);
+
+	// create stacked grids
+	if(mcen) { ierr = OutBufCreateStackedDMDA(fs->DA_CEN, mcen, &outbuf->DA_FCEN); CHKERRQ(ierr); }
+	if(mxy)  { ierr = OutBufCreateStackedDMDA(fs->DA_XY,  mxy,  &outbuf->DA_FXY);  CHKERRQ(ierr); }
+	if(mxz)  { ierr = OutBufCreateStackedDMDA(fs->DA_XZ,  mxz,  &outbuf->DA_FXZ);  CHKERRQ(ierr); }
+	if(myz)  { ierr = OutBufCreateStackedDMDA(fs->DA_YZ,  myz,  &outbuf->DA_FYZ);  CHKERRQ(ierr); }
+
+	ierr = OutBufCreateStackedDMDA(fs->DA_COR, outbuf->nfcor, &outbuf->DA_FCOR); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode OutBufCreateStackedDMDA(DM da, PetscInt dof, DM *sda)
+{
+	PetscInt        M, N, P, m, n, p, s;
+	const PetscInt *lx, *ly, *lz;
+	DMBoundaryType  bx, by, bz;
+	DMDAStencilType st;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = DMDAGetInfo(da, NULL, &M, &N, &P, &m, &n, &p, NULL, &s, &bx, &by, &bz, &st); CHKERRQ(ierr);
+
+	ierr = DMDAGetOwnershipRanges(da, &lx, &ly, &lz); CHKERRQ(ierr);
+
+	ierr = DMDACreate3dSetUp(PETSC_COMM_WORLD,
+		bx, by, bz, st, M, N, P, m, n, p, dof, s, lx, ly, lz, sda); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -66,6 +167,13 @@ PetscErrorCode OutBufDestroy(OutBuf *outbuf)
 	// free output buffer
 	ierr = PetscFree(outbuf->buff); CHKERRQ(ierr);
 
+	// destroy stacked grids
+	ierr = DMDestroy(&outbuf->DA_FCEN); CHKERRQ(ierr);
+	ierr = DMDestroy(&outbuf->DA_FXY);  CHKERRQ(ierr);
+	ierr = DMDestroy(&outbuf->DA_FXZ);  CHKERRQ(ierr);
+	ierr = DMDestroy(&outbuf->DA_FYZ);  CHKERRQ(ierr);
+	ierr = DMDestroy(&outbuf->DA_FCOR); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -200,6 +308,74 @@ PetscErrorCode OutBufPut3DVecComp(
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+PetscErrorCode OutBufPutStackedComp(
+	OutBuf      *outbuf,
+	PetscInt     ncomp,  // number of components
+	PetscInt     dir,    // component identifier
+	PetscInt     icomp,  // component in stacked buffer
+	PetscScalar  cf)     // scaling coefficient
+{
+	// put component of stacked corner buffer to output buffer
+	// (ghost points are scattered in advance for all components)
+
+	FDSTAG       *fs;
+	float        *buff;
+	PetscScalar ****arr;
+	PetscInt      i, j, k, rx, ry, rz, sx, sy, sz, nx, ny, nz, cnt;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access grid layout & buffer
+	fs   = outbuf->fs;
+	buff = outbuf->buff;
+
+	// access stacked buffer vector
+	ierr = DMDAVecGetArrayDOF(outbuf->DA_FCOR, outbuf->lfcor, &arr); CHKERRQ(ierr);
+
+	// get sub-domain ranks, starting node IDs, and number of nodes
+	GET_OUTPUT_RANGE(rx, nx, sx, fs->dsx)
+	GET_OUTPUT_RANGE(ry, ny, sy, fs->dsy)
+	GET_OUTPUT_RANGE(rz, nz, sz, fs->dsz)
+
+	// set counter
+	cnt = dir;
+
+	// copy vector component to buffer
+	if(cf < 0.0)
+	{
+		// negative scaling -> logarithmic output
+		cf = -cf;
+
+		START_STD_LOOP
+		{
+			buff[cnt] = (float) PetscLog10Real(cf*arr[k][j][i][icomp]);
+
+			cnt += ncomp;
+		}
+		END_STD_LOOP
+	}
+	else
+	{
+		// positive scaling -> standard output
+		START_STD_LOOP
+		{
+			buff[cnt] = (float) (cf*arr[k][j][i][icomp]);
+
+			cnt += ncomp;
+		}
+		END_STD_LOOP
+	}
+
+	// restore access
+	ierr = DMDAVecRestoreArrayDOF(outbuf->DA_FCOR, outbuf->lfcor, &arr); CHKERRQ(ierr);
+
+	// update number of elements in the buffer
+	outbuf->cn += nx*ny*nz;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
 PetscErrorCode OutBufZero3DVecComp(
 	OutBuf      *outbuf,
 	PetscInt     ncomp,  // number of components
@@ -491,10 +667,10 @@ PetscErrorCode PVOutCreateData(PVOut *pvout)
 	ierr = PetscMalloc(sizeof(OutVec)*(size_t)pvout->nvec, &pvout->outvecs); CHKERRQ(ierr);
 	ierr = PetscMemzero(pvout->outvecs, sizeof(OutVec)*(size_t)pvout->nvec); CHKERRQ(ierr);
 
-	if(omask->phase)          OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "phase",          scal->lbl_unit,             &PVOutWritePhase,        1, NULL);
-	if(omask->density)        OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "density",        scal->lbl_density,          &PVOutWriteDensity,      1, NULL);
-	if(omask->visc_total)     OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "visc_total",     scal->lbl_viscosity,        &PVOutWriteViscTotal,    1, NULL);
-	if(omask->visc_creep)     OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "visc_creep",     scal->lbl_viscosity,        &PVOutWriteViscCreep,    1, NULL);
+	if(omask->phase)          OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "phase",          scal->lbl_unit,             &PVOutFusePhase,        1, NULL);
+	if(omask->density)        OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "density",        scal->lbl_density,          &PVOutFuseDensity,      1, NULL);
+	if(omask->visc_total)     OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "visc_total",     scal->lbl_viscosity,        &PVOutFuseViscTotal,    1, NULL);
+	if(omask->visc_creep)     OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "visc_creep",     scal->lbl_viscosity,        &PVOutFuseViscCreep,    1, NULL);
 	if(omask->velocity)       OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "velocity",       scal->lbl_velocity,         &PVOutWriteVelocity,     3, NULL);
 	if(omask->pressure)       OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "pressure",       scal->lbl_stress,           &PVOutWritePressure,     1, NULL);
 	if(omask->tot_pressure)   OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "total_pressure", scal->lbl_stress,           &PVOutWriteTotalPress,   1, NULL);
@@ -504,29 +680,29 @@ PetscErrorCode PVOutCreateData(PVOut *pvout)
 	if(omask->litho_press)    OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "litho_press",    scal->lbl_stress,           &PVOutWriteLithoPress,   1, NULL);
 	if(omask->pore_press)     OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "pore_press",     scal->lbl_stress,           &PVOutWritePorePress,    1, NULL);
 	if(omask->temperature)    OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "temperature",    scal->lbl_temperature,      &PVOutWriteTemperature,  1, NULL);
-	if(omask->conductivity)   OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "conductivity",   scal->lbl_conductivity,     &PVOutWriteConductivity, 1, NULL);
-	if(omask->dev_stress)     OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "dev_stress",     scal->lbl_stress,           &PVOutWriteDevStress,    9, NULL);
-	if(omask->strain_rate)    OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "strain_rate",    scal->lbl_strain_rate,      &PVOutWriteStrainRate,   9, NULL);
-	if(omask->j2_dev_stress)  OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "j2_dev_stress",  scal->lbl_stress,           &PVOutWriteJ2DevStress,  1, NULL);
-	if(omask->j2_strain_rate) OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "j2_strain_rate", scal->lbl_strain_rate,      &PVOutWriteJ2StrainRate, 1, NULL);
+	if(omask->conductivity)   OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "conductivity",   scal->lbl_conductivity,     &PVOutFuseConductivity, 1, NULL);
+	if(omask->dev_stress)     OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "dev_stress",     scal->lbl_stress,           &PVOutFuseDevStress,    9, NULL);
+	if(omask->strain_rate)    OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "strain_rate",    scal->lbl_strain_rate,      &PVOutFuseStrainRate,   9, NULL);
+	if(omask->j2_dev_stress)  OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "j2_dev_stress",  scal->lbl_stress,           &PVOutFuseJ2DevStress,  1, NULL);
+	if(omask->j2_strain_rate) OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "j2_strain_rate", scal->lbl_strain_rate,      &PVOutFuseJ2StrainRate, 1, NULL);
 	if(omask->vol_rate)       OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "vol_rate",       scal->lbl_strain_rate,      &PVOutWriteVolRate,      1, NULL);
 	if(omask->vorticity)      OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "vorticity",      scal->lbl_strain_rate,      &PVOutWriteVorticity,    3, NULL);
 	if(omask->ang_vel_mag)    OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "ang_vel_mag",    scal->lbl_angular_velocity, &PVOutWriteAngVelMag,    1, NULL);
-	if(omask->tot_strain)     OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "tot_strain",     scal->lbl_unit,             &PVOutWriteTotStrain,    1, NULL);
-	if(omask->plast_strain)   OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "plast_strain",   scal->lbl_unit,             &PVOutWritePlastStrain,  1, NULL);
-	if(omask->plast_dissip)   OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "plast_dissip",   scal->lbl_dissipation_rate, &PVOutWritePlastDissip,  1, NULL);
-	if(omask->tot_displ)      OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "tot_displ",      scal->lbl_length,           &PVOutWriteTotDispl,     3, NULL);
+	if(omask->tot_strain)     OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "tot_strain",     scal->lbl_unit,             &PVOutFuseTotStrain,    1, NULL);
+	if(omask->plast_strain)   OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "plast_strain",   scal->lbl_unit,             &PVOutFusePlastStrain,  1, NULL);
+	if(omask->plast_dissip)   OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "plast_dissip",   scal->lbl_dissipation_rate, &PVOutFusePlastDissip,  1, NULL);
+	if(omask->tot_displ)      OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "tot_displ",      scal->lbl_length,           &PVOutFuseTotDispl,     3, NULL);
 	if(omask->SHmax)          OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "SHmax",          scal->lbl_unit,             &PVOutWriteSHmax,        3, NULL);
-	if(omask->StAngle)        OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "StAngle",        scal->lbl_unit,             &PVOutWriteStAngle,      1, NULL);
+	if(omask->StAngle)        OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "StAngle",        scal->lbl_unit,             &PVOutFuseStAngle,      1, NULL);
 	if(omask->EHmax)          OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "EHmax",          scal->lbl_unit,             &PVOutWriteEHmax,        3, NULL);
-	if(omask->yield)          OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "yield",          scal->lbl_stress,           &PVOutWriteYield,        1, NULL);
-	if(omask->DIIdif)         OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "rel_dif_rate",   scal->lbl_unit,             &PVOutWriteRelDIIdif,    1, NULL);
-	if(omask->DIIdis)         OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "rel_dis_rate",   scal->lbl_unit,             &PVOutWriteRelDIIdis,    1, NULL);
-	if(omask->DIIprl)         OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "rel_prl_rate",   scal->lbl_unit,             &PVOutWriteRelDIIprl,    1, NULL);
-	if(omask->DIIpl)          OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "rel_pl_rate",    scal->lbl_unit,             &PVOutWriteRelDIIpl,     1, NULL);
+	if(omask->yield)          OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "yield",          scal->lbl_stress,           &PVOutFuseYield,        1, NULL);
+	if(omask->DIIdif)         OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "rel_dif_rate",   scal->lbl_unit,             &PVOutFuseRelDIIdif,    1, NULL);
+	if(omask->DIIdis)         OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "rel_dis_rate",   scal->lbl_unit,             &PVOutFuseRelDIIdis,    1, NULL);
+	if(omask->DIIprl)         OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "rel_prl_rate",   scal->lbl_unit,             &PVOutFuseRelDIIprl,    1, NULL);
+	if(omask->DIIpl)          OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "rel_pl_rate",    scal->lbl_unit,             &PVOutFuseRelDIIpl,     1, NULL);
 	// === debugging vectors ===============================================
-	if(omask->melt_fraction)  OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "melt_fraction",  scal->lbl_unit,             &PVOutWriteMeltFraction, 1, NULL);
-	if(omask->fluid_density)  OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "fluid_density",  scal->lbl_density,	      &PVOutWriteFluidDensity, 1, NULL);
+	if(omask->melt_fraction)  OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "melt_fraction",  scal->lbl_unit,             &PVOutFuseMeltFraction, 1, NULL);
+	if(omask->fluid_density)  OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, "fluid_density",  scal->lbl_density,	      &PVOutFuseFluidDensity, 1, NULL);
 	if(omask->moment_res)     OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "moment_res",     scal->lbl_volumetric_force, &PVOutWriteMomentRes,    3, NULL);
 	if(omask->cont_res)       OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "cont_res",       scal->lbl_strain_rate,      &PVOutWriteContRes,      1, NULL);
 	if(omask->energ_res)      OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, "energ_res",      scal->lbl_dissipation_rate, &PVOutWritEnergRes,      1, NULL);
@@ -536,9 +712,12 @@ PetscErrorCode PVOutCreateData(PVOut *pvout)
 	// setup phase aggregate output vectors
 	for(i = 0; i < omask->num_agg; i++)
 	{
-		OutVecCreate(&pvout->outvecs[iter++], jr, outbuf, omask->agg_name[i], scal->lbl_unit, &PVOutWritePhaseAgg, omask->agg_num_phase[i], omask->agg_phase_ID[i]);
+		OutVecCreateFused(&pvout->outvecs[iter++], jr, outbuf, omask->agg_name[i], scal->lbl_unit, &PVOutFusePhaseAgg, omask->agg_num_phase[i], omask->agg_phase_ID[i]);
 	}
 
+	// setup evaluation of fused vectors
+	ierr = OutBufCreateFused(outbuf, pvout->outvecs, pvout->nvec); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -746,14 +925,37 @@ PetscErrorCode PVOutWriteVTR(PVOut *pvout, const char *dirName)
 	OutBufPutCoordVec(outbuf, &fs->dsy, jr->scal->length); OutBufDump(outbuf);
 	OutBufPutCoordVec(outbuf, &fs->dsz, jr->scal->length); OutBufDump(outbuf);
 
+	// borrow corner buffers
+	ierr = DMGetLocalVector(fs->DA_COR, &outbuf->lbcor); CHKERRQ(ierr);
+
+	if(outbuf->nfb)
+	{
+		ierr = DMGetLocalVector(outbuf->DA_FCOR, &outbuf->lfcor); CHKERRQ(ierr);
+	}
+
+	outbuf->ifb = -1;
+
 	for(i = 0; i < pvout->nvec; i++)
 	{
+		// evaluate all fused vectors of the next batch in a single pass
+		if(outvecs[i].nfc && outvecs[i].ibatch != outbuf->ifb)
+		{
+			ierr = OutVecComputeFused(outvecs, pvout->nvec, outvecs[i].ibatch); CHKERRQ(ierr);
+		}
 		// compute each output vector using its own setup function
 		ierr = outvecs[i].OutVecWrite(&outvecs[i]); CHKERRQ(ierr);
 		// write vector to output file
 		OutBufDump(outbuf);
 	}
 
+	// return corner buffers
+	ierr = DMRestoreLocalVector(fs->DA_COR, &outbuf->lbcor); CHKERRQ(ierr);
+
+	if(outbuf->nfb)
+	{
+		ierr = DMRestoreLocalVector(outbuf->DA_FCOR, &outbuf->lfcor); CHKERRQ(ierr);
+	}
+
 	// close appended data section and file
 	fprintf(fp, "\n\t</AppendedData>\n");
 	fprintf(fp, "</VTKFile>\n");
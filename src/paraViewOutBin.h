@@ -33,6 +33,10 @@
 //       - scale and copy component to the buffer from local corner vector
 //    * and of loop
 //    * dump buffer to output file
+// Vectors obtained directly from the cell & edge solution variables (fused
+// vectors, see outFunct.h) follow the same scheme, except that all their
+// components are evaluated in advance in batches, in a single pass over the
+// source arrays, and are copied to the buffer from stacked corner vector.
 //---------------------------------------------------------------------------
 #ifndef __paraViewOutBin_h__
 #define __paraViewOutBin_h__
@@ -58,12 +62,29 @@ struct OutBuf
 	// grid buffer vectors
 	Vec lbcen, lbcor, lbxy, lbxz, lbyz; // local (ghosted)
 
+	// stacked buffers of fused output vectors
+	PetscInt  nfb;     // number of fused batches
+	PetscInt  ifb;     // currently evaluated batch
+	PetscInt  nfcor;   // number of stacked corner components
+	DM        DA_FCEN; // stacked center grid
+	DM        DA_FXY;  // stacked xy-edge grid
+	DM        DA_FXZ;  // stacked xz-edge grid
+	DM        DA_FYZ;  // stacked yz-edge grid
+	DM        DA_FCOR; // stacked corner grid
+	Vec       lfcor;   // stacked corner buffer (borrowed during output)
+
 };
 //---------------------------------------------------------------------------
 PetscErrorCode OutBufCreate(OutBuf *outbuf, JacRes *jr);
 
 PetscErrorCode OutBufDestroy(OutBuf *outbuf);
 
+// assign fused vectors to batches & create stacked grids
+PetscErrorCode OutBufCreateFused(OutBuf *outbuf, OutVec *outvecs, PetscInt nvec);
+
+// create grid with the same layout & given number of components
+PetscErrorCode OutBufCreateStackedDMDA(DM da, PetscInt dof, DM *sda);
+
 void OutBufConnectToFile(OutBuf  *outbuf, FILE *fp);
 
 // dump output buffer contents to disk
@@ -83,6 +104,14 @@ PetscErrorCode OutBufPut3DVecComp(
 	PetscScalar  cf,     // scaling coefficient
 	PetscScalar  shift); // shift parameter (subtracted from scaled values)
 
+// put component of stacked corner buffer to output buffer
+PetscErrorCode OutBufPutStackedComp(
+	OutBuf      *outbuf,
+	PetscInt     ncomp,  // number of components
+	PetscInt     dir,    // component identifier
+	PetscInt     icomp,  // component in stacked buffer
+	PetscScalar  cf);    // scaling coefficient
+
 PetscErrorCode OutBufZero3DVecComp(
 	OutBuf      *outbuf,
 	PetscInt     ncomp,  // number of components
@@ -17,11 +17,12 @@
 //---------------------------------------------------------------------------
 PetscErrorCode FBLoad(FB **pfb, PetscBool DisplayOutput, char *restartFileName)
 {
-	FB        *fb;
-	FILE      *fp;
-	size_t    sz;
-	PetscBool found;
-	char      buffer[_str_len_], *filename, *all_options;
+	FB          *fb;
+	FILE        *fp;
+	size_t      sz;
+	PetscBool   found;
+	PetscMPIInt status;
+	char        buffer[_str_len_], *filename, *all_options;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -29,6 +30,8 @@ PetscErrorCode FBLoad(FB **pfb, PetscBool DisplayOutput, char *restartFileName)
 	ierr = PetscMalloc(sizeof(FB), &fb); CHKERRQ(ierr);
 	ierr = PetscMemzero(fb, sizeof(FB)); CHKERRQ(ierr);
 
+	status = 0;
+
 	if(ISRankZero(PETSC_COMM_WORLD))
 	{
 		if(!restartFileName)
@@ -82,26 +85,24 @@ PetscErrorCode FBLoad(FB **pfb, PetscBool DisplayOutput, char *restartFileName)
 
 		// set number of characters
 		fb->nchar = (PetscInt)sz + 1;
+
+		// parse buffer & build key index (errors are reported after broadcasting status)
+		status = (PetscMPIInt)FBParseBuffer(fb);
 	}
 
-	// broadcast
+	// broadcast parsing status (other processes must not wait for the buffer)
 	if(ISParallel(PETSC_COMM_WORLD))
 	{
-		ierr = MPI_Bcast(&fb->nchar, 1, MPIU_INT, 0, PETSC_COMM_WORLD); CHKERRQ(ierr);
+		ierr = MPI_Bcast(&status, 1, MPI_INT, 0, PETSC_COMM_WORLD); CHKERRQ(ierr);
 	}
 
-	if(!ISRankZero(PETSC_COMM_WORLD))
+	if(status)
 	{
-		ierr = PetscMalloc((size_t)fb->nchar*sizeof(char), &fb->fbuf); CHKERRQ(ierr);
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Cannot parse input file (see error message above)\n");
 	}
 
-	if(ISParallel(PETSC_COMM_WORLD))
-	{
-		ierr = MPI_Bcast(fb->fbuf, (PetscMPIInt)fb->nchar, MPI_CHAR, 0, PETSC_COMM_WORLD); CHKERRQ(ierr);
-	}
-	
-	// parse buffer
-	ierr = FBParseBuffer(fb); CHKERRQ(ierr);
+	// broadcast processed buffer & key index
+	ierr = FBBroadcast(fb); CHKERRQ(ierr);
 
 	// copy all command line and previously specified options to buffer
 	ierr = PetscOptionsGetAll(NULL, &all_options);  CHKERRQ(ierr);
@@ -153,6 +154,7 @@ PetscErrorCode FBDestroy(FB **pfb)
 	ierr = PetscFree(fb->lbuf);    CHKERRQ(ierr);
 	ierr = PetscFree(fb->pfLines); CHKERRQ(ierr);
 	ierr = PetscFree(fb->pbLines); CHKERRQ(ierr);
+	ierr = PetscFree(fb->idx);     CHKERRQ(ierr);
 	ierr = FBFreeBlocks(fb);       CHKERRQ(ierr);
 	ierr = PetscFree(fb);          CHKERRQ(ierr);
 
@@ -245,6 +247,8 @@ PetscErrorCode FBParseBuffer(FB *fb)
 	}
 
 	// allocate line buffer
+	fb->lblen = (PetscInt)maxlen + 1;
+
 	ierr = PetscMalloc((maxlen + 1)*sizeof(char), &fb->lbuf);         CHKERRQ(ierr);
 	ierr = PetscMemzero(fb->lbuf, (size_t)(maxlen + 1)*sizeof(char)); CHKERRQ(ierr);
 
@@ -265,14 +269,262 @@ PetscErrorCode FBParseBuffer(FB *fb)
 
 	ierr = PetscFree(fblock); CHKERRQ(ierr);
 
+	// build key index
+	ierr = FBBuildIndex(fb); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FBBuildIndex(FB *fb)
+{
+	const char *key;
+	size_t      len, h;
+	PetscInt    i, id, jd, seg, nlines;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// count block marker lines
+	fb->nmLines = 0;
+
+	for(i = 0; i < fb->nbLines; i++)
+	{
+		if(strstr(fb->pbLines[i], "<") && strstr(fb->pbLines[i], ">")) fb->nmLines++;
+	}
+
+	// get hash table size (load factor not larger than 1/2)
+	nlines    = fb->nfLines + fb->nbLines;
+	fb->nhash = 2;
+
+	while(fb->nhash < 2*nlines) fb->nhash *= 2;
+
+	// allocate index storage
+	ierr = makeIntArray(&fb->idx, NULL, fb->nfLines + 2*fb->nbLines + fb->nmLines + fb->nhash); CHKERRQ(ierr);
+
+	fb->fOff   = fb->idx;
+	fb->bOff   = fb->fOff   + fb->nfLines;
+	fb->mLines = fb->bOff   + fb->nbLines;
+	fb->bSeg   = fb->mLines + fb->nmLines;
+	fb->hash   = fb->bSeg   + fb->nbLines;
+
+	// store line offsets
+	for(i = 0; i < fb->nfLines; i++) fb->fOff[i] = (PetscInt)(fb->pfLines[i] - fb->fbuf);
+	for(i = 0; i < fb->nbLines; i++) fb->bOff[i] = (PetscInt)(fb->pbLines[i] - fb->fbuf);
+
+	// store block markers & first lines of data blocks
+	for(i = 0, jd = 0, seg = 0; i < fb->nbLines; i++)
+	{
+		if(strstr(fb->pbLines[i], "<") && strstr(fb->pbLines[i], ">"))
+		{
+			fb->mLines[jd++] = i;
+			fb->bSeg[i]      = -1;
+			seg              = i + 1;
+		}
+		else
+		{
+			fb->bSeg[i] = seg;
+		}
+	}
+
+	// insert keys (only first occurrence in flat space or data block is stored)
+	for(i = 0; i < fb->nhash; i++) fb->hash[i] = -1;
+
+	for(id = 0; id < nlines; id++)
+	{
+		if(id < fb->nfLines) { len = FBGetLineKey(fb->pfLines[id], &key); seg = -1; }
+		else                 { len = FBGetLineKey(fb->pbLines[id - fb->nfLines], &key); seg = fb->bSeg[id - fb->nfLines]; }
+
+		// skip empty lines & block markers
+		if(!len || (id >= fb->nfLines && seg == -1)) continue;
+
+		h = FBGetKeyHash(key, len, seg) & (size_t)(fb->nhash - 1);
+
+		// linear probing
+		while((jd = fb->hash[h]) != -1)
+		{
+			const char *jkey;
+			size_t      jlen;
+			PetscInt    jseg;
+
+			if(jd < fb->nfLines) { jlen = FBGetLineKey(fb->pfLines[jd], &jkey); jseg = -1; }
+			else                 { jlen = FBGetLineKey(fb->pbLines[jd - fb->nfLines], &jkey); jseg = fb->bSeg[jd - fb->nfLines]; }
+
+			if(jseg == seg && jlen == len && !strncmp(jkey, key, len)) break;
+
+			h = (h + 1) & (size_t)(fb->nhash - 1);
+		}
+
+		if(jd == -1) fb->hash[h] = id;
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FBBroadcast(FB *fb)
+{
+	PetscInt head[6], i, nidx;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!ISParallel(PETSC_COMM_WORLD)) PetscFunctionReturn(0);
+
+	// broadcast sizes
+	if(ISRankZero(PETSC_COMM_WORLD))
+	{
+		head[0] = fb->nchar;
+		head[1] = fb->nfLines;
+		head[2] = fb->nbLines;
+		head[3] = fb->nmLines;
+		head[4] = fb->nhash;
+		head[5] = fb->lblen;
+	}
+
+	ierr = MPI_Bcast(head, 6, MPIU_INT, 0, PETSC_COMM_WORLD); CHKERRQ(ierr);
+
+	nidx = head[1] + 2*head[2] + head[3] + head[4];
+
+	if(!ISRankZero(PETSC_COMM_WORLD))
+	{
+		fb->nchar   = head[0];
+		fb->nfLines = head[1];
+		fb->nbLines = head[2];
+		fb->nmLines = head[3];
+		fb->nhash   = head[4];
+		fb->lblen   = head[5];
+
+		// allocate buffers (pad with string terminator)
+		ierr = PetscMalloc((size_t)(fb->nchar + 1)*sizeof(char), &fb->fbuf); CHKERRQ(ierr);
+		ierr = PetscMalloc((size_t)fb->lblen*sizeof(char), &fb->lbuf);       CHKERRQ(ierr);
+		ierr = PetscMemzero(fb->lbuf, (size_t)fb->lblen*sizeof(char));       CHKERRQ(ierr);
+		ierr = makeIntArray(&fb->idx, NULL, nidx);                           CHKERRQ(ierr);
+
+		fb->fbuf[fb->nchar] = '\0';
+	}
+
+	// broadcast processed buffer & index storage
+	ierr = MPI_Bcast(fb->fbuf, (PetscMPIInt)fb->nchar, MPI_CHAR, 0, PETSC_COMM_WORLD); CHKERRQ(ierr);
+	ierr = MPI_Bcast(fb->idx,  (PetscMPIInt)nidx,      MPIU_INT, 0, PETSC_COMM_WORLD); CHKERRQ(ierr);
+
+	if(!ISRankZero(PETSC_COMM_WORLD))
+	{
+		fb->fOff   = fb->idx;
+		fb->bOff   = fb->fOff   + fb->nfLines;
+		fb->mLines = fb->bOff   + fb->nbLines;
+		fb->bSeg   = fb->mLines + fb->nmLines;
+		fb->hash   = fb->bSeg   + fb->nbLines;
+
+		// restore line pointers
+		ierr = PetscMalloc((size_t)fb->nbLines*sizeof(char*), &fb->pbLines); CHKERRQ(ierr);
+		ierr = PetscMalloc((size_t)fb->nfLines*sizeof(char*), &fb->pfLines); CHKERRQ(ierr);
+
+		for(i = 0; i < fb->nfLines; i++) fb->pfLines[i] = fb->fbuf + fb->fOff[i];
+		for(i = 0; i < fb->nbLines; i++) fb->pbLines[i] = fb->fbuf + fb->bOff[i];
+	}
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+size_t FBGetLineKey(const char *line, const char **key)
+{
+	size_t len;
+
+	// skip leading spaces
+	while(*line == ' ') line++;
+
+	// get key length
+	for(len = 0; line[len] && line[len] != ' '; len++) { }
+
+	(*key) = line;
+
+	return len;
+}
+//---------------------------------------------------------------------------
+size_t FBGetKeyHash(const char *key, size_t len, PetscInt seg)
+{
+	// FNV-1a hash of the key, mixed with data block
+
+	uint64_t h;
+	size_t   i;
+
+	h = 14695981039346656037ULL;
+
+	for(i = 0; i < len; i++)
+	{
+		h ^= (uint64_t)(unsigned char)key[i];
+		h *= 1099511628211ULL;
+	}
+
+	h ^= (uint64_t)(seg + 2)*0x9E3779B97F4A7C15ULL;
+	h ^= h >> 29;
+
+	return (size_t)h;
+}
+//---------------------------------------------------------------------------
+PetscInt FBFindKey(FB *fb, const char *key)
+{
+	const char *jkey;
+	size_t      h, len, jlen;
+	PetscInt    i, jd, seg, jseg, lnbeg, lnend;
+	char      **lines;
+
+	lines = FBGetLineRanges(fb, &lnbeg, &lnend);
+
+	// get data block
+	if(fb->nblocks)
+	{
+		seg = fb->bSeg[lnbeg];
+
+		// line range is not a data block (scan lines)
+		if(seg != lnbeg)
+		{
+			for(i = lnbeg; i < lnend; i++)
+			{
+				jlen = FBGetLineKey(lines[i], &jkey);
+
+				if(jlen == strlen(key) && !strncmp(jkey, key, jlen)) return i;
+			}
+
+			return -1;
+		}
+	}
+	else
+	{
+		seg = -1;
+	}
+
+	len = strlen(key);
+	h   = FBGetKeyHash(key, len, seg) & (size_t)(fb->nhash - 1);
+
+	// linear probing
+	while((jd = fb->hash[h]) != -1)
+	{
+		if(jd < fb->nfLines) { jlen = FBGetLineKey(fb->pfLines[jd], &jkey); jseg = -1; }
+		else                 { jlen = FBGetLineKey(fb->pbLines[jd - fb->nfLines], &jkey); jseg = fb->bSeg[jd - fb->nfLines]; }
+
+		if(jseg == seg && jlen == len && !strncmp(jkey, key, len))
+		{
+			// convert to line index in current access mode
+			i = (seg == -1) ? jd : jd - fb->nfLines;
+
+			if(i >= lnbeg && i < lnend) return i;
+
+			return -1;
+		}
+
+		h = (h + 1) & (size_t)(fb->nhash - 1);
+	}
+
+	return -1;
+}
+//---------------------------------------------------------------------------
 PetscErrorCode FBFindBlocks(FB *fb, ParamType ptype, const char *keybeg, const char *keyend)
 {
 	// find line ranges of data blocks
 
-	PetscInt i, nbeg, nend;
+	// (block identifiers can only appear in marker lines)
+
+	PetscInt i, j, nbeg, nend;
 
 	PetscErrorCode ierr;
 	PetscFunctionBeginUser;
@@ -281,8 +533,10 @@ PetscErrorCode FBFindBlocks(FB *fb, ParamType ptype, const char *keybeg, const c
 	nend = 0;
 
 	// count number of blocks
-	for(i = 0; i < fb->nbLines; i++)
+	for(j = 0; j < fb->nmLines; j++)
 	{
+		i = fb->mLines[j];
+
 		if(strstr(fb->pbLines[i], keybeg)) nbeg++;
 		if(strstr(fb->pbLines[i], keyend)) nend++;
 	}
@@ -308,8 +562,10 @@ PetscErrorCode FBFindBlocks(FB *fb, ParamType ptype, const char *keybeg, const c
 	nbeg = 0;
 	nend = 0;
 
-	for(i = 0; i < fb->nbLines; i++)
+	for(j = 0; j < fb->nmLines; j++)
 	{
+		i = fb->mLines[j];
+
 		if(strstr(fb->pbLines[i], keybeg)) fb->blBeg[nbeg++] = i+1;
 		if(strstr(fb->pbLines[i], keyend)) fb->blEnd[nend++] = i;
 	}
@@ -379,46 +635,44 @@ PetscErrorCode FBGetIntArray(
 	(*nvalues) = 0;
 	(*found)   = PETSC_FALSE;
 
+	// find line with matching key
+	i = FBFindKey(fb, key);
+
+	if(i == -1) PetscFunctionReturn(0);
+
 	// get line buffer & pointers
 	line  = fb->lbuf;
 	lines = FBGetLineRanges(fb, &lnbeg, &lnend);
 
-	for(i = lnbeg; i < lnend; i++)
-	{
-		// copy line for parsing
-		strcpy(line, lines[i]);
+	// copy line for parsing
+	strcpy(line, lines[i]);
 
-		// check for key match
-		ptr = strtok(line, " ");
+	// skip key
+	ptr = strtok(line, " ");
 
-		if(!ptr || strcmp(ptr, key)) continue;
+	// check equal sign
+	ptr = strtok(NULL, " ");
 
-		// check equal sign
-		ptr = strtok(NULL, " ");
-
-		if(!ptr || strcmp(ptr, "="))
-		{
-			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No equal sign specified for parameter \"%s\"\n", key);
-		}
-
-		// retrieve values after equal sign
-		count = 0;
-		ptr   = strtok(NULL, " ");
+	if(!ptr || strcmp(ptr, "="))
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No equal sign specified for parameter \"%s\"\n", key);
+	}
 
-		while(ptr != NULL && count < num)
-		{
-			values[count++] = (PetscInt)strtol(ptr, NULL, 0);
+	// retrieve values after equal sign
+	count = 0;
+	ptr   = strtok(NULL, " ");
 
-			ptr = strtok(NULL, " ");
-		}
+	while(ptr != NULL && count < num)
+	{
+		values[count++] = (PetscInt)strtol(ptr, NULL, 0);
 
-		if(!count) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No value specified for parameter \"%s\"\n", key);
+		ptr = strtok(NULL, " ");
+	}
 
-		(*nvalues) = count;
-		(*found)   = PETSC_TRUE;
+	if(!count) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No value specified for parameter \"%s\"\n", key);
 
-		PetscFunctionReturn(0);
-	}
+	(*nvalues) = count;
+	(*found)   = PETSC_TRUE;
 
 	PetscFunctionReturn(0);
 }
@@ -440,46 +694,44 @@ PetscErrorCode FBGetScalarArray(
 	(*nvalues) = 0;
 	(*found)   = PETSC_FALSE;
 
+	// find line with matching key
+	i = FBFindKey(fb, key);
+
+	if(i == -1) PetscFunctionReturn(0);
+
 	// get line buffer & pointers
 	line  = fb->lbuf;
 	lines = FBGetLineRanges(fb, &lnbeg, &lnend);
 
-	for(i = lnbeg; i < lnend; i++)
-	{
-		// copy line for parsing
-		strcpy(line, lines[i]);
-
-		// check for key match
-		ptr = strtok(line, " ");
+	// copy line for parsing
+	strcpy(line, lines[i]);
 
-		if(!ptr || strcmp(ptr, key)) continue;
+	// skip key
+	ptr = strtok(line, " ");
 
-		// check equal sign
-		ptr = strtok(NULL, " ");
+	// check equal sign
+	ptr = strtok(NULL, " ");
 
-		if(!ptr || strcmp(ptr, "="))
-		{
-			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No equal sign specified for parameter \"%s\"\n", key);
-		}
+	if(!ptr || strcmp(ptr, "="))
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No equal sign specified for parameter \"%s\"\n", key);
+	}
 
-		// retrieve values after equal sign
-		count = 0;
-		ptr   = strtok(NULL, " ");
+	// retrieve values after equal sign
+	count = 0;
+	ptr   = strtok(NULL, " ");
 
-		while(ptr != NULL && count < num)
-		{
-			values[count++] = (PetscScalar)strtod(ptr, NULL);
-
-			ptr = strtok(NULL, " ");
-		}
+	while(ptr != NULL && count < num)
+	{
+		values[count++] = (PetscScalar)strtod(ptr, NULL);
 
-		if(!count) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No value specified for parameter \"%s\"\n", key);
+		ptr = strtok(NULL, " ");
+	}
 
-		(*nvalues) = count;
-		(*found)   = PETSC_TRUE;
+	if(!count) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No value specified for parameter \"%s\"\n", key);
 
-		PetscFunctionReturn(0);
-	}
+	(*nvalues) = count;
+	(*found)   = PETSC_TRUE;
 
 	PetscFunctionReturn(0);
 }
@@ -498,46 +750,44 @@ PetscErrorCode FBGetString(
 	// initialize
 	(*found) = PETSC_FALSE;
 
+	// find line with matching key
+	i = FBFindKey(fb, key);
+
+	if(i == -1) PetscFunctionReturn(0);
+
 	// get line buffer & pointers
 	line  = fb->lbuf;
 	lines = FBGetLineRanges(fb, &lnbeg, &lnend);
 
-	for(i = lnbeg; i < lnend; i++)
-	{
-		// copy line for parsing
-		strcpy(line, lines[i]);
-
-		// check for key match
-		ptr = strtok(line, " ");
+	// copy line for parsing
+	strcpy(line, lines[i]);
 
-		if(!ptr || strcmp(ptr, key)) continue;
+	// skip key
+	ptr = strtok(line, " ");
 
-		// check equal sign
-		ptr = strtok(NULL, " ");
+	// check equal sign
+	ptr = strtok(NULL, " ");
 
-		if(!ptr || strcmp(ptr, "="))
-		{
-			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No equal sign specified for parameter \"%s\"\n", key);
-		}
-
-		// retrieve values after equal sign
-		ptr = strtok(NULL, " ");
+	if(!ptr || strcmp(ptr, "="))
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No equal sign specified for parameter \"%s\"\n", key);
+	}
 
-		if(!ptr) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No value specified for parameter \"%s\"\n", key);
+	// retrieve values after equal sign
+	ptr = strtok(NULL, " ");
 
-		// make sure string fits & is null terminated (two null characters are reserved in the end)
-		if(strlen(ptr) > (_str_len_ - 2) )
-		{
-			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "String %s is more than %lld symbols long, (_str_len_ in parsing.h) \n", key, (LLD)(_str_len_ - 2));
-		}
+	if(!ptr) SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "No value specified for parameter \"%s\"\n", key);
 
-		// copy & pad the rest of the string with zeros
-		strncpy(str, ptr, _str_len_);
+	// make sure string fits & is null terminated (two null characters are reserved in the end)
+	if(strlen(ptr) > (_str_len_ - 2) )
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "String %s is more than %lld symbols long, (_str_len_ in parsing.h) \n", key, (LLD)(_str_len_ - 2));
+	}
 
-		(*found) = PETSC_TRUE;
+	// copy & pad the rest of the string with zeros
+	strncpy(str, ptr, _str_len_);
 
-		PetscFunctionReturn(0);
-	}
+	(*found) = PETSC_TRUE;
 
 	PetscFunctionReturn(0);
 }
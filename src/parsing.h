@@ -41,6 +41,12 @@ struct FB
 	//
 	// All strings reserve two null characters in the end to detect overrun
 	//
+	// Keys of all lines are indexed in a hash table, which is built once
+	// on the first process and broadcast together with the processed file
+	// buffer as a compact binary blob (line offsets, block markers, block
+	// ranges and hash table). Key lookup in flat and block access modes
+	// is a single hash probe instead of a scan over all lines.
+	//
 	//=====================================================================
 
 
@@ -61,6 +67,17 @@ struct FB
 	PetscInt  *blEnd;   // ending lines of blocks
 
     PetscInt   ID;      // ID of the current phase or softening law 
+
+	// key index
+	PetscInt   lblen;   // line buffer length
+	PetscInt   nmLines; // number of block marker lines
+	PetscInt   nhash;   // size of hash table (power of two)
+	PetscInt  *idx;     // index storage (broadcast as a single array)
+	PetscInt  *fOff;    // offsets of flat lines
+	PetscInt  *bOff;    // offsets of block lines
+	PetscInt  *mLines;  // block marker lines
+	PetscInt  *bSeg;    // first line of enclosing data block (block lines)
+	PetscInt  *hash;    // key hash table (flat line: i, block line: nfLines+i, empty: -1)
 };
 
 //-----------------------------------------------------------------------------
@@ -71,6 +88,21 @@ PetscErrorCode FBDestroy(FB **pfb);
 
 PetscErrorCode FBParseBuffer(FB *fb);
 
+// build key index of processed buffer (first process)
+PetscErrorCode FBBuildIndex(FB *fb);
+
+// broadcast processed buffer & key index from first process
+PetscErrorCode FBBroadcast(FB *fb);
+
+// get key of the line (returns key length)
+size_t FBGetLineKey(const char *line, const char **key);
+
+// get hash of the key in the data block (flat lines: seg = -1)
+size_t FBGetKeyHash(const char *key, size_t len, PetscInt seg);
+
+// get line with matching key in current access mode (-1 if not found)
+PetscInt FBFindKey(FB *fb, const char *key);
+
 PetscErrorCode FBFindBlocks(FB *fb, ParamType ptype, const char *keybeg, const char *keyend);
 
 PetscErrorCode FBFreeBlocks(FB *fb);
@@ -710,18 +710,24 @@ PetscErrorCode SetClapeyron_Eq(Ph_trans_t *ph)
 
 PetscErrorCode Phase_Transition(AdvCtx *actx)
 {
-	// creates arrays to optimize marker-cell interaction
+	// Apply all phase transition laws in a single sweep over the markers.
+	// Laws are evaluated for every marker in the order of the input file,
+	// which is equivalent to the sequence of per-law marker sweeps.
+	// Markers of phases that are not involved in any law are skipped,
+	// unless the host cell intersects a box of a law that also acts on
+	// uninvolved markers (box temperature structure or phase reset).
 
 	DBMat           *dbm;
 	TSSol           *ts;
+	FDSTAG          *fs;
 	Ph_trans_t      *PhaseTrans;
 	Marker          *P;
 	JacRes          *jr;
-	PetscInt        i, ph,nPtr, numPhTrn,below,above,num_phas;
-	PetscInt        PH1,PH2, ID, InsideAbove,nphc; // nphc nophasechange condition
-	PetscScalar     T, time, factor, dxBox, dyBox, dzBox;
+	PetscInt        i, nPtr, numPhTrn, numPhases, ID, below, above;
+	PetscInt        *ind_below, *ind_above, *law_nphc;
+	PetscBool       *ph_act, *law_box, *cell_box, act;
+	PetscScalar     time;
 	PetscLogDouble  t;
-	SolVarCell      *svCell;
 	Scaling         *scal;
 
 	PetscErrorCode  ierr;
@@ -729,9 +735,11 @@ PetscErrorCode Phase_Transition(AdvCtx *actx)
 
     // Retrieve parameters
 	jr          =   actx->jr;
+	fs          =   jr->fs;
 	dbm         =   jr->dbm;
 	ts          =   jr->ts;
 	numPhTrn    =   dbm->numPhtr;
+	numPhases   =   dbm->numPhases;
 	scal 	    =	dbm->scal;
 	time        =   jr->bc->ts->time;
 	
@@ -741,182 +749,326 @@ PetscErrorCode Phase_Transition(AdvCtx *actx)
 
 	//For dynamic diking
 	ierr = Locate_Dike_Zones(actx); CHKERRQ(ierr);
-	
-	// loop over all phase transition laws		PetscPrintf(PETSC_COMM_WORLD,"PHASE = %d  i = %d, counter = %d\n",P->phase,i,counter);
-	nPtr        =   0;
 
-	for(nPtr=0; nPtr<numPhTrn; nPtr++)
-	  {
-	    PhaseTrans = jr->dbm->matPhtr+nPtr;
+	// update moving & linked boxes
+	for(nPtr = 0; nPtr < numPhTrn; nPtr++)
+	{
+		PhaseTrans = dbm->matPhtr+nPtr;
 
-	    // Is the phase transition changing the phase, or other properites?
-	    if((PhaseTrans->PhaseInside[0]>0 && PhaseTrans->PhaseOutside[0]>0) || (PhaseTrans->PhaseAbove[0]>0 && PhaseTrans->PhaseBelow[0]>0))
-	    {
-              nphc = 1;
-	    }
-	    else
-	    {
-              nphc = 0;
-	    }
-	    // calling the moving dike function
+		if(PhaseTrans->Type == _NotInAirBox_)
+		{
+			if(PhaseTrans->v_box)
+			{
+				ierr = MovingBox(PhaseTrans, ts, jr); CHKERRQ(ierr);
+			}
 
-	    if ( PhaseTrans->Type == _NotInAirBox_ )
-	    {
-              if (PhaseTrans->v_box) {
-                ierr = MovingBox(PhaseTrans, ts, jr); CHKERRQ(ierr);
-              }
+			ierr = LinkNotInAirBoxes(PhaseTrans, jr); CHKERRQ(ierr);
+		}
+	}
 
-              ierr = LinkNotInAirBoxes(PhaseTrans, jr); CHKERRQ(ierr);
+	// allocate lookup tables
+	ierr = PetscMalloc((size_t)(numPhTrn*numPhases)*sizeof(PetscInt),  &ind_below); CHKERRQ(ierr);
+	ierr = PetscMalloc((size_t)(numPhTrn*numPhases)*sizeof(PetscInt),  &ind_above); CHKERRQ(ierr);
+	ierr = PetscMalloc((size_t)numPhTrn*sizeof(PetscInt),              &law_nphc);  CHKERRQ(ierr);
+	ierr = PetscMalloc((size_t)numPhTrn*sizeof(PetscBool),             &law_box);   CHKERRQ(ierr);
+	ierr = PetscMalloc((size_t)numPhases*sizeof(PetscBool),            &ph_act);    CHKERRQ(ierr);
+	ierr = PetscMalloc((size_t)fs->nCells*sizeof(PetscBool),           &cell_box);  CHKERRQ(ierr);
 
-	    }
-	    
-		for(i = 0; i < actx->nummark; i++)      // loop over all (local) particles
+	// setup phase -> law lookup tables
+	ierr = Phase_Transition_SetupTables(jr, ind_below, ind_above, law_nphc, law_box, ph_act, cell_box); CHKERRQ(ierr);
+
+	for(i = 0; i < actx->nummark; i++)      // loop over all (local) particles
+	{
+		// access marker
+		P   =   &actx->markers[i];
+
+		// get consecutive index of the host cell of marker
+		ID  =   actx->cellnum[i];
+
+		// skip markers that cannot be affected by any law
+		if(!ph_act[P->phase] && !cell_box[ID]) continue;
+
+		for(nPtr = 0; nPtr < numPhTrn; nPtr++)
 		{
-			// access marker
-			P   =   &actx->markers[i];      
+			// current marker phase is used (it may be changed by preceding laws)
+			below = ind_below[nPtr*numPhases + P->phase];
+			above = ind_above[nPtr*numPhases + P->phase];
 
-			// get consecutive index of the host cell of marker
-			ID = 	actx->cellnum[i];
+			// uninvolved markers are only affected by box-type laws
+			act = (PetscBool)(below >= 0 || above >= 0 || (law_box[nPtr] && cell_box[ID]));
 
-			// access host cell solution variables
-			svCell = &jr->svCell[ID];
-			
-			num_phas    =   PhaseTrans->number_phases;
+			if(!act) continue;
 
-			if ( PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_ ){
-				below       =   Check_Phase_above_below(PhaseTrans->PhaseInside,   P, num_phas);
-				above       =   Check_Phase_above_below(PhaseTrans->PhaseOutside,  P, num_phas);
-			}
-			else {
-				below       =   Check_Phase_above_below(PhaseTrans->PhaseBelow,   P, num_phas);
-				above       =   Check_Phase_above_below(PhaseTrans->PhaseAbove,   P, num_phas);
-			}
+			Phase_Transition_Marker(dbm->matPhtr+nPtr, P, below, above, law_nphc[nPtr], jr->ctrl, scal, &jr->svCell[ID], time, jr, ID);
+		}
+	}
+
+	// free lookup tables
+	ierr = PetscFree(ind_below); CHKERRQ(ierr);
+	ierr = PetscFree(ind_above); CHKERRQ(ierr);
+	ierr = PetscFree(law_nphc);  CHKERRQ(ierr);
+	ierr = PetscFree(law_box);   CHKERRQ(ierr);
+	ierr = PetscFree(ph_act);    CHKERRQ(ierr);
+	ierr = PetscFree(cell_box);  CHKERRQ(ierr);
+
+	ierr = ADVInterpMarkToCell(actx);   CHKERRQ(ierr);
+
+    	PrintDone(t);
+	PetscFunctionReturn(0);
+}
+//----------------------------------------------------------------------------------------
+PetscErrorCode Phase_Transition_SetupTables(JacRes *jr, PetscInt *ind_below, PetscInt *ind_above,
+		PetscInt *law_nphc, PetscBool *law_box, PetscBool *ph_act, PetscBool *cell_box)
+{
+	// ind_below[nPtr*numPhases + ph] - position of phase in the below (inside)  list of law, -1 if absent
+	// ind_above[nPtr*numPhases + ph] - position of phase in the above (outside) list of law, -1 if absent
+	// law_nphc [nPtr]                - law changes the phase (not only other properties)
+	// law_box  [nPtr]                - law acts on markers not involved in the transition
+	// ph_act   [ph]                  - phase is involved in any law
+	// cell_box [ID]                  - cell intersects any box of a law that acts on uninvolved markers
+
+	FDSTAG      *fs;
+	Ph_trans_t  *PhaseTrans;
+	PetscInt    *list_below, *list_above;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz, iter, J;
+	PetscInt    nPtr, numPhTrn, numPhases, n, ph;
+	PetscScalar x0, x1, y0, y1, z0, z1, xL, xR, *bnd;
+	PetscBool   flg;
+
+	PetscFunctionBeginUser;
+
+	fs        = jr->fs;
+	numPhTrn  = jr->dbm->numPhtr;
+	numPhases = jr->dbm->numPhases;
+
+	for(ph = 0; ph < numPhases; ph++) ph_act[ph] = PETSC_FALSE;
+
+	flg = PETSC_FALSE;
+
+	for(nPtr = 0; nPtr < numPhTrn; nPtr++)
+	{
+		PhaseTrans = jr->dbm->matPhtr+nPtr;
+
+		// Is the phase transition changing the phase, or other properites?
+		if((PhaseTrans->PhaseInside[0]>0 && PhaseTrans->PhaseOutside[0]>0) || (PhaseTrans->PhaseAbove[0]>0 && PhaseTrans->PhaseBelow[0]>0))
+		{
+			law_nphc[nPtr] = 1;
+		}
+		else
+		{
+			law_nphc[nPtr] = 0;
+		}
+
+		if ( PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_ )
+		{
+			list_below = PhaseTrans->PhaseInside;
+			list_above = PhaseTrans->PhaseOutside;
+		}
+		else
+		{
+			list_below = PhaseTrans->PhaseBelow;
+			list_above = PhaseTrans->PhaseAbove;
+		}
+
+		// first occurrence is stored (same as linear search)
+		for(ph = 0; ph < numPhases; ph++)
+		{
+			ind_below[nPtr*numPhases + ph] = -1;
+			ind_above[nPtr*numPhases + ph] = -1;
+		}
+
+		for(n = PhaseTrans->number_phases-1; n >= 0; n--)
+		{
+			if(list_below[n] >= 0 && list_below[n] < numPhases) { ind_below[nPtr*numPhases + list_below[n]] = n; ph_act[list_below[n]] = PETSC_TRUE; }
+			if(list_above[n] >= 0 && list_above[n] < numPhases) { ind_above[nPtr*numPhases + list_above[n]] = n; ph_act[list_above[n]] = PETSC_TRUE; }
+		}
+
+		// laws that modify uninvolved markers inside the box (temperature structure or phase reset)
+		law_box[nPtr] = PETSC_FALSE;
+
+		if(PhaseTrans->Type == _Box_
+		&& (PhaseTrans->TempType != 0 || (PhaseTrans->PhaseOutside[0]<0 && PhaseTrans->PhaseDirection==2)))
+		{
+			law_box[nPtr] = PETSC_TRUE;
+		}
+		if(PhaseTrans->Type == _NotInAirBox_ && PhaseTrans->TempType != 0)
+		{
+			law_box[nPtr] = PETSC_TRUE;
+		}
+
+		if(law_box[nPtr]) flg = PETSC_TRUE;
+	}
+
+	// mark cells that intersect boxes
+	for(i = 0; i < fs->nCells; i++) cell_box[i] = PETSC_FALSE;
+
+	if(!flg) PetscFunctionReturn(0);
+
+	// local cell ranges (consecutive cell index starts from zero)
+	sx = 0; nx = fs->dsx.ncels;
+	sy = 0; ny = fs->dsy.ncels;
+	sz = 0; nz = fs->dsz.ncels;
 
-			if  ( (below >= 0) || (above >= 0) )
+	iter = 0;
+
+	START_STD_LOOP
+	{
+		x0 = fs->dsx.ncoor[i]; x1 = fs->dsx.ncoor[i+1];
+		y0 = fs->dsy.ncoor[j]; y1 = fs->dsy.ncoor[j+1];
+		z0 = fs->dsz.ncoor[k]; z1 = fs->dsz.ncoor[k+1];
+
+		for(nPtr = 0; nPtr < numPhTrn && !cell_box[iter]; nPtr++)
+		{
+			if(!law_box[nPtr]) continue;
+
+			PhaseTrans = jr->dbm->matPhtr+nPtr;
+
+			if(PhaseTrans->Type == _Box_)
 			{
-				PH2 = P->phase;
-				PH1 = P->phase;
-                 // the current phase is indeed involved in a phase transition
-				if      (   (below>=0) && (nphc ==1))
-				{
-					if ( PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_){
-						PH1 = PhaseTrans->PhaseInside[below];
-						PH2 = PhaseTrans->PhaseOutside[below];
-					}
-					else{
-						PH1 = PhaseTrans->PhaseBelow[below];
-						PH2 = PhaseTrans->PhaseAbove[below];
-					}
-				}
-				else if (   (above >=0) && (nphc==1))
-				{
-					if ( PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_){
-						PH1 = PhaseTrans->PhaseInside[above];
-						PH2 = PhaseTrans->PhaseOutside[above];
-					}
-					else{
-						PH1 = PhaseTrans->PhaseBelow[above];
-						PH2 = PhaseTrans->PhaseAbove[above];
-					}
-				}
-				else
+				bnd = PhaseTrans->bounds;
+
+				if(bnd[1] >= x0 && bnd[0] <= x1
+				&& bnd[3] >= y0 && bnd[2] <= y1
+				&& bnd[5] >= z0 && bnd[4] <= z1) cell_box[iter] = PETSC_TRUE;
+			}
+			else
+			{
+				// box boundaries are interpolated between neighboring cells in y-direction
+				xL = PhaseTrans->celly_xboundL[j];
+				xR = PhaseTrans->celly_xboundR[j];
+
+				for(J = j-1; J <= j+1; J += 2)
 				{
-					PH1 = P->phase;
-					PH2 = PH1;
+					xL = PetscMin(xL, PhaseTrans->celly_xboundL[J]);
+					xR = PetscMax(xR, PhaseTrans->celly_xboundR[J]);
 				}
 
-				ph 			= P->phase;
-				InsideAbove = 0;
+				if(xR >= x0 && xL <= x1
+				&& PhaseTrans->zbounds[1] >= z0 && PhaseTrans->zbounds[0] <= z1) cell_box[iter] = PETSC_TRUE;
+			}
+		}
 
-				Transition(PhaseTrans, P, PH1, PH2, jr->ctrl, scal, svCell, &ph, &T, &InsideAbove, time, jr, ID);
+		iter++;
+	}
+	END_STD_LOOP
 
-				if ( (PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_ ) )
-				{
-					if (PhaseTrans->PhaseInside[0]<0){ 
-						ph = P->phase;				// do not change the phase
-					}
+	PetscFunctionReturn(0);
+}
+//----------------------------------------------------------------------------------------
+void Phase_Transition_Marker(Ph_trans_t *PhaseTrans, Marker *P, PetscInt below, PetscInt above, PetscInt nphc,
+		Controls ctrl, Scaling *scal, SolVarCell *svCell, PetscScalar time, JacRes *jr, PetscInt ID)
+{
+	// apply single phase transition law to a marker
 
-				
-					if (PhaseTrans->BoxVicinity==1){
-						factor = 1.0;
-						dxBox  = (PhaseTrans->bounds[1]-PhaseTrans->bounds[0])*factor;
-						dyBox  = (PhaseTrans->bounds[3]-PhaseTrans->bounds[2])*factor;
-						dzBox  = (PhaseTrans->bounds[3]-PhaseTrans->bounds[2])*factor;
-						
-						if ( (P->X[0] < (PhaseTrans->bounds[0]-dxBox)) | (P->X[0] > (PhaseTrans->bounds[1]+dxBox)) |
-							 (P->X[1] < (PhaseTrans->bounds[2]-dyBox)) | (P->X[1] > (PhaseTrans->bounds[3]+dyBox)) |
-							 (P->X[2] < (PhaseTrans->bounds[4]-dzBox)) | (P->X[2] > (PhaseTrans->bounds[5]+dzBox))  )
-						{
-							ph = P->phase;				// do not change the phase
-						}
-					}
+	PetscInt    ph, PH1, PH2, InsideAbove;
+	PetscScalar T, factor, dxBox, dyBox, dzBox;
 
-				
-				}
-				if (PhaseTrans->PhaseDirection==0){
-					P->phase    =   ph;
-				}
-				else if ( (PhaseTrans->PhaseDirection==1) & (below>=0) ){
-					P->phase    =   ph;
-				}
-				else if ( (PhaseTrans->PhaseDirection==2) & (above>=0) ){
-					P->phase    =   ph;
-				}
-				P->T = T;	// set T
+	PH2 = P->phase;
+	PH1 = P->phase;
+
+	if  ( (below >= 0) || (above >= 0) )
+	{
+         // the current phase is indeed involved in a phase transition
+		if      (   (below>=0) && (nphc ==1))
+		{
+			if ( PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_){
+				PH1 = PhaseTrans->PhaseInside[below];
+				PH2 = PhaseTrans->PhaseOutside[below];
+			}
+			else{
+				PH1 = PhaseTrans->PhaseBelow[below];
+				PH2 = PhaseTrans->PhaseAbove[below];
+			}
+		}
+		else if (   (above >=0) && (nphc==1))
+		{
+			if ( PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_){
+				PH1 = PhaseTrans->PhaseInside[above];
+				PH2 = PhaseTrans->PhaseOutside[above];
+			}
+			else{
+				PH1 = PhaseTrans->PhaseBelow[above];
+				PH2 = PhaseTrans->PhaseAbove[above];
+			}
+		}
 
-				// Reset other parameters on particles if requested
-				if (PhaseTrans->PhaseDirection< 2){
+		ph 			= P->phase;
+		InsideAbove = 0;
 
-					// Both ways or below2above	
-					if (InsideAbove==1){
-						if (PhaseTrans->Reset==1){
-							P->APS = 0.0;
-						}
-					}
+		Transition(PhaseTrans, P, PH1, PH2, ctrl, scal, svCell, &ph, &T, &InsideAbove, time, jr, ID);
+
+		if ( (PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_ ) )
+		{
+			if (PhaseTrans->PhaseInside[0]<0){ 
+				ph = P->phase;				// do not change the phase
+			}
+
+			if (PhaseTrans->BoxVicinity==1){
+				factor = 1.0;
+				dxBox  = (PhaseTrans->bounds[1]-PhaseTrans->bounds[0])*factor;
+				dyBox  = (PhaseTrans->bounds[3]-PhaseTrans->bounds[2])*factor;
+				dzBox  = (PhaseTrans->bounds[3]-PhaseTrans->bounds[2])*factor;
+				
+				if ( (P->X[0] < (PhaseTrans->bounds[0]-dxBox)) | (P->X[0] > (PhaseTrans->bounds[1]+dxBox)) |
+					 (P->X[1] < (PhaseTrans->bounds[2]-dyBox)) | (P->X[1] > (PhaseTrans->bounds[3]+dyBox)) |
+					 (P->X[2] < (PhaseTrans->bounds[4]-dzBox)) | (P->X[2] > (PhaseTrans->bounds[5]+dzBox))  )
+				{
+					ph = P->phase;				// do not change the phase
 				}
-				else{
-					// Above to below
-					if (InsideAbove==0){
-						if (PhaseTrans->Reset==1){
-							P->APS = 0.0;
-						}
-					}
+			}
+		}
+		if (PhaseTrans->PhaseDirection==0){
+			P->phase    =   ph;
+		}
+		else if ( (PhaseTrans->PhaseDirection==1) & (below>=0) ){
+			P->phase    =   ph;
+		}
+		else if ( (PhaseTrans->PhaseDirection==2) & (above>=0) ){
+			P->phase    =   ph;
+		}
+		P->T = T;	// set T
 
+		// Reset other parameters on particles if requested
+		if (PhaseTrans->PhaseDirection< 2){
 
+			// Both ways or below2above	
+			if (InsideAbove==1){
+				if (PhaseTrans->Reset==1){
+					P->APS = 0.0;
 				}
 			}
-			else{
-				// allow cases in which we only reset T
-				ph 			= P->phase;
-				InsideAbove = 0;
-				Transition(PhaseTrans, P, PH1, PH2, jr->ctrl, scal, svCell, &ph, &T, &InsideAbove, time, jr, ID);
-
-				if ( (PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_ ) ){
-					if (PhaseTrans->PhaseInside[0]<0){ 
-						ph 		= P->phase;				// do not change the phase
-					}
-					
-					if ((PhaseTrans->PhaseOutside[0]<0) & (PhaseTrans->PhaseDirection==2) & (InsideAbove==1)){ 	
-						// PhaseOutside is set to -1 and OutsideToInside is selected, in which case we 
-						// set everything inside the box to a constant phase (specified in PhaseInside)
-						ph = PhaseTrans->PhaseInside[0];
-						P->phase = ph;
-					}
-					
-					P->T 	= T;	// set T
+		}
+		else{
+			// Above to below
+			if (InsideAbove==0){
+				if (PhaseTrans->Reset==1){
+					P->APS = 0.0;
 				}
 			}
+		}
+	}
+	else if ( (PhaseTrans->Type == _Box_ || PhaseTrans->Type == _NotInAirBox_ ) )
+	{
+		// allow cases in which we only reset T
+		ph 			= P->phase;
+		InsideAbove = 0;
 
+		Transition(PhaseTrans, P, PH1, PH2, ctrl, scal, svCell, &ph, &T, &InsideAbove, time, jr, ID);
 
+		if (PhaseTrans->PhaseInside[0]<0){ 
+			ph 		= P->phase;				// do not change the phase
 		}
-
+		
+		if ((PhaseTrans->PhaseOutside[0]<0) & (PhaseTrans->PhaseDirection==2) & (InsideAbove==1)){ 	
+			// PhaseOutside is set to -1 and OutsideToInside is selected, in which case we 
+			// set everything inside the box to a constant phase (specified in PhaseInside)
+			ph = PhaseTrans->PhaseInside[0];
+			P->phase = ph;
+		}
+		
+		P->T 	= T;	// set T
 	}
-	ierr = ADVInterpMarkToCell(actx);   CHKERRQ(ierr);
-
-    	PrintDone(t);
-	PetscFunctionReturn(0);
 }
-
 //----------------------------------------------------------------------------------------
 
 PetscErrorCode MovingBox(Ph_trans_t *PhaseTrans, TSSol *ts, JacRes *jr)
@@ -36,6 +36,10 @@ PetscErrorCode Set_NotInAirBox_Phase_Transition(Ph_trans_t *ph, DBMat *dbm, FB *
 PetscErrorCode SetClapeyron_Eq(Ph_trans_t *ph);
 PetscErrorCode Overwrite_density(DBMat *dbm);
 PetscErrorCode Phase_Transition(AdvCtx *actx);
+PetscErrorCode Phase_Transition_SetupTables(JacRes *jr, PetscInt *ind_below, PetscInt *ind_above,
+			  PetscInt *law_nphc, PetscBool *law_box, PetscBool *ph_act, PetscBool *cell_box);
+void Phase_Transition_Marker(Ph_trans_t *PhaseTrans, Marker *P, PetscInt below, PetscInt above, PetscInt nphc,
+			  Controls ctrl, Scaling *scal, SolVarCell *svCell, PetscScalar time, JacRes *jr, PetscInt ID);
 PetscInt Transition(Ph_trans_t *PhaseTrans, Marker *P, PetscInt PH1,PetscInt PH2, 
 			  Controls ctrl,Scaling *scal, SolVarCell *svCell, PetscInt *ph, PetscScalar *T, PetscInt *InsideAbove, PetscScalar, JacRes *jr, PetscInt cellID);
 PetscInt Check_Phase_above_below(PetscInt *phase_array, Marker *P,PetscInt num_phas);
@@ -475,6 +475,9 @@ PetscErrorCode ADVCollectGarbageVec(AdvCtx *actx, vector <Marker> &recvbuf, vect
 	// store new number of markers
 	actx->nummark = nummark;
 
+	// release unused storage
+	ierr = ADVShrinkStorage(actx); CHKERRQ(ierr);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -52,7 +52,7 @@ PetscErrorCode FreeSurfCreate(FreeSurf *surf, FB *fb)
 	ierr = getScalarParam(fb, _REQUIRED_, "surf_level",         &surf->InitLevel,     1,  scal->length); CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _REQUIRED_, "surf_air_phase",     &surf->AirPhase,      1,  maxPhaseID);   CHKERRQ(ierr);
 	ierr = getScalarParam(fb, _OPTIONAL_, "surf_max_angle",     &surf->MaxAngle,      1,  scal->angle);  CHKERRQ(ierr);
-	ierr = getIntParam   (fb, _OPTIONAL_, "erosion_model",      &surf->ErosionModel,  1,  2);            CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "erosion_model",      &surf->ErosionModel,  1,  3);            CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "sediment_model",     &surf->SedimentModel, 1,  3);            CHKERRQ(ierr);
 
 	if(surf->ErosionModel == 2)
@@ -63,6 +63,36 @@ PetscErrorCode FreeSurfCreate(FreeSurf *surf, FB *fb)
 		ierr = getScalarParam(fb, _REQUIRED_, "er_rates",        surf->erRates,   surf->numErPhs,   scal->velocity);    CHKERRQ(ierr);
 		ierr = getScalarParam(fb, _REQUIRED_, "er_levels",       surf->erLevels,  surf->numErPhs,   scal->length);    CHKERRQ(ierr);
 	}
+	if(surf->ErosionModel == 3)
+	{
+		// surface process model parameters
+		surf->spM        = 0.5;
+		surf->spN        = 1.0;
+		surf->spSubSteps = 1;
+
+		ierr = getScalarParam(fb, _OPTIONAL_, "sp_kappa",     &surf->spKappa,    1, scal->area_si/scal->time_si); CHKERRQ(ierr);
+		ierr = getScalarParam(fb, _OPTIONAL_, "sp_m",         &surf->spM,        1, 1.0);                         CHKERRQ(ierr);
+		ierr = getScalarParam(fb, _OPTIONAL_, "sp_n",         &surf->spN,        1, 1.0);                         CHKERRQ(ierr);
+		ierr = getScalarParam(fb, _OPTIONAL_, "sp_kf",        &surf->spKf,       1, PetscPowScalar(scal->length_si, 1.0-2.0*surf->spM)/scal->time_si); CHKERRQ(ierr);
+		ierr = getIntParam   (fb, _OPTIONAL_, "sp_sub_steps", &surf->spSubSteps, 1, -1);                          CHKERRQ(ierr);
+
+		if(surf->spKappa < 0.0 || surf->spKf < 0.0)
+		{
+			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Surface process coefficients must be non-negative (sp_kappa, sp_kf)");
+		}
+		if(!surf->spKappa && !surf->spKf)
+		{
+			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Specify at least one positive surface process coefficient (sp_kappa, sp_kf)");
+		}
+		if(surf->spN <= 0.0)
+		{
+			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Slope exponent must be positive (sp_n)");
+		}
+		if(surf->spSubSteps < 1)
+		{
+			SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Number of surface process sub-steps must be positive (sp_sub_steps)");
+		}
+	}
 	if(surf->SedimentModel == 1 || surf->SedimentModel == 2 || surf->SedimentModel == 3 )
 	{
 		// sedimentation model parameters
@@ -99,6 +129,15 @@ PetscErrorCode FreeSurfCreate(FreeSurf *surf, FB *fb)
 	if      (surf->ErosionModel == 0)  PetscPrintf(PETSC_COMM_WORLD, "none\n");
 	else if (surf->ErosionModel == 1)  PetscPrintf(PETSC_COMM_WORLD, "infinitely fast\n");
 	else if (surf->ErosionModel == 2)  PetscPrintf(PETSC_COMM_WORLD, "prescribed rate with given level\n");
+	else if (surf->ErosionModel == 3)  PetscPrintf(PETSC_COMM_WORLD, "surface processes (hillslope diffusion + stream power)\n");
+
+	if(surf->ErosionModel == 3)
+	{
+		PetscPrintf(PETSC_COMM_WORLD, "   Hillslope diffusivity     : %g \n",    surf->spKappa*scal->area_si/scal->time_si);
+		PetscPrintf(PETSC_COMM_WORLD, "   Stream-power coefficient  : %g \n",    surf->spKf*PetscPowScalar(scal->length_si, 1.0-2.0*surf->spM)/scal->time_si);
+		PetscPrintf(PETSC_COMM_WORLD, "   Stream-power exponents    : m = %g, n = %g \n", surf->spM, surf->spN);
+		PetscPrintf(PETSC_COMM_WORLD, "   Number of sub-steps       : %lld \n",  (LLD)surf->spSubSteps);
+	}
    
 	PetscPrintf(PETSC_COMM_WORLD, "   Sedimentation model       : ");
 	if      (surf->SedimentModel == 0) PetscPrintf(PETSC_COMM_WORLD, "none\n");
@@ -161,6 +200,21 @@ PetscErrorCode FreeSurfCreateData(FreeSurf *surf)
 	ierr = DMCreateGlobalVector(surf->DA_SURF, &surf->vpatch); CHKERRQ(ierr);
 	ierr = DMCreateGlobalVector(surf->DA_SURF, &surf->vmerge); CHKERRQ(ierr);
 
+	if(surf->ErosionModel == 3)
+	{
+		// create hillslope diffusion matrix & solver
+		ierr = DMCreateMatrix(surf->DA_SURF, &surf->spMat); CHKERRQ(ierr);
+
+		ierr = MatSetOption(surf->spMat, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE); CHKERRQ(ierr);
+		ierr = MatSetOption(surf->spMat, MAT_KEEP_NONZERO_PATTERN, PETSC_TRUE);       CHKERRQ(ierr);
+
+		ierr = KSPCreate(PETSC_COMM_WORLD, &surf->spKSP);             CHKERRQ(ierr);
+		ierr = KSPSetOptionsPrefix(surf->spKSP, "sp_");               CHKERRQ(ierr);
+		ierr = KSPSetType(surf->spKSP, KSPCG);                        CHKERRQ(ierr);
+		ierr = KSPSetInitialGuessNonzero(surf->spKSP, PETSC_TRUE);    CHKERRQ(ierr);
+		ierr = KSPSetFromOptions(surf->spKSP);                        CHKERRQ(ierr);
+	}
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -237,6 +291,12 @@ PetscErrorCode FreeSurfDestroy(FreeSurf *surf)
 	ierr = VecDestroy(&surf->vpatch);  CHKERRQ(ierr);
 	ierr = VecDestroy(&surf->vmerge);  CHKERRQ(ierr);
 
+	if(surf->ErosionModel == 3)
+	{
+		ierr = MatDestroy(&surf->spMat); CHKERRQ(ierr);
+		ierr = KSPDestroy(&surf->spKSP); CHKERRQ(ierr);
+	}
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -286,6 +346,7 @@ PetscErrorCode FreeSurfGetVelComp(
 	FDSTAG      *fs;
 	Discret1D   *dsz;
 	InterpFlags iflags;
+	Vec         lbcor;
 	PetscScalar bz, ez;
 	PetscInt    i, j, nx, ny, sx, sy, sz, level, K;
 	PetscScalar ***topo, ***vsurf, ***vgrid, *vpatch, *vmerge, z, w;
@@ -309,17 +370,20 @@ PetscErrorCode FreeSurfGetVelComp(
 	iflags.update    = 0; // overwrite vectors
 	iflags.use_bound = 1; // use boundary values
 
+	// borrow corner buffer
+	ierr = DMGetLocalVector(fs->DA_COR, &lbcor); CHKERRQ(ierr);
+
 	// interpolate velocity component from grid faces to corners
-	ierr = interp(fs, vcomp_grid, jr->lbcor, iflags); CHKERRQ(ierr);
+	ierr = interp(fs, vcomp_grid, lbcor, iflags); CHKERRQ(ierr);
 
 	// load ghost values
-	LOCAL_TO_LOCAL(fs->DA_COR, jr->lbcor)
+	LOCAL_TO_LOCAL(fs->DA_COR, lbcor)
 
 	// clear surface velocity patch vector
 	ierr = VecZeroEntries(surf->vpatch); CHKERRQ(ierr);
 
 	// access topograpy, grid and surface velocity
-	ierr = DMDAVecGetArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 	ierr = DMDAVecGetArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 	ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 
@@ -347,10 +411,13 @@ PetscErrorCode FreeSurfGetVelComp(
 	END_PLANE_LOOP
 
 	// restore access
-	ierr = DMDAVecRestoreArray(fs->DA_COR,    jr->lbcor,    &vgrid); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fs->DA_COR,    lbcor,        &vgrid); CHKERRQ(ierr);
 	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->vpatch, &vsurf); CHKERRQ(ierr);
 	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo,  &topo);  CHKERRQ(ierr);
 
+	// return corner buffer
+	ierr = DMRestoreLocalVector(fs->DA_COR, &lbcor); CHKERRQ(ierr);
+
 	// merge velocity patches
 	// compute ghosted version of the velocity component
 	if(dsz->nproc != 1 )
@@ -697,13 +764,16 @@ PetscErrorCode FreeSurfSmoothMaxAngle(FreeSurf *surf)
 PetscErrorCode FreeSurfGetAirPhaseRatio(FreeSurf *surf)
 {
 	// compute proper phase ratio of air phase
+	// only cells crossed by the free surface are corrected, cells entirely
+	// below or above the surface are already consistent after the marker phase
+	// correction (see ADVMarkCrossFreeSurf)
 
 	JacRes      *jr;
 	FDSTAG      *fs;
 	PetscScalar cx[5], cy[5], cz[5];
-	PetscScalar ***topo, *phRat, vcell, phRatAir, gtol, cf;
-	PetscScalar xleft, xright, yfront, yback, zbot, ztop;
-	PetscInt    L, jj, iter, numPhases, AirPhase;
+	PetscScalar ***topo, *phRat, *ncz, vcell, phRatAir, gtol, cf;
+	PetscScalar xleft, xright, yfront, yback, zbot, ztop, zmin, zmax;
+	PetscInt    L, jj, numPhases, AirPhase, ks, ke, lo, hi, mid;
 	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz;
 
 	// cell triangulation
@@ -731,18 +801,48 @@ PetscErrorCode FreeSurfGetAirPhaseRatio(FreeSurf *surf)
 	gtol      = fs->gtol;
 	numPhases = jr->dbm->numPhases;
 	L         = (PetscInt)fs->dsz.rank;
-	iter      = 0;
+	ncz       = fs->dsz.ncoor;
 
 	// access surface topography
 	ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo,  &topo); CHKERRQ(ierr);
 
-	// scan all local cells
+	// scan all local columns
 	ierr = DMDAGetCorners(fs->DA_CEN, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
 
-	START_STD_LOOP
+	START_PLANE_LOOP
 	{
-		// access phase ratio array
-		phRat = jr->svCell[iter++].phRat;
+		// get topography at cell corners
+		cz[0]  = topo[L][j  ][i  ];
+		cz[1]  = topo[L][j  ][i+1];
+		cz[2]  = topo[L][j+1][i  ];
+		cz[3]  = topo[L][j+1][i+1];
+		cz[4]  = (cz[0] + cz[1] + cz[2] + cz[3])/4.0;
+
+		// get z-bounds of the free surface in the column
+		zmin = cz[0]; zmax = cz[0];
+
+		for(jj = 1; jj < 4; jj++)
+		{
+			if(cz[jj] < zmin) zmin = cz[jj];
+			if(cz[jj] > zmax) zmax = cz[jj];
+		}
+
+		// find first cell with top above minimum
+		lo = 0; hi = nz;
+
+		while(lo < hi) { mid = (lo + hi)/2; if(ncz[mid+1] > zmin) hi = mid; else lo = mid + 1; }
+
+		ks = lo;
+
+		// find first cell with bottom above maximum
+		hi = nz;
+
+		while(lo < hi) { mid = (lo + hi)/2; if(ncz[mid] >= zmax) hi = mid; else lo = mid + 1; }
+
+		ke = lo;
+
+		// skip columns not crossed by the free surface
+		if(ks == ke) continue;
 
 		// get cell bounds
 		xleft  = COORD_NODE(i,   sx, fs->dsx);
@@ -751,12 +851,6 @@ PetscErrorCode FreeSurfGetAirPhaseRatio(FreeSurf *surf)
 		yfront = COORD_NODE(j,   sy, fs->dsy);
 		yback  = COORD_NODE(j+1, sy, fs->dsy);
 
-		zbot   = COORD_NODE(k,   sz, fs->dsz);
-		ztop   = COORD_NODE(k+1, sz, fs->dsz);
-
-		// get cell volume
-		vcell  = (xright - xleft)*(yback - yfront)*(ztop - zbot);
-
 		// setup coordinate arrays
 		cx[0]  = xleft;
 		cx[1]  = xright;
@@ -770,40 +864,47 @@ PetscErrorCode FreeSurfGetAirPhaseRatio(FreeSurf *surf)
 		cy[3]  = yback;
 		cy[4]  = (yfront + yback)/2.0;
 
-		cz[0]  = topo[L][j  ][i  ];
-		cz[1]  = topo[L][j  ][i+1];
-		cz[2]  = topo[L][j+1][i  ];
-		cz[3]  = topo[L][j+1][i+1];
-		cz[4]  = (cz[0] + cz[1] + cz[2] + cz[3])/4.0;
+		// scan cells crossed by the free surface
+		for(k = sz + ks; k < sz + ke; k++)
+		{
+			// access phase ratio array
+			phRat = jr->svCell[(i-sx) + (j-sy)*nx + (k-sz)*nx*ny].phRat;
 
-		// compute actual air phase ratio in the cell
-		phRatAir = 1.0;
+			zbot   = COORD_NODE(k,   sz, fs->dsz);
+			ztop   = COORD_NODE(k+1, sz, fs->dsz);
 
-		for(jj = 0; jj < 4; jj++)
-		{
-			phRatAir -= IntersectTriangularPrism(cx, cy, cz, tria + 3*jj, vcell, zbot, ztop, gtol);
-		}
+			// get cell volume
+			vcell  = (xright - xleft)*(yback - yfront)*(ztop - zbot);
 
-		// normalize cell phase ratio if necessary
-		if(phRat[AirPhase] != 1.0)
-		{
-			// get scaling factor
-			cf = (1.0 - phRatAir)/(1.0 - phRat[AirPhase]);
+			// compute actual air phase ratio in the cell
+			phRatAir = 1.0;
 
-			// scale solid phases
-			for(jj = 0; jj < numPhases; jj++)
+			for(jj = 0; jj < 4; jj++)
 			{
-				if(jj != AirPhase) phRat[jj] *= cf;
+				phRatAir -= IntersectTriangularPrism(cx, cy, cz, tria + 3*jj, vcell, zbot, ztop, gtol);
 			}
 
-			// correct air phase
-			phRat[AirPhase] = phRatAir;
-		}
+			// normalize cell phase ratio if necessary
+			if(phRat[AirPhase] != 1.0)
+			{
+				// get scaling factor
+				cf = (1.0 - phRatAir)/(1.0 - phRat[AirPhase]);
 
-		// WARNING !!!
-		// think what to do if(phRat[AirPhase] == 1.0 && phRatAir != 1.0)
+				// scale solid phases
+				for(jj = 0; jj < numPhases; jj++)
+				{
+					if(jj != AirPhase) phRat[jj] *= cf;
+				}
+
+				// correct air phase
+				phRat[AirPhase] = phRatAir;
+			}
+
+			// WARNING !!!
+			// think what to do if(phRat[AirPhase] == 1.0 && phRatAir != 1.0)
+		}
 	}
-	END_STD_LOOP
+	END_PLANE_LOOP
 
 	// restore access
 	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo, &topo); CHKERRQ(ierr);
@@ -903,6 +1004,11 @@ PetscErrorCode FreeSurfAppErosion(FreeSurf *surf)
 		PetscPrintf(PETSC_COMM_WORLD, "Applying erosion at constant rate (%f %s) to internal free surface.\n", rate*scal->velocity, scal->lbl_velocity);
 		PetscPrintf(PETSC_COMM_WORLD, "Applying erosion at constant level (%e %s) to internal free surface.\n", level*scal->length, scal->lbl_length);
 	}
+	// Surface processes
+	else if(surf->ErosionModel == 3)
+	{
+		ierr = FreeSurfAppSurfProc(surf); CHKERRQ(ierr);
+	}
 
 	PetscFunctionReturn(0);
 }
@@ -1192,6 +1298,451 @@ PetscErrorCode FreeSurfAppSedimentation(FreeSurf *surf)
 	}
 
 	
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FreeSurfAppSurfProc(FreeSurf *surf)
+{
+	// apply hillslope diffusion & stream-power incision to the free surface
+
+	JacRes      *jr;
+	FDSTAG      *fs;
+	Scaling     *scal;
+	Vec          lrec, lacc, gacc, rhs;
+	PetscScalar ***topo, ***b, *hbuf;
+	PetscScalar dt, zbot, ztop, z;
+	PetscInt    *perm, isub, n, L, mx, my;
+	PetscInt    i, j, nx, ny, sx, sy, sz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access context
+	jr   = surf->jr;
+	fs   = jr->fs;
+	scal = jr->scal;
+	L    = (PetscInt)fs->dsz.rank;
+	mx   = fs->dsx.tnods;
+	my   = fs->dsy.tnods;
+
+	// get sub-step
+	dt = jr->ts->dt/(PetscScalar)surf->spSubSteps;
+
+	// get size of box
+	ierr = FDSTAGGetGlobalBox(fs, NULL, NULL, &zbot, NULL, NULL, &ztop); CHKERRQ(ierr);
+
+	// get local free surface points
+	ierr = DMDAGetCorners(fs->DA_COR, &sx, &sy, &sz, &nx, &ny, NULL); CHKERRQ(ierr);
+
+	n = nx*ny;
+
+	// allocate work storage
+	ierr = PetscMalloc1(n, &perm); CHKERRQ(ierr);
+	ierr = PetscMalloc1(n, &hbuf); CHKERRQ(ierr);
+
+	ierr = DMGetLocalVector (surf->DA_SURF, &lrec); CHKERRQ(ierr);
+	ierr = DMGetLocalVector (surf->DA_SURF, &lacc); CHKERRQ(ierr);
+	ierr = DMGetGlobalVector(surf->DA_SURF, &gacc); CHKERRQ(ierr);
+	ierr = DMGetGlobalVector(surf->DA_SURF, &rhs);  CHKERRQ(ierr);
+
+	// assemble diffusion matrix (constant within time step)
+	if(surf->spKappa)
+	{
+		ierr = FreeSurfSPSetMatrix(surf, dt); CHKERRQ(ierr);
+	}
+
+	for(isub = 0; isub < surf->spSubSteps; isub++)
+	{
+		// stream-power incision
+		if(surf->spKf)
+		{
+			ierr = FreeSurfSPGetReceivers(surf, lrec);                          CHKERRQ(ierr);
+			ierr = FreeSurfSPGetDrainArea(surf, lrec, lacc, gacc, perm, hbuf); CHKERRQ(ierr);
+			ierr = FreeSurfSPIncise      (surf, lrec, lacc, dt);               CHKERRQ(ierr);
+		}
+
+		// hillslope diffusion (backward Euler)
+		if(surf->spKappa)
+		{
+			ierr = DMDAVecGetArray(surf->DA_SURF, surf->gtopo, &topo); CHKERRQ(ierr);
+			ierr = DMDAVecGetArray(surf->DA_SURF, rhs,         &b);    CHKERRQ(ierr);
+
+			START_PLANE_LOOP
+			{
+				b[L][j][i] = SIZE_SURF_NODE(i, sx, mx, fs->dsx)*SIZE_SURF_NODE(j, sy, my, fs->dsy)/dt*topo[L][j][i];
+			}
+			END_PLANE_LOOP
+
+			ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->gtopo, &topo); CHKERRQ(ierr);
+			ierr = DMDAVecRestoreArray(surf->DA_SURF, rhs,         &b);    CHKERRQ(ierr);
+
+			ierr = KSPSolve(surf->spKSP, rhs, surf->gtopo); CHKERRQ(ierr);
+		}
+
+		// check if internal free surface goes outside the model domain
+		ierr = DMDAVecGetArray(surf->DA_SURF, surf->gtopo, &topo); CHKERRQ(ierr);
+
+		START_PLANE_LOOP
+		{
+			z = topo[L][j][i];
+
+			if(z > ztop) z = ztop;
+			if(z < zbot) z = zbot;
+
+			topo[L][j][i] = z;
+		}
+		END_PLANE_LOOP
+
+		ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->gtopo, &topo); CHKERRQ(ierr);
+
+		// compute ghosted version of the topography
+		GLOBAL_TO_LOCAL(surf->DA_SURF, surf->gtopo, surf->ltopo);
+	}
+
+	// free work storage
+	ierr = DMRestoreLocalVector (surf->DA_SURF, &lrec); CHKERRQ(ierr);
+	ierr = DMRestoreLocalVector (surf->DA_SURF, &lacc); CHKERRQ(ierr);
+	ierr = DMRestoreGlobalVector(surf->DA_SURF, &gacc); CHKERRQ(ierr);
+	ierr = DMRestoreGlobalVector(surf->DA_SURF, &rhs);  CHKERRQ(ierr);
+
+	ierr = PetscFree(perm); CHKERRQ(ierr);
+	ierr = PetscFree(hbuf); CHKERRQ(ierr);
+
+	// compute & store average topography
+	ierr = FreeSurfGetAvgTopo(surf); CHKERRQ(ierr);
+
+	PetscPrintf(PETSC_COMM_WORLD, "Applying surface processes to internal free surface (%lld sub-steps). Average free surface height = %e %s\n",
+		(LLD)surf->spSubSteps, surf->avg_topo*scal->length, scal->lbl_length);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FreeSurfSPSetMatrix(FreeSurf *surf, PetscScalar dt)
+{
+	// assemble hillslope diffusion matrix (node control volumes, no-flux boundaries)
+
+	FDSTAG      *fs;
+	MatStencil  row, col[5];
+	PetscScalar v[5], wx, wy, c, kappa;
+	PetscInt    L, mx, my, m;
+	PetscInt    i, j, nx, ny, sx, sy;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access context
+	fs    = surf->jr->fs;
+	kappa = surf->spKappa;
+	L     = (PetscInt)fs->dsz.rank;
+	mx    = fs->dsx.tnods;
+	my    = fs->dsy.tnods;
+
+	// clear matrix coefficients
+	ierr = MatZeroEntries(surf->spMat); CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(fs->DA_COR, &sx, &sy, NULL, &nx, &ny, NULL); CHKERRQ(ierr);
+
+	START_PLANE_LOOP
+	{
+		// get control volume size
+		wx = SIZE_SURF_NODE(i, sx, mx, fs->dsx);
+		wy = SIZE_SURF_NODE(j, sy, my, fs->dsy);
+
+		row.k = L; row.j = j; row.i = i; row.c = 0;
+
+		m = 0;
+
+		// storage term
+		v[4] = wx*wy/dt;
+
+		// fluxes through control volume faces
+		if(i > 0)
+		{
+			c = kappa*wy/(COORD_NODE(i, sx, fs->dsx) - COORD_NODE(i-1, sx, fs->dsx));
+			col[m].k = L; col[m].j = j; col[m].i = i-1; col[m].c = 0; v[m++] = -c; v[4] += c;
+		}
+		if(i < mx-1)
+		{
+			c = kappa*wy/(COORD_NODE(i+1, sx, fs->dsx) - COORD_NODE(i, sx, fs->dsx));
+			col[m].k = L; col[m].j = j; col[m].i = i+1; col[m].c = 0; v[m++] = -c; v[4] += c;
+		}
+		if(j > 0)
+		{
+			c = kappa*wx/(COORD_NODE(j, sy, fs->dsy) - COORD_NODE(j-1, sy, fs->dsy));
+			col[m].k = L; col[m].j = j-1; col[m].i = i; col[m].c = 0; v[m++] = -c; v[4] += c;
+		}
+		if(j < my-1)
+		{
+			c = kappa*wx/(COORD_NODE(j+1, sy, fs->dsy) - COORD_NODE(j, sy, fs->dsy));
+			col[m].k = L; col[m].j = j+1; col[m].i = i; col[m].c = 0; v[m++] = -c; v[4] += c;
+		}
+
+		// diagonal
+		col[m].k = L; col[m].j = j; col[m].i = i; col[m].c = 0; v[m++] = v[4];
+
+		ierr = MatSetValuesStencil(surf->spMat, 1, &row, m, col, v, INSERT_VALUES); CHKERRQ(ierr);
+	}
+	END_PLANE_LOOP
+
+	ierr = MatAssemblyBegin(surf->spMat, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+	ierr = MatAssemblyEnd  (surf->spMat, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+
+	ierr = KSPSetOperators(surf->spKSP, surf->spMat, surf->spMat); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FreeSurfSPGetReceivers(FreeSurf *surf, Vec lrec)
+{
+	// compute steepest descent (D8) receivers of local nodes & fill ghost points
+	// receiver is stored as direction code (-1 - none)
+
+	FDSTAG      *fs;
+	PetscScalar ***topo, ***rec;
+	PetscScalar h, x, y, dx, dy, s, smax;
+	PetscInt    L, mx, my, d, r, I, J;
+	PetscInt    i, j, nx, ny, sx, sy;
+
+	// neighbor offsets
+	PetscInt di[] = { -1,  0,  1, -1,  1, -1,  0,  1 };
+	PetscInt dj[] = { -1, -1, -1,  0,  0,  1,  1,  1 };
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access context
+	fs = surf->jr->fs;
+	L  = (PetscInt)fs->dsz.rank;
+	mx = fs->dsx.tnods;
+	my = fs->dsy.tnods;
+
+	ierr = VecSet(lrec, -1.0); CHKERRQ(ierr);
+
+	ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo, &topo); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(surf->DA_SURF, lrec,        &rec);  CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(fs->DA_COR, &sx, &sy, NULL, &nx, &ny, NULL); CHKERRQ(ierr);
+
+	START_PLANE_LOOP
+	{
+		// model boundary nodes are outlets
+		if(i == 0 || i == mx-1 || j == 0 || j == my-1) continue;
+
+		h    = topo[L][j][i];
+		x    = COORD_NODE(i, sx, fs->dsx);
+		y    = COORD_NODE(j, sy, fs->dsy);
+		smax = 0.0;
+		r    = -1;
+
+		for(d = 0; d < 8; d++)
+		{
+			I  = i + di[d];
+			J  = j + dj[d];
+			dx = COORD_NODE(I, sx, fs->dsx) - x;
+			dy = COORD_NODE(J, sy, fs->dsy) - y;
+			s  = (h - topo[L][J][I])/PetscSqrtReal(dx*dx + dy*dy);
+
+			if(s > smax) { smax = s; r = d; }
+		}
+
+		rec[L][j][i] = (PetscScalar)r;
+	}
+	END_PLANE_LOOP
+
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo, &topo); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, lrec,        &rec);  CHKERRQ(ierr);
+
+	// fill ghost points
+	LOCAL_TO_LOCAL(surf->DA_SURF, lrec)
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FreeSurfSPGetDrainArea(FreeSurf *surf, Vec lrec, Vec lacc, Vec gacc, PetscInt *perm, PetscScalar *hbuf)
+{
+	// accumulate drainage area along flow paths
+	// local nodes are processed in order of decreasing height, contributions
+	// of donors on neighbor processors are taken from the previous iteration
+
+	FDSTAG      *fs;
+	PetscScalar ***topo, ***rec, ***acc, ***gac;
+	PetscScalar a, chg, gchg;
+	PetscInt    L, mx, my, d, r, I, J, n, ii, iter, maxit;
+	PetscInt    i, j, nx, ny, sx, sy;
+
+	// neighbor offsets
+	PetscInt di[] = { -1,  0,  1, -1,  1, -1,  0,  1 };
+	PetscInt dj[] = { -1, -1, -1,  0,  0,  1,  1,  1 };
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access context
+	fs    = surf->jr->fs;
+	L     = (PetscInt)fs->dsz.rank;
+	mx    = fs->dsx.tnods;
+	my    = fs->dsy.tnods;
+	maxit = mx*my;
+
+	ierr = DMDAGetCorners(fs->DA_COR, &sx, &sy, NULL, &nx, &ny, NULL); CHKERRQ(ierr);
+
+	n = nx*ny;
+
+	// sort local nodes by height
+	ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo, &topo); CHKERRQ(ierr);
+
+	ii = 0;
+
+	START_PLANE_LOOP
+	{
+		hbuf[ii] = topo[L][j][i];
+		perm[ii] = ii;
+		ii++;
+	}
+	END_PLANE_LOOP
+
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo, &topo); CHKERRQ(ierr);
+
+	ierr = PetscSortRealWithPermutation(n, hbuf, perm); CHKERRQ(ierr);
+
+	ierr = VecZeroEntries(lacc); CHKERRQ(ierr);
+
+	for(iter = 0; iter < maxit; iter++)
+	{
+		ierr = DMDAVecGetArray(surf->DA_SURF, lrec, &rec); CHKERRQ(ierr);
+		ierr = DMDAVecGetArray(surf->DA_SURF, lacc, &acc); CHKERRQ(ierr);
+		ierr = DMDAVecGetArray(surf->DA_SURF, gacc, &gac); CHKERRQ(ierr);
+
+		// set node areas & add inflow from donors on neighbor processors
+		START_PLANE_LOOP
+		{
+			a = SIZE_SURF_NODE(i, sx, mx, fs->dsx)*SIZE_SURF_NODE(j, sy, my, fs->dsy);
+
+			for(d = 0; d < 8; d++)
+			{
+				I = i + di[d];
+				J = j + dj[d];
+
+				// skip nodes outside domain & local nodes
+				if(I < 0  || I >= mx    || J < 0  || J >= my)    continue;
+				if(I >= sx && I < sx+nx && J >= sy && J < sy+ny) continue;
+
+				r = (PetscInt)rec[L][J][I];
+
+				if(r >= 0 && I + di[r] == i && J + dj[r] == j) a += acc[L][J][I];
+			}
+
+			gac[L][j][i] = a;
+		}
+		END_PLANE_LOOP
+
+		// accumulate along local flow paths (donors are always higher than receivers)
+		for(ii = n-1; ii >= 0; ii--)
+		{
+			i = sx + perm[ii] % nx;
+			j = sy + perm[ii] / nx;
+			r = (PetscInt)rec[L][j][i];
+
+			if(r < 0) continue;
+
+			I = i + di[r];
+			J = j + dj[r];
+
+			if(I >= sx && I < sx+nx && J >= sy && J < sy+ny) gac[L][J][I] += gac[L][j][i];
+		}
+
+		// get change with respect to previous iteration
+		chg = 0.0;
+
+		START_PLANE_LOOP
+		{
+			a = PetscAbsScalar(gac[L][j][i] - acc[L][j][i]);
+
+			if(a > chg) chg = a;
+		}
+		END_PLANE_LOOP
+
+		ierr = DMDAVecRestoreArray(surf->DA_SURF, lrec, &rec); CHKERRQ(ierr);
+		ierr = DMDAVecRestoreArray(surf->DA_SURF, lacc, &acc); CHKERRQ(ierr);
+		ierr = DMDAVecRestoreArray(surf->DA_SURF, gacc, &gac); CHKERRQ(ierr);
+
+		// fill ghost points
+		GLOBAL_TO_LOCAL(surf->DA_SURF, gacc, lacc);
+
+		if(ISParallel(PETSC_COMM_WORLD))
+		{
+			ierr = MPI_Allreduce(&chg, &gchg, 1, MPIU_SCALAR, MPI_MAX, PETSC_COMM_WORLD); CHKERRQ(ierr);
+		}
+		else
+		{
+			gchg = chg;
+		}
+
+		// accumulation is exact, stop as soon as nothing changes
+		if(gchg == 0.0) break;
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode FreeSurfSPIncise(FreeSurf *surf, Vec lrec, Vec lacc, PetscScalar dt)
+{
+	// apply stream-power incision E = Kf*A^m*S^n
+	// (node is never incised below its receiver)
+
+	FDSTAG      *fs;
+	PetscScalar ***topo, ***gtopo, ***rec, ***acc;
+	PetscScalar h, hr, dx, dy, S, dz;
+	PetscInt    L, r, I, J;
+	PetscInt    i, j, nx, ny, sx, sy;
+
+	// neighbor offsets
+	PetscInt di[] = { -1,  0,  1, -1,  1, -1,  0,  1 };
+	PetscInt dj[] = { -1, -1, -1,  0,  0,  1,  1,  1 };
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// access context
+	fs = surf->jr->fs;
+	L  = (PetscInt)fs->dsz.rank;
+
+	ierr = DMDAVecGetArray(surf->DA_SURF, surf->ltopo, &topo);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(surf->DA_SURF, surf->gtopo, &gtopo); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(surf->DA_SURF, lrec,        &rec);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(surf->DA_SURF, lacc,        &acc);   CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(fs->DA_COR, &sx, &sy, NULL, &nx, &ny, NULL); CHKERRQ(ierr);
+
+	START_PLANE_LOOP
+	{
+		r = (PetscInt)rec[L][j][i];
+
+		if(r < 0) continue;
+
+		I  = i + di[r];
+		J  = j + dj[r];
+		h  = topo[L][j][i];
+		hr = topo[L][J][I];
+		dx = COORD_NODE(I, sx, fs->dsx) - COORD_NODE(i, sx, fs->dsx);
+		dy = COORD_NODE(J, sy, fs->dsy) - COORD_NODE(j, sy, fs->dsy);
+		S  = (h - hr)/PetscSqrtReal(dx*dx + dy*dy);
+		dz = surf->spKf*PetscPowScalar(acc[L][j][i], surf->spM)*PetscPowScalar(S, surf->spN)*dt;
+
+		if(dz > h - hr) dz = h - hr;
+
+		gtopo[L][j][i] = h - dz;
+	}
+	END_PLANE_LOOP
+
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->ltopo, &topo);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, surf->gtopo, &gtopo); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, lrec,        &rec);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(surf->DA_SURF, lacc,        &acc);   CHKERRQ(ierr);
+
+	// compute ghosted version of the topography
+	GLOBAL_TO_LOCAL(surf->DA_SURF, surf->gtopo, surf->ltopo);
+
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
@@ -40,7 +40,7 @@ struct FreeSurf
 	PetscScalar MaxAngle;    // maximum angle with horizon (smoothed if larger)
 
 	// erosion/sedimentation parameters
-	PetscInt    ErosionModel;               // [0-none, 1-infinitely fast, 2-prescribed rate...]
+	PetscInt    ErosionModel;               // [0-none, 1-infinitely fast, 2-prescribed rate, 3-surface processes...]
 	PetscInt    SedimentModel;              // [0-none, 1-prescribed rate, 2-gaussian margin...]
 	PetscInt    numLayers;                  // number of sediment layers
 	PetscInt    numErPhs;                   // number of erosion phases
@@ -58,6 +58,15 @@ struct FreeSurf
 	PetscScalar hDown;                      // down dip thickness of sediment cover
 	PetscScalar dTrans;                     // half of transition zone
 
+	// surface process model parameters (erosion model 3)
+	PetscScalar spKappa;                    // hillslope diffusivity
+	PetscScalar spKf;                       // stream-power erodibility
+	PetscScalar spM;                        // drainage area exponent
+	PetscScalar spN;                        // slope exponent
+	PetscInt    spSubSteps;                 // number of sub-steps per time step
+	Mat         spMat;                      // hillslope diffusion matrix
+	KSP         spKSP;                      // hillslope diffusion solver
+
 	// run-time parameters
 	PetscScalar avg_topo; // average topography (updated by all functions changing topography)
 	PetscInt    phase;    // current sediment phase
@@ -102,6 +111,31 @@ PetscErrorCode FreeSurfAppErosion(FreeSurf *surf);
 // apply sedimentation to the free surface
 PetscErrorCode FreeSurfAppSedimentation(FreeSurf *surf);
 
+//---------------------------------------------------------------------------
+// Surface process model (erosion model 3) evolves topography on DA_SURF by
+// implicit hillslope diffusion and stream-power incision E = Kf*A^m*S^n,
+// sub-cycled within a time step. Flow is routed along the steepest descent
+// (D8), drainage area is accumulated in order of decreasing height within the
+// local domains and iterated with ghost exchange until flow paths crossing
+// processor boundaries are fully resolved. Incision of a node is limited by
+// the height of its receiver. Model boundary nodes act as outlets.
+//---------------------------------------------------------------------------
+
+// apply surface processes to the free surface
+PetscErrorCode FreeSurfAppSurfProc(FreeSurf *surf);
+
+// assemble hillslope diffusion matrix
+PetscErrorCode FreeSurfSPSetMatrix(FreeSurf *surf, PetscScalar dt);
+
+// compute steepest descent receivers
+PetscErrorCode FreeSurfSPGetReceivers(FreeSurf *surf, Vec lrec);
+
+// accumulate drainage area along flow paths
+PetscErrorCode FreeSurfSPGetDrainArea(FreeSurf *surf, Vec lrec, Vec lacc, Vec gacc, PetscInt *perm, PetscScalar *hbuf);
+
+// apply stream-power incision
+PetscErrorCode FreeSurfSPIncise(FreeSurf *surf, Vec lrec, Vec lacc, PetscScalar dt);
+
 // Set topography from file
 PetscErrorCode FreeSurfSetTopoFromFile(FreeSurf *surf, FB *fb);
 
@@ -143,6 +177,10 @@ PetscScalar IntersectTriangularPrism(
 #define GET_VOLUME_PRISM(x1, x2, x3, y1, y2, y3, z1, z2, z3, level) \
 	((z1+z2+z3)/3.0 > level ? ((z1+z2+z3)/3.0-level)*PetscAbsScalar((x1-x3)*(y2-y3)-(x2-x3)*(y1-y3)) : 0)
 
+// get width of i-th NODE control volume of free surface grid (m - number of nodes)
+#define SIZE_SURF_NODE(i, s, m, ds) \
+	((ds.ncoor[PetscMin((i)+1, (m)-1)-(s)] - ds.ncoor[PetscMax((i)-1, 0)-(s)])/2.0)
+
 #define INTERSECT_EDGE(x1, y1, z1, x2, y2, z2, xp, yp, zp, level, dh) \
 	zp = level; \
 	w  = z1; if(z2 < w) w = z2; if(zp < w) zp = w; \
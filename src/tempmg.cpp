@@ -0,0 +1,585 @@
+/*@ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **
+ **   Project      : LaMEM
+ **   License      : MIT, see LICENSE file for details
+ **   Contributors : Anton Popov, Boris Kaus, see AUTHORS file for complete list
+ **   Organization : Institute of Geosciences, Johannes-Gutenberg University, Mainz
+ **   Contact      : kaus@uni-mainz.de, popov@uni-mainz.de
+ **
+ ** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ @*/
+//---------------------------------------------------------------------------
+//...........   MATRIX-FREE TEMPERATURE OPERATOR & MULTIGRID   .............
+//---------------------------------------------------------------------------
+#include "LaMEM.h"
+#include "tempmg.h"
+#include "fdstag.h"
+#include "JacRes.h"
+#include "bc.h"
+#include "tools.h"
+//---------------------------------------------------------------------------
+PetscErrorCode TMGCreate(TMG *mg, JacRes *jr)
+{
+	PetscInt  i, ln, N;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// clear object
+	ierr = PetscMemzero(mg, sizeof(TMG)); CHKERRQ(ierr);
+
+	mg->jr = jr;
+
+	// check mesh restrictions & get number of levels
+	ierr = TMGGetNumLevels(mg); CHKERRQ(ierr);
+
+	// allocate levels
+	ierr = PetscMalloc(sizeof(TMGLevel)*(size_t)mg->nlvl, &mg->lvls); CHKERRQ(ierr);
+	ierr = PetscMemzero(mg->lvls, sizeof(TMGLevel)*(size_t)mg->nlvl); CHKERRQ(ierr);
+
+	// finest level uses temperature grid
+	mg->lvls[0].DA = jr->DA_T;
+
+	for(i = 0; i < mg->nlvl; i++)
+	{
+		ierr = TMGLevelCreate(&mg->lvls[i], i ? &mg->lvls[i-1] : NULL, mg->fy); CHKERRQ(ierr);
+	}
+
+	// create matrix-free fine operator
+	ierr = VecGetLocalSize(mg->lvls[0].m, &ln); CHKERRQ(ierr);
+	ierr = VecGetSize     (mg->lvls[0].m, &N);  CHKERRQ(ierr);
+
+	ierr = MatCreateShell(PETSC_COMM_WORLD, ln, ln, N, N, (void*)mg, &mg->A);                    CHKERRQ(ierr);
+	ierr = MatShellSetOperation(mg->A, MATOP_MULT,         (void(*)(void))TMGMatMult);        CHKERRQ(ierr);
+	ierr = MatShellSetOperation(mg->A, MATOP_GET_DIAGONAL, (void(*)(void))TMGMatGetDiagonal); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGDestroy(TMG *mg)
+{
+	PetscInt  i;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	// NOTE: matrix-free operator is destroyed as temperature matrix
+
+	for(i = 0; i < mg->nlvl; i++)
+	{
+		ierr = TMGLevelDestroy(&mg->lvls[i], i ? PETSC_FALSE : PETSC_TRUE); CHKERRQ(ierr);
+	}
+
+	ierr = PetscFree(mg->lvls); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGSetPC(TMG *mg, KSP ksp)
+{
+	PC       pc, spc;
+	KSP      sksp;
+	PetscInt i, l;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = KSPGetPC(ksp, &pc);                           CHKERRQ(ierr);
+	ierr = PCSetType(pc, PCMG);                          CHKERRQ(ierr);
+	ierr = PCMGSetLevels(pc, mg->nlvl, NULL);            CHKERRQ(ierr);
+	ierr = PCMGSetType(pc, PC_MG_MULTIPLICATIVE);        CHKERRQ(ierr);
+	ierr = PCMGSetGalerkin(pc, PC_MG_GALERKIN_NONE);     CHKERRQ(ierr);
+
+	// attach grid transfer & rediscretized coarse operators
+	for(i = 1, l = mg->nlvl-1; i < mg->nlvl; i++, l--)
+	{
+		ierr = PCMGSetRestriction  (pc, l, mg->lvls[i].R); CHKERRQ(ierr);
+		ierr = PCMGSetInterpolation(pc, l, mg->lvls[i].P); CHKERRQ(ierr);
+
+		ierr = PCMGGetSmoother(pc, l-1, &sksp);                    CHKERRQ(ierr);
+		ierr = KSPSetOperators(sksp, mg->lvls[i].A, mg->lvls[i].A); CHKERRQ(ierr);
+	}
+
+	// set point Jacobi smoothing (only diagonal of fine operator is available)
+	for(l = 1; l < mg->nlvl; l++)
+	{
+		ierr = PCMGGetSmoother(pc, l, &sksp); CHKERRQ(ierr);
+		ierr = KSPGetPC(sksp, &spc);          CHKERRQ(ierr);
+		ierr = PCSetType(spc, PCJACOBI);      CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGSetup(TMG *mg)
+{
+	FDSTAG   *fs;
+	TMGLevel *lvl;
+	PetscInt  i, f, fy;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = mg->jr->fs;
+
+	for(i = 0, f = 1, fy = 1; i < mg->nlvl; i++, f *= 2, fy *= mg->fy)
+	{
+		lvl = &mg->lvls[i];
+
+		// get cell sizes (grid can be stretched)
+		ierr = TMGGetSteps(&fs->dsx, f,  lvl->hx, 300); CHKERRQ(ierr);
+		ierr = TMGGetSteps(&fs->dsy, fy, lvl->hy, 301); CHKERRQ(ierr);
+		ierr = TMGGetSteps(&fs->dsz, f,  lvl->hz, 302); CHKERRQ(ierr);
+
+		if(i)
+		{
+			// restrict coefficients from fine level
+			ierr = TMGLevelRestrict(lvl, &mg->lvls[i-1], mg->fy); CHKERRQ(ierr);
+		}
+
+		// exchange ghost point conductivity
+		GLOBAL_TO_LOCAL(lvl->DA, lvl->gk, lvl->lk)
+
+		if(i)
+		{
+			// rediscretize coarse operator
+			ierr = TMGLevelAssemble(lvl); CHKERRQ(ierr);
+		}
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGGetNumLevels(TMG *mg)
+{
+	// check multigrid mesh restrictions, get actual number of coarsening steps
+
+	FDSTAG   *fs;
+	PetscBool opt_set;
+	PetscInt  nx, ny, nz, ncors, nlevels, refine_y;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	fs = mg->jr->fs;
+
+	// do not coarsen in y-direction in 2D (same option as Stokes multigrid)
+	refine_y = 2;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-da_refine_y", &refine_y, NULL); CHKERRQ(ierr);
+
+	mg->fy = (refine_y > 1) ? 2 : 1;
+
+	// check discretization in all directions
+	ierr = Discret1DCheckMG(&fs->dsx, "x", &nx); CHKERRQ(ierr);                ncors = nx;
+
+	if(mg->fy > 1)
+	{
+		ierr = Discret1DCheckMG(&fs->dsy, "y", &ny); CHKERRQ(ierr);
+		if(ny < ncors) ncors = ny;
+	}
+
+	ierr = Discret1DCheckMG(&fs->dsz, "z", &nz); CHKERRQ(ierr); if(nz < ncors) ncors = nz;
+
+	// use all possible levels by default
+	nlevels = ncors+1;
+
+	ierr = PetscOptionsGetInt(NULL, NULL, "-temp_mg_levels", &nlevels, &opt_set); CHKERRQ(ierr);
+
+	if(nlevels < 2 || nlevels > ncors+1)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Incorrect # of temperature multigrid levels specified. Requested: %lld. Max. possible: %lld", (LLD)nlevels, (LLD)(ncors+1));
+	}
+
+	ierr = PetscPrintf(PETSC_COMM_WORLD, "   Temperature multigrid levels  :  %lld\n", (LLD)nlevels); CHKERRQ(ierr);
+
+	mg->nlvl = nlevels;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGLevelCreate(TMGLevel *lvl, TMGLevel *fine, PetscInt fy)
+{
+	PetscInt         i, nx, ny, nz, sx, sy, sz;
+	PetscInt         Nx,   Ny,   Nz;
+	PetscInt         Px,   Py,   Pz;
+	const PetscInt  *plx, *ply, *plz;
+	PetscInt        *lx,  *ly,  *lz;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(fine)
+	{
+		// get number of cells & processors in the fine grid
+		ierr = DMDAGetInfo(fine->DA, 0, &Nx, &Ny, &Nz, &Px, &Py, &Pz, 0, 0, 0, 0, 0, 0); CHKERRQ(ierr);
+
+		// get number of cells per processor in fine grid
+		ierr = DMDAGetOwnershipRanges(fine->DA, &plx, &ply, &plz); CHKERRQ(ierr);
+
+		ierr = makeIntArray(&lx, plx, Px); CHKERRQ(ierr);
+		ierr = makeIntArray(&ly, ply, Py); CHKERRQ(ierr);
+		ierr = makeIntArray(&lz, plz, Pz); CHKERRQ(ierr);
+
+		// coarsen uniformly
+		Nx /= 2;  for(i = 0; i < Px; i++) lx[i] /= 2;
+		Ny /= fy; for(i = 0; i < Py; i++) ly[i] /= fy;
+		Nz /= 2;  for(i = 0; i < Pz; i++) lz[i] /= 2;
+
+		ierr = DMDACreate3dSetUp(PETSC_COMM_WORLD,
+			DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+			DMDA_STENCIL_STAR,
+			Nx, Ny, Nz, Px, Py, Pz, 1, 1, lx, ly, lz, &lvl->DA); CHKERRQ(ierr);
+
+		ierr = PetscFree(lx); CHKERRQ(ierr);
+		ierr = PetscFree(ly); CHKERRQ(ierr);
+		ierr = PetscFree(lz); CHKERRQ(ierr);
+
+		// piecewise-constant prolongation
+		ierr = DMDASetInterpolationType(lvl->DA, DMDA_Q0);                  CHKERRQ(ierr);
+		ierr = DMCreateInterpolation(lvl->DA, fine->DA, &lvl->P, NULL);     CHKERRQ(ierr);
+
+		// restriction by averaging (rediscretized operators are volume-specific)
+		ierr = MatTranspose(lvl->P, MAT_INITIAL_MATRIX, &lvl->R);           CHKERRQ(ierr);
+		ierr = MatScale(lvl->R, 1.0/(PetscScalar)(4*fy));                   CHKERRQ(ierr);
+
+		// coarse operator
+		ierr = DMCreateMatrix(lvl->DA, &lvl->A);                            CHKERRQ(ierr);
+		ierr = MatSetOption(lvl->A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE); CHKERRQ(ierr);
+	}
+
+	// coefficient vectors
+	ierr = DMCreateGlobalVector(lvl->DA, &lvl->gk);  CHKERRQ(ierr);
+	ierr = DMCreateLocalVector (lvl->DA, &lvl->lk);  CHKERRQ(ierr);
+	ierr = DMCreateGlobalVector(lvl->DA, &lvl->m);   CHKERRQ(ierr);
+	ierr = DMCreateGlobalVector(lvl->DA, &lvl->msk); CHKERRQ(ierr);
+
+	// cell sizes
+	ierr = DMDAGetCorners(lvl->DA, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	ierr = makeScalArray(&lvl->hbuf, NULL, nx+ny+nz+6); CHKERRQ(ierr);
+
+	lvl->hx = lvl->hbuf + 1;
+	lvl->hy = lvl->hx   + nx + 2;
+	lvl->hz = lvl->hy   + ny + 2;
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGLevelDestroy(TMGLevel *lvl, PetscBool fine)
+{
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	if(!fine)
+	{
+		ierr = DMDestroy (&lvl->DA); CHKERRQ(ierr);
+		ierr = MatDestroy(&lvl->A);  CHKERRQ(ierr);
+		ierr = MatDestroy(&lvl->R);  CHKERRQ(ierr);
+		ierr = MatDestroy(&lvl->P);  CHKERRQ(ierr);
+	}
+
+	ierr = VecDestroy(&lvl->gk);  CHKERRQ(ierr);
+	ierr = VecDestroy(&lvl->lk);  CHKERRQ(ierr);
+	ierr = VecDestroy(&lvl->m);   CHKERRQ(ierr);
+	ierr = VecDestroy(&lvl->msk); CHKERRQ(ierr);
+	ierr = PetscFree(lvl->hbuf);  CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGGetSteps(Discret1D *ds, PetscInt f, PetscScalar *h, PetscMPIInt tag)
+{
+	// compute cell sizes of a grid coarsened by factor f,
+	// ghost cells are mirrored on the boundaries
+
+	PetscInt    i, nc;
+	PetscScalar a[2], aprev[2], anext[2];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	nc = ds->ncels/f;
+
+	for(i = 0; i < nc; i++) h[i] = ds->ncoor[(i+1)*f] - ds->ncoor[i*f];
+
+	// get ghost cell sizes from neighbors
+	a[0] = h[0];
+	a[1] = h[nc-1];
+
+	ierr = Discret1DExchangeNeighbors(ds, a, aprev, anext, 2, tag); CHKERRQ(ierr);
+
+	if(ds->pstart == 0)                     h[-1] = h[0];    else h[-1] = aprev[1];
+	if(ds->pstart + ds->ncels == ds->tcels) h[nc] = h[nc-1]; else h[nc] = anext[0];
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGLevelRestrict(TMGLevel *lvl, TMGLevel *fine, PetscInt fy)
+{
+	// restrict inverse conductivity, heat capacity term & boundary flags
+
+	PetscInt    I, J, K, flg;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz;
+	PetscScalar n, sk, sm;
+	PetscScalar ***ck, ***cm, ***cmsk, ***fk, ***fm, ***fmsk;
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	n = (PetscScalar)(4*fy);
+
+	ierr = DMDAVecGetArray(lvl->DA,  lvl->gk,   &ck);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA,  lvl->m,    &cm);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA,  lvl->msk,  &cmsk); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fine->DA, fine->gk,  &fk);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fine->DA, fine->m,   &fm);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(fine->DA, fine->msk, &fmsk); CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(lvl->DA, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	START_STD_LOOP
+	{
+		sk  = 0.0;
+		sm  = 0.0;
+		flg = 0;
+
+		for(K = 2*k; K < 2*k+2; K++)
+		for(J = fy*j; J < fy*j+fy; J++)
+		for(I = 2*i; I < 2*i+2; I++)
+		{
+			sk  += 1.0/fk[K][J][I];
+			sm  += fm[K][J][I];
+			flg |= (PetscInt)fmsk[K][J][I];
+		}
+
+		ck  [k][j][i] = n/sk;
+		cm  [k][j][i] = sm/n;
+		cmsk[k][j][i] = (PetscScalar)flg;
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(lvl->DA,  lvl->gk,   &ck);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA,  lvl->m,    &cm);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA,  lvl->msk,  &cmsk); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fine->DA, fine->gk,  &fk);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fine->DA, fine->m,   &fm);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(fine->DA, fine->msk, &fmsk); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGLevelAssemble(TMGLevel *lvl)
+{
+	PetscInt    n, mx, my, mz;
+	PetscInt    i, j, k, nx, ny, nz, sx, sy, sz;
+	PetscScalar v[7], ***lk, ***m, ***msk;
+	MatStencil  row[1], col[7];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = DMDAGetInfo(lvl->DA, 0, &mx, &my, &mz, 0, 0, 0, 0, 0, 0, 0, 0, 0); CHKERRQ(ierr);
+
+	ierr = MatZeroEntries(lvl->A); CHKERRQ(ierr);
+
+	ierr = DMDAVecGetArray(lvl->DA, lvl->lk,  &lk);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lvl->m,   &m);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lvl->msk, &msk); CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(lvl->DA, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	START_STD_LOOP
+	{
+		n = TMGLevelGetStencil(lvl, lk, m, msk, i, j, k, sx, sy, sz, mx-1, my-1, mz-1, col, v);
+
+		row[0] = col[0];
+
+		ierr = MatSetValuesStencil(lvl->A, 1, row, n, col, v, INSERT_VALUES); CHKERRQ(ierr);
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->lk,  &lk);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->m,   &m);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->msk, &msk); CHKERRQ(ierr);
+
+	ierr = MatAssemblyBegin(lvl->A, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+	ierr = MatAssemblyEnd  (lvl->A, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+// add face contribution to the stencil (average conductivity, node step, cell step)
+// Dirichlet boundary faces (two-point constraints) double the diagonal term,
+// Neumann boundary faces give no contribution
+#define ADD_FACE(cond, K, J, I, bit, hn, hc) \
+	if(cond) \
+	{	a = (kc + lk[K][J][I])/2.0/((hn + hc)/2.0)/hc; \
+		col[n].k = K; col[n].j = J; col[n].i = I; col[n].c = 0; \
+		v[n++] = -a; d += a; } \
+	else if(flg & bit) \
+	{	d += 2.0*kc/((hn + hc)/2.0)/hc; }
+
+PetscInt TMGLevelGetStencil(
+	TMGLevel     *lvl,
+	PetscScalar ***lk,
+	PetscScalar ***m,
+	PetscScalar ***msk,
+	PetscInt      i,
+	PetscInt      j,
+	PetscInt      k,
+	PetscInt      sx,
+	PetscInt      sy,
+	PetscInt      sz,
+	PetscInt      mx,
+	PetscInt      my,
+	PetscInt      mz,
+	MatStencil   *col,
+	PetscScalar  *v)
+{
+	PetscInt    n, flg;
+	PetscScalar kc, d, a, *hx, *hy, *hz;
+
+	hx  = lvl->hx - sx;
+	hy  = lvl->hy - sy;
+	hz  = lvl->hz - sz;
+	kc  = lk[k][j][i];
+	flg = (PetscInt)msk[k][j][i];
+	d   = m[k][j][i];
+	n   = 1;
+
+	ADD_FACE(i > 0,  k, j, i-1, _TMG_XM_, hx[i-1], hx[i])
+	ADD_FACE(i < mx, k, j, i+1, _TMG_XP_, hx[i+1], hx[i])
+	ADD_FACE(j > 0,  k, j-1, i, _TMG_YM_, hy[j-1], hy[j])
+	ADD_FACE(j < my, k, j+1, i, _TMG_YP_, hy[j+1], hy[j])
+	ADD_FACE(k > 0,  k-1, j, i, _TMG_ZM_, hz[k-1], hz[k])
+	ADD_FACE(k < mz, k+1, j, i, _TMG_ZP_, hz[k+1], hz[k])
+
+	// diagonal
+	col[0].k = k; col[0].j = j; col[0].i = i; col[0].c = 0;
+	v[0]     = d;
+
+	return n;
+}
+#undef ADD_FACE
+//---------------------------------------------------------------------------
+PetscErrorCode TMGMatMult(Mat A, Vec x, Vec y)
+{
+	TMG         *mg;
+	TMGLevel    *lvl;
+	Vec          lx;
+	PetscInt     l, n, mx, my, mz, num, *list;
+	PetscInt     i, j, k, nx, ny, nz, sx, sy, sz;
+	PetscScalar  v[7], s, ***lk, ***m, ***msk, ***X, ***Y, *px, *py;
+	MatStencil   col[7];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = MatShellGetContext(A, (void*)&mg); CHKERRQ(ierr);
+
+	lvl = &mg->lvls[0];
+
+	ierr = DMDAGetInfo(lvl->DA, 0, &mx, &my, &mz, 0, 0, 0, 0, 0, 0, 0, 0, 0); CHKERRQ(ierr);
+
+	// get ghost values of argument
+	ierr = DMGetLocalVector(lvl->DA, &lx); CHKERRQ(ierr);
+
+	GLOBAL_TO_LOCAL(lvl->DA, x, lx)
+
+	ierr = DMDAVecGetArray(lvl->DA, lvl->lk,  &lk);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lvl->m,   &m);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lvl->msk, &msk); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lx,       &X);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, y,        &Y);   CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(lvl->DA, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	START_STD_LOOP
+	{
+		n = TMGLevelGetStencil(lvl, lk, m, msk, i, j, k, sx, sy, sz, mx-1, my-1, mz-1, col, v);
+
+		for(l = 0, s = 0.0; l < n; l++) s += v[l]*X[col[l].k][col[l].j][col[l].i];
+
+		Y[k][j][i] = s;
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->lk,  &lk);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->m,   &m);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->msk, &msk); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lx,       &X);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, y,        &Y);   CHKERRQ(ierr);
+
+	ierr = DMRestoreLocalVector(lvl->DA, &lx); CHKERRQ(ierr);
+
+	// impose primary temperature constraints (unit diagonal)
+	num  = mg->jr->bc->tNumSPC;
+	list = mg->jr->bc->tSPCList;
+
+	if(num)
+	{
+		ierr = VecGetArray(x, &px); CHKERRQ(ierr);
+		ierr = VecGetArray(y, &py); CHKERRQ(ierr);
+
+		for(i = 0; i < num; i++) py[list[i]] = px[list[i]];
+
+		ierr = VecRestoreArray(x, &px); CHKERRQ(ierr);
+		ierr = VecRestoreArray(y, &py); CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
+PetscErrorCode TMGMatGetDiagonal(Mat A, Vec d)
+{
+	TMG         *mg;
+	TMGLevel    *lvl;
+	PetscInt     mx, my, mz, num, *list;
+	PetscInt     i, j, k, nx, ny, nz, sx, sy, sz;
+	PetscScalar  v[7], ***lk, ***m, ***msk, ***D, *pd;
+	MatStencil   col[7];
+
+	PetscErrorCode ierr;
+	PetscFunctionBeginUser;
+
+	ierr = MatShellGetContext(A, (void*)&mg); CHKERRQ(ierr);
+
+	lvl = &mg->lvls[0];
+
+	ierr = DMDAGetInfo(lvl->DA, 0, &mx, &my, &mz, 0, 0, 0, 0, 0, 0, 0, 0, 0); CHKERRQ(ierr);
+
+	ierr = DMDAVecGetArray(lvl->DA, lvl->lk,  &lk);  CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lvl->m,   &m);   CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, lvl->msk, &msk); CHKERRQ(ierr);
+	ierr = DMDAVecGetArray(lvl->DA, d,        &D);   CHKERRQ(ierr);
+
+	ierr = DMDAGetCorners(lvl->DA, &sx, &sy, &sz, &nx, &ny, &nz); CHKERRQ(ierr);
+
+	START_STD_LOOP
+	{
+		TMGLevelGetStencil(lvl, lk, m, msk, i, j, k, sx, sy, sz, mx-1, my-1, mz-1, col, v);
+
+		D[k][j][i] = v[0];
+	}
+	END_STD_LOOP
+
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->lk,  &lk);  CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->m,   &m);   CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, lvl->msk, &msk); CHKERRQ(ierr);
+	ierr = DMDAVecRestoreArray(lvl->DA, d,        &D);   CHKERRQ(ierr);
+
+	// unit diagonal of primary temperature constraints
+	num  = mg->jr->bc->tNumSPC;
+	list = mg->jr->bc->tSPCList;
+
+	if(num)
+	{
+		ierr = VecGetArray(d, &pd); CHKERRQ(ierr);
+
+		for(i = 0; i < num; i++) pd[list[i]] = 1.0;
+
+		ierr = VecRestoreArray(d, &pd); CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+/*@ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **
+ **   Project      : LaMEM
+ **   License      : MIT, see LICENSE file for details
+ **   Contributors : Anton Popov, Boris Kaus, see AUTHORS file for complete list
+ **   Organization : Institute of Geosciences, Johannes-Gutenberg University, Mainz
+ **   Contact      : kaus@uni-mainz.de, popov@uni-mainz.de
+ **
+ ** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ @*/
+//---------------------------------------------------------------------------
+//...........   MATRIX-FREE TEMPERATURE OPERATOR & MULTIGRID   .............
+//---------------------------------------------------------------------------
+#ifndef __tempmg_h__
+#define __tempmg_h__
+//---------------------------------------------------------------------------
+
+struct Discret1D;
+struct JacRes;
+
+//---------------------------------------------------------------------------
+// Temperature operator is stored as cell conductivity, heat capacity term
+// (rho*Cp/dt) and Dirichlet boundary flags, and is applied matrix-free on
+// the finest grid (DA_T). Coarse grids are obtained by uniform coarsening of
+// DA_T, coarse operators are rediscretized with restricted (harmonic average)
+// conductivity, which keeps the hierarchy consistent for strongly varying
+// coefficients. Grid transfer is piecewise-constant (cell-centered).
+// Activated by -temp_mf, number of levels is set by -temp_mg_levels.
+//---------------------------------------------------------------------------
+
+// Dirichlet boundary face flags
+#define _TMG_XM_ 1
+#define _TMG_XP_ 2
+#define _TMG_YM_ 4
+#define _TMG_YP_ 8
+#define _TMG_ZM_ 16
+#define _TMG_ZP_ 32
+
+//---------------------------------------------------------------------------
+
+struct TMGLevel
+{
+	DM           DA;          // cell-centered grid (star stencil)
+	Vec          gk, lk;      // conductivity (global & local)
+	Vec          m;           // heat capacity term (rho*Cp/dt)
+	Vec          msk;         // Dirichlet boundary face flags
+	PetscScalar *hbuf;        // cell size buffer
+	PetscScalar *hx, *hy, *hz;// cell sizes (+ 1 layer of ghost cells)
+	Mat          A;           // rediscretized operator (not set on finest grid)
+	Mat          R, P;        // restriction & prolongation (not set on finest grid)
+
+	// ******** fine level ************
+	//     |                   ^
+	//     R-matrix            |
+	//     |                   P-matrix
+	//     v                   |
+	// ******** this level ************
+};
+
+//---------------------------------------------------------------------------
+
+struct TMG
+{
+	JacRes    *jr;   // finest grid context
+	PetscInt   nlvl; // number of levels
+	PetscInt   fy;   // coarsening factor in y-direction
+	TMGLevel  *lvls; // levels (finest first)
+	Mat        A;    // matrix-free fine operator (stored as temperature matrix)
+};
+
+//---------------------------------------------------------------------------
+
+// create levels & matrix-free operator (set as temperature matrix)
+PetscErrorCode TMGCreate(TMG *mg, JacRes *jr);
+
+PetscErrorCode TMGDestroy(TMG *mg);
+
+// set multigrid preconditioner of temperature solver (before KSPSetFromOptions)
+PetscErrorCode TMGSetPC(TMG *mg, KSP ksp);
+
+// restrict coefficients & rediscretize coarse operators
+// (finest grid coefficients must be set in advance)
+PetscErrorCode TMGSetup(TMG *mg);
+
+PetscErrorCode TMGGetNumLevels(TMG *mg);
+
+PetscErrorCode TMGLevelCreate(TMGLevel *lvl, TMGLevel *fine, PetscInt fy);
+
+PetscErrorCode TMGLevelDestroy(TMGLevel *lvl, PetscBool fine);
+
+// compute coarse cell sizes (f - coarsening factor)
+PetscErrorCode TMGGetSteps(Discret1D *ds, PetscInt f, PetscScalar *h, PetscMPIInt tag);
+
+PetscErrorCode TMGLevelRestrict(TMGLevel *lvl, TMGLevel *fine, PetscInt fy);
+
+PetscErrorCode TMGLevelAssemble(TMGLevel *lvl);
+
+// get operator stencil in a cell (diagonal is returned first)
+PetscInt TMGLevelGetStencil(
+	TMGLevel     *lvl,
+	PetscScalar ***lk,
+	PetscScalar ***m,
+	PetscScalar ***msk,
+	PetscInt      i,
+	PetscInt      j,
+	PetscInt      k,
+	PetscInt      sx,
+	PetscInt      sy,
+	PetscInt      sz,
+	PetscInt      mx,
+	PetscInt      my,
+	PetscInt      mz,
+	MatStencil   *col,
+	PetscScalar  *v);
+
+// matrix-free operator
+PetscErrorCode TMGMatMult(Mat A, Vec x, Vec y);
+
+PetscErrorCode TMGMatGetDiagonal(Mat A, Vec d);
+
+//---------------------------------------------------------------------------
+#endif
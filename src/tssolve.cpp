@@ -35,6 +35,9 @@ PetscErrorCode TSSolCreate(TSSol *ts, FB *fb)
 	ts->nstep_out = 1;
 	ts->nstep_ini = 1;
 	ts->tol       = 1e-8;
+	ts->fac_max   = 2.0;
+	ts->fac_rej   = 0.5;
+	ts->fac       = 1.0;
 
 	// read parameters
 	ierr = getScalarParam(fb, _OPTIONAL_, "time_end",        &ts->time_end,   1,               time);          CHKERRQ(ierr);
@@ -53,6 +56,12 @@ PetscErrorCode TSSolCreate(TSSol *ts, FB *fb)
 	ierr = getIntParam   (fb, _OPTIONAL_, "nstep_ini",       &ts->nstep_ini,  1,               -1  );          CHKERRQ(ierr);
 	ierr = getIntParam   (fb, _OPTIONAL_, "nstep_rdb",       &ts->nstep_rdb,  1,               -1  );          CHKERRQ(ierr);
 	ierr = getScalarParam(fb, _OPTIONAL_, "time_tol",        &ts->tol,        1,               1.0 );          CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "dt_adapt",        &ts->adapt,      1,               1   );          CHKERRQ(ierr);
+	ierr = getScalarParam(fb, _OPTIONAL_, "dt_tol_T",        &ts->tol_T,      1,               scal->temperature); CHKERRQ(ierr);
+	ierr = getScalarParam(fb, _OPTIONAL_, "dt_tol_S",        &ts->tol_S,      1,               1.0 );          CHKERRQ(ierr);
+	ierr = getIntParam   (fb, _OPTIONAL_, "dt_nl_its",       &ts->nit_opt,    1,               -1  );          CHKERRQ(ierr);
+	ierr = getScalarParam(fb, _OPTIONAL_, "dt_fac_max",      &ts->fac_max,    1,               1.0 );          CHKERRQ(ierr);
+	ierr = getScalarParam(fb, _OPTIONAL_, "dt_fac_rej",      &ts->fac_rej,    1,               1.0 );          CHKERRQ(ierr);
 
 	if(ts->CFL < 0.0 && ts->CFL > 1.0)
 	{
@@ -69,6 +78,21 @@ PetscErrorCode TSSolCreate(TSSol *ts, FB *fb)
 		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "CFL parameter should be smaller than CFLMAX");
 	}
 
+	if(ts->adapt && ts->num_dtper)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Error-controlled time stepping (dt_adapt) cannot be combined with time stepping periods (num_dt_periods)");
+	}
+
+	if(ts->adapt && !ts->tol_T && !ts->tol_S && !ts->nit_opt)
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Error-controlled time stepping (dt_adapt) requires at least one criterion (dt_tol_T, dt_tol_S, dt_nl_its)");
+	}
+
+	if(ts->adapt && (ts->fac_max < 1.0 || ts->fac_rej <= 0.0 || ts->fac_rej >= 1.0))
+	{
+		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "dt_fac_max should be larger than 1, dt_fac_rej should be between 0 and 1");
+	}
+
 	if(!ts->time_end && !ts->nstep_max)
 	{
 		SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Define at least one of the parameters: time_end, nstep_max");
@@ -106,6 +130,15 @@ PetscErrorCode TSSolCreate(TSSol *ts, FB *fb)
 	PetscPrintf(PETSC_COMM_WORLD, "   CFL criterion                : %g \n",    ts->CFL);
     PetscPrintf(PETSC_COMM_WORLD, "   CFLMAX (fixed time steps)    : %g \n",    ts->CFLMAX);
 
+	if(ts->adapt)
+	{
+		PetscPrintf(PETSC_COMM_WORLD, "   Error-controlled time step   @ \n");
+		PetscPrintf(PETSC_COMM_WORLD, "   Maximum growth factor        : %g \n",    ts->fac_max);
+		if(ts->tol_T)   PetscPrintf(PETSC_COMM_WORLD, "   Temperature increment tol.   : %g %s \n", ts->tol_T*scal->temperature, scal->lbl_temperature);
+		if(ts->tol_S)   PetscPrintf(PETSC_COMM_WORLD, "   Relative stress increment tol: %g \n",    ts->tol_S);
+		if(ts->nit_opt) PetscPrintf(PETSC_COMM_WORLD, "   Target nonlinear iterations  : %lld \n", (LLD)ts->nit_opt);
+	}
+
 	if(ts->dt_out)    PetscPrintf(PETSC_COMM_WORLD, "   Output time step             : %g %s \n", ts->dt_out  *time, scal->lbl_time);
 	if(ts->nstep_out) PetscPrintf(PETSC_COMM_WORLD, "   Output every [n] steps       : %lld \n", (LLD)ts->nstep_out);
 	if(ts->nstep_ini) PetscPrintf(PETSC_COMM_WORLD, "   Output [n] initial steps     : %lld \n", (LLD)ts->nstep_ini);
@@ -243,8 +276,8 @@ PetscErrorCode TSSolGetCFLStep(
 	// set restart flag
 	(*restart) = 0;
 
-	// get CFL time step
-	GET_CFL_STEP(dt_cfl, ts->dt_max, ts->CFL, gidtmax)
+	// get CFL time step (error-controlled time step is only limited by CFLMAX)
+	GET_CFL_STEP(dt_cfl, ts->dt_max, ts->adapt ? ts->CFLMAX : ts->CFL, gidtmax)
 
 	// declare divergence if too small time step is required
 	if(dt_cfl < ts->dt_min)
@@ -295,6 +328,15 @@ PetscErrorCode TSSolGetCFLStep(
 			ierr = TSSolAdjustSchedule(ts, dt_cfl, istep, schedule); CHKERRQ(ierr);
 		} 
 	}
+	else if(ts->adapt)
+	{
+		// apply factor estimated from local error indicators
+		ts->dt_next = ts->dt*ts->fac;
+
+		// check CFL & minimum time step limits
+		if(ts->dt_next > dt_cfl)     ts->dt_next = dt_cfl;
+		if(ts->dt_next < ts->dt_min) ts->dt_next = ts->dt_min;
+	}
 	else
 	{
 		ts->dt_next = ts->dt*(1.0 + ts->inc_dt);
@@ -467,3 +509,77 @@ PetscErrorCode TSSolAdjustSchedule(TSSol *ts, PetscScalar dt_cfl, PetscInt istep
 	PetscFunctionReturn(0);
 }
 //---------------------------------------------------------------------------
+PetscErrorCode TSSolCheckStep(
+	TSSol       *ts,
+	PetscInt     conv,    // nonlinear solver convergence flag
+	PetscInt     nit,     // number of nonlinear iterations
+	PetscScalar  eT,      // maximum temperature increment
+	PetscScalar  eS,      // maximum relative stress increment
+	PetscInt    *reject)  // time step rejection flag
+{
+	// Error indicators are normalized by tolerances, such that err > 1 means
+	// that the step is too large. The indicators are increments over the step,
+	// i.e. they are proportional to dt, which gives the change factor 0.9/err.
+	// Growth is additionally limited by the nonlinear iteration count.
+	// Steps with divergent nonlinear solver or err > 1 are rejected,
+	// unless time step is already at minimum.
+
+	Scaling     *scal;
+	PetscScalar  err, fac;
+
+	PetscFunctionBeginUser;
+
+	(*reject) = 0;
+
+	if(!ts->adapt) PetscFunctionReturn(0);
+
+	scal = ts->scal;
+
+	// get normalized error
+	err = 0.0;
+
+	if(ts->tol_T) err = PetscMax(err, eT/ts->tol_T);
+	if(ts->tol_S) err = PetscMax(err, eS/ts->tol_S);
+
+	// get time step change factor
+	if(err) fac = 0.9/err;
+	else    fac = ts->fac_max;
+
+	if(ts->nit_opt && nit) fac = PetscMin(fac, (PetscScalar)ts->nit_opt/(PetscScalar)nit);
+
+	if(!conv) fac = ts->fac_rej;
+
+	if(fac > ts->fac_max) fac = ts->fac_max;
+	if(fac < ts->fac_rej) fac = ts->fac_rej;
+
+	ts->fac = fac;
+
+	PetscPrintf(PETSC_COMM_WORLD, "Time step error estimate : %g (change factor %g)\n", err, fac);
+
+	if(!conv || err > 1.0)
+	{
+		if(ts->dt > ts->dt_min*(1.0 + ts->tol))
+		{
+			// reduce current time step & repeat
+			ts->dt = PetscMax(ts->dt*fac, ts->dt_min);
+
+			ts->nrej++;
+
+			(*reject) = 1;
+
+			PetscPrintf(PETSC_COMM_WORLD, "Time step rejected, new time step : %7.5f %s (rejected steps: %lld)\n", ts->dt*scal->time, scal->lbl_time, (LLD)ts->nrej);
+			PetscPrintf(PETSC_COMM_WORLD, "--------------------------------------------------------------------------\n");
+			PetscPrintf(PETSC_COMM_WORLD, "***********************   RESTARTING TIME STEP!   ************************\n");
+			PetscPrintf(PETSC_COMM_WORLD, "--------------------------------------------------------------------------\n");
+		}
+		else
+		{
+			PetscPrintf(PETSC_COMM_WORLD, "Time step accepted at dt_min despite error estimate or divergence\n");
+		}
+	}
+
+	PetscPrintf(PETSC_COMM_WORLD, "--------------------------------------------------------------------------\n");
+
+	PetscFunctionReturn(0);
+}
+//---------------------------------------------------------------------------
@@ -45,6 +45,14 @@ struct TSSol
 	PetscInt    nstep_rdb;                 // save restart database every n steps
 	PetscInt    fix_dt;                    // flag to keep time steps fixed for advection (elasticity, kinematic block BC)
 	PetscInt    istep;                     // time step counter
+	PetscInt    adapt;                     // error-controlled time step flag
+	PetscScalar tol_T;                     // tolerance of maximum temperature increment per step
+	PetscScalar tol_S;                     // tolerance of maximum relative stress increment per step
+	PetscInt    nit_opt;                   // target number of nonlinear iterations
+	PetscScalar fac_max;                   // maximum time step growth factor
+	PetscScalar fac_rej;                   // time step reduction factor after nonlinear divergence
+	PetscScalar fac;                       // time step change factor estimated in the current step
+	PetscInt    nrej;                      // number of rejected time steps
 };
 
 //---------------------------------------------------------------------------
@@ -75,6 +83,15 @@ PetscErrorCode TSSolMakeSchedule(TSSol *ts);
 
 PetscErrorCode TSSolAdjustSchedule(TSSol *ts, PetscScalar dt_cfl, PetscInt istep, PetscScalar *schedule);
 
+// estimate time step change factor from local error indicators, reject time step if necessary
+PetscErrorCode TSSolCheckStep(
+	TSSol       *ts,
+	PetscInt     conv,     // nonlinear solver convergence flag
+	PetscInt     nit,      // number of nonlinear iterations
+	PetscScalar  eT,       // maximum temperature increment
+	PetscScalar  eS,       // maximum relative stress increment
+	PetscInt    *reject);  // time step rejection flag
+
 //---------------------------------------------------------------------------
 
 // compute CFL time step with limit
@@ -994,6 +994,108 @@ end
                             keywords=keywords, accuracy=acc, cores=1, opt=true, mpiexec=mpiexec)
 end
 
+@testset "t33_TempMG" begin
+    cd(test_dir)
+    dir = "t33_TempMG";
+    ParamFile = "TempMG.dat";
+
+    # compare matrix-free multigrid & assembled temperature solvers (time step grows every step)
+    cd(dir)
+    @test run_lamem_local_test(ParamFile, 1, "-out_file_name TempMG_aij", outfile="TempMG_aij.out", mpiexec=mpiexec)
+    @test run_lamem_local_test(ParamFile, 2, "-out_file_name TempMG_mg -temp_mf -temp_mg_levels 3 -ts_ksp_type cg", outfile="TempMG_mg.out", mpiexec=mpiexec)
+    cd(test_dir)
+
+    for step in (1, 3, 6)
+        data_aij, t_aij = Read_LaMEM_timestep("TempMG_aij", step, dir)
+        data_mg,  t_mg  = Read_LaMEM_timestep("TempMG_mg",  step, dir)
+        @test t_aij ≈ t_mg
+        @test maximum(abs.(data_aij.fields.temperature - data_mg.fields.temperature)) < 1e-6
+    end
+
+    clean_test_directory(dir)
+end
+
+@testset "t34_SurfProc" begin
+    cd(test_dir)
+    dir = "t34_SurfProc";
+    include(joinpath(dir,"t34_CreateTopo.jl"));
+    ParamFile = "SurfProc.dat";
+
+    # stream-power incision on a tilted plane (drainage area grows downslope)
+    t34_CreateTopo(dir, "TiltedPlane.dat")
+    cd(dir)
+    @test run_lamem_local_test(ParamFile, 2, "", outfile="SurfProc.out", mpiexec=mpiexec)
+    cd(test_dir)
+
+    data0, t0 = Read_LaMEM_timestep("SurfProc", 0, dir, surf=true)
+    data5, t5 = Read_LaMEM_timestep("SurfProc", 5, dir, surf=true)
+    dz = data0.fields.topography[:,3:7,1] - data5.fields.topography[:,3:7,1]
+
+    # upslope (x = -25 km) & downslope (x = 25 km) incision, averaged across slope
+    # (drainage area ratio is 3, i.e. incision ratio is sqrt(3) for sp_m = 0.5)
+    dz_up   = sum(dz[9, :])/size(dz,2)
+    dz_down = sum(dz[25,:])/size(dz,2)
+
+    @test dz_up   > 0.0
+    @test dz_down > 1.5*dz_up
+
+    rm(joinpath(dir,"TiltedPlane.dat"))
+    clean_test_directory(dir)
+end
+
+@testset "t35_CompactRestart" begin
+    cd(test_dir)
+    dir = "t35_CompactRestart";
+    ParamFile = "CompactRestart.dat";
+
+    # uninterrupted run (saves compact restart database after step 4)
+    cd(dir)
+    @test run_lamem_local_test(ParamFile, 2, "", outfile="CompactRestart_ref.out", mpiexec=mpiexec)
+    cd(test_dir)
+
+    data_ref, t_ref = Read_LaMEM_timestep("CompactRestart", 6, dir)
+    τII_ref = data_ref.fields.j2_dev_stress
+
+    # restart from compact records (overwrites output of steps 5 & 6)
+    cd(dir)
+    @test run_lamem_local_test(ParamFile, 2, "-mode restart", outfile="CompactRestart_rst.out", mpiexec=mpiexec)
+    cd(test_dir)
+
+    data_rst, t_rst = Read_LaMEM_timestep("CompactRestart", 6, dir)
+    τII_rst = data_rst.fields.j2_dev_stress
+
+    # stress history is rounded to single precision once
+    @test t_rst ≈ t_ref
+    @test maximum(τII_ref) > 0.0
+    @test maximum(abs.(τII_rst - τII_ref)) < 1e-5*maximum(τII_ref)
+
+    rm(joinpath(dir,"restart"), force=true, recursive=true)
+    clean_test_directory(dir)
+end
+
+@testset "t36_StepRejection" begin
+    cd(test_dir)
+    dir = "t36_StepRejection";
+    ParamFile = "StepRejection.dat";
+
+    cd(dir)
+    @test run_lamem_local_test(ParamFile, 2, "", outfile="StepRejection.out", mpiexec=mpiexec)
+    out = read("StepRejection.out", String)
+    cd(test_dir)
+
+    # shear stress increment rejects steps, without collapsing to dt_min
+    nrej = length(findall("Time step rejected", out))
+    @test nrej > 0
+    @test nrej < 4
+    @test !occursin("accepted at dt_min", out)
+
+    # stress builds up & all steps are completed
+    data, t = Read_LaMEM_timestep("StepRejection", 6, dir)
+    @test maximum(data.fields.j2_dev_stress) > 0.0
+
+    clean_test_directory(dir)
+end
+
 
 end
 
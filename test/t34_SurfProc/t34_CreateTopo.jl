@@ -0,0 +1,27 @@
+# Creates initial topography file for surface process test (tilted plane)
+
+"""
+    t34_CreateTopo(dir, FileName; slope=0.01)
+
+Writes a plane dipping in x-direction (z = -slope*x, km) in LaMEM binary topography format.
+"""
+function t34_CreateTopo(dir="./", FileName="TiltedPlane.dat"; slope=0.01)
+
+    # topography grid covers the model box with one extra node on every side
+    x  = range(-55.0, 55.0, length=111)
+    y  = range(-15.0, 15.0, length=31)
+    nx = length(x)
+    ny = length(y)
+
+    # x-index runs fastest
+    Z  = [-slope*x[i] for i in 1:nx, j in 1:ny]
+
+    # header, grid dimensions, south-west corner, grid spacing, topography (PETSc binary, big-endian)
+    data = vcat(0.0, Float64(nx), Float64(ny), x[1], y[1], step(x), step(y), vec(Z))
+
+    open(joinpath(dir, FileName), "w") do io
+        write(io, hton.(data))
+    end
+
+    return nothing
+end